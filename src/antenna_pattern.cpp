@@ -0,0 +1,101 @@
+#include "antenna_pattern.h"
+#include <cmath>
+#include <algorithm>
+
+AntennaPattern::AntennaPattern(double max_gain, double h_beamwidth, double v_beamwidth,
+                               double am, double sla_v) {
+    max_gain_dbi = max_gain;
+    horizontal_beamwidth = h_beamwidth;
+    vertical_beamwidth = v_beamwidth;
+    max_attenuation = am;
+    vertical_side_lobe = sla_v;
+    ue_height = 1.5;
+    azimuth_step = 1.0;
+    elevation_step = 0.5;
+    elevation_range = 45.0;
+    azimuth_points = static_cast<int>(360.0 / azimuth_step) + 1;
+    elevation_points = static_cast<int>(2.0 * elevation_range / elevation_step) + 1;
+
+    build_table();
+}
+
+void AntennaPattern::build_table() {
+    gain_table.resize(static_cast<size_t>(azimuth_points) * elevation_points);
+    for (int row = 0; row < elevation_points; row++) {
+        double elevation = row * elevation_step - elevation_range;
+        for (int col = 0; col < azimuth_points; col++) {
+            double azimuth = col * azimuth_step - 180.0;
+            gain_table[static_cast<size_t>(row) * azimuth_points + col] =
+                static_cast<float>(pattern_gain(azimuth, elevation));
+        }
+    }
+}
+
+double AntennaPattern::fast_atan2_deg(double y, double x) {
+    // atan on [0, 1] by a 7th-order odd polynomial (max error ~0.012 deg),
+    // then octant fix-ups as selects rather than branches
+    const double rad_to_deg = 57.29577951308232;
+    double ax = std::fabs(x);
+    double ay = std::fabs(y);
+    double hi = std::max(ax, ay);
+    double lo = std::min(ax, ay);
+    double a = lo / std::max(hi, 1e-30);
+    double s = a * a;
+    double r = ((-0.0464964749 * s + 0.15931422) * s - 0.327622764) * s * a + a;
+    r = (ay > ax) ? 1.5707963267948966 - r : r;
+    r = (x < 0.0) ? 3.141592653589793 - r : r;
+    r = std::copysign(r, y);
+    return r * rad_to_deg;
+}
+
+double AntennaPattern::wrap_degrees(double angle) {
+    return angle - 360.0 * std::floor((angle + 180.0) / 360.0);
+}
+
+double AntennaPattern::pattern_gain(double azimuth_offset_deg, double elevation_offset_deg) const {
+    double h_ratio = azimuth_offset_deg / horizontal_beamwidth;
+    double v_ratio = elevation_offset_deg / vertical_beamwidth;
+    double a_h = -std::min(12.0 * h_ratio * h_ratio, max_attenuation);
+    double a_v = -std::min(12.0 * v_ratio * v_ratio, vertical_side_lobe);
+    return max_gain_dbi - std::min(-(a_h + a_v), max_attenuation);
+}
+
+double AntennaPattern::lookup_gain(double azimuth_offset_deg, double elevation_offset_deg) const {
+    // The vertical attenuation saturates at SLA_v well inside the table's
+    // elevation range, so clamping the row index is exact
+    double col_pos = (azimuth_offset_deg + 180.0) / azimuth_step;
+    double row_pos = (elevation_offset_deg + elevation_range) / elevation_step;
+    col_pos = std::min(std::max(col_pos, 0.0), azimuth_points - 1.0);
+    row_pos = std::min(std::max(row_pos, 0.0), elevation_points - 1.0);
+    int col = std::min(static_cast<int>(col_pos), azimuth_points - 2);
+    int row = std::min(static_cast<int>(row_pos), elevation_points - 2);
+    double fc = col_pos - col;
+    double fr = row_pos - row;
+
+    const float* top = &gain_table[static_cast<size_t>(row) * azimuth_points + col];
+    const float* bottom = top + azimuth_points;
+    double upper = top[0] + fc * (top[1] - top[0]);
+    double lower = bottom[0] + fc * (bottom[1] - bottom[0]);
+    return upper + fr * (lower - upper);
+}
+
+double AntennaPattern::gain_towards(double dx, double dy, double antenna_height,
+                                    double azimuth_deg, double downtilt_deg) const {
+    // Azimuth is a bearing (clockwise from north, +y); dx/dy point from the
+    // antenna to the UE
+    double bearing = 90.0 - fast_atan2_deg(dy, dx);
+    double azimuth_offset = wrap_degrees(bearing - azimuth_deg);
+
+    double horizontal_distance = std::sqrt(dx * dx + dy * dy);
+    double elevation = fast_atan2_deg(antenna_height - ue_height, std::max(horizontal_distance, 1.0));
+
+    return lookup_gain(azimuth_offset, elevation - downtilt_deg);
+}
+
+void AntennaPattern::set_ue_height(double height) {
+    ue_height = height;
+}
+
+double AntennaPattern::get_max_gain() const {
+    return max_gain_dbi;
+}
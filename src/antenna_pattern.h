@@ -0,0 +1,50 @@
+#ifndef ANTENNA_PATTERN_H
+#define ANTENNA_PATTERN_H
+
+#include <vector>
+
+// 3GPP TR 36.814 sector antenna: A_H(phi) = -min(12 (phi/phi_3dB)^2, A_m),
+// A_V(theta) = -min(12 ((theta - tilt)/theta_3dB)^2, SLA_v) and
+// A = -min(-(A_H + A_V), A_m). The combined gain is precomputed on an
+// (azimuth offset x elevation offset) grid and read back with bilinear
+// interpolation; angles come from a polynomial atan2 approximation.
+class AntennaPattern {
+private:
+    double max_gain_dbi;
+    double horizontal_beamwidth;    // degrees (3 dB)
+    double vertical_beamwidth;      // degrees (3 dB)
+    double max_attenuation;         // A_m, front-to-back ratio (dB)
+    double vertical_side_lobe;      // SLA_v (dB)
+    double ue_height;               // m
+
+    // Gain table, row-major [elevation offset][azimuth offset]
+    std::vector<float> gain_table;
+    double azimuth_step;            // degrees, covering -180..180
+    double elevation_step;          // degrees, covering +/-elevation_range
+    double elevation_range;
+    int azimuth_points;
+    int elevation_points;
+
+    void build_table();
+
+public:
+    AntennaPattern(double max_gain_dbi = 15.0, double horizontal_beamwidth = 70.0,
+                   double vertical_beamwidth = 10.0, double max_attenuation = 25.0,
+                   double vertical_side_lobe = 20.0);
+
+    // Angle helpers
+    static double fast_atan2_deg(double y, double x);
+    static double wrap_degrees(double angle);
+
+    // Gain evaluation
+    double pattern_gain(double azimuth_offset_deg, double elevation_offset_deg) const;
+    double lookup_gain(double azimuth_offset_deg, double elevation_offset_deg) const;
+    double gain_towards(double dx, double dy, double antenna_height,
+                        double azimuth_deg, double downtilt_deg) const;
+
+    // Configuration
+    void set_ue_height(double height);
+    double get_max_gain() const;
+};
+
+#endif // ANTENNA_PATTERN_H
@@ -0,0 +1,562 @@
+#include "cell_importer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace {
+
+const double earth_radius_m = 6371008.8;
+const double deg_to_rad = 3.14159265358979323846 / 180.0;
+
+enum SiteField {
+    FIELD_ID, FIELD_LATITUDE, FIELD_LONGITUDE, FIELD_AZIMUTH, FIELD_DOWNTILT,
+    FIELD_HEIGHT, FIELD_FREQUENCY, FIELD_BANDWIDTH, FIELD_TECHNOLOGY, FIELD_NONE
+};
+
+struct SiteRecord {
+    std::string id;
+    double latitude;
+    double longitude;
+    double azimuth;         // NaN where the source has no value
+    double downtilt;
+    double height;
+    double frequency_mhz;
+    double bandwidth_mhz;
+    std::string technology;
+};
+
+typedef std::pair<const char*, const char*> TextRange;
+
+SiteRecord empty_record() {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    SiteRecord record;
+    record.latitude = nan;
+    record.longitude = nan;
+    record.azimuth = nan;
+    record.downtilt = nan;
+    record.height = nan;
+    record.frequency_mhz = nan;
+    record.bandwidth_mhz = nan;
+    return record;
+}
+
+TextRange trim(const char* begin, const char* end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r' || *begin == '"')) begin++;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '"')) end--;
+    return TextRange(begin, end);
+}
+
+SiteField field_for_name(const char* begin, const char* end) {
+    static const std::pair<const char*, SiteField> aliases[] = {
+        {"id", FIELD_ID}, {"cell_id", FIELD_ID}, {"site_id", FIELD_ID}, {"cellid", FIELD_ID}, {"name", FIELD_ID},
+        {"lat", FIELD_LATITUDE}, {"latitude", FIELD_LATITUDE},
+        {"lon", FIELD_LONGITUDE}, {"lng", FIELD_LONGITUDE}, {"long", FIELD_LONGITUDE}, {"longitude", FIELD_LONGITUDE},
+        {"azimuth", FIELD_AZIMUTH}, {"azi", FIELD_AZIMUTH}, {"bearing", FIELD_AZIMUTH},
+        {"tilt", FIELD_DOWNTILT}, {"downtilt", FIELD_DOWNTILT},
+        {"height", FIELD_HEIGHT}, {"antenna_height", FIELD_HEIGHT},
+        {"frequency", FIELD_FREQUENCY}, {"frequency_mhz", FIELD_FREQUENCY}, {"freq", FIELD_FREQUENCY},
+        {"bandwidth", FIELD_BANDWIDTH}, {"bandwidth_mhz", FIELD_BANDWIDTH}, {"bw", FIELD_BANDWIDTH},
+        {"technology", FIELD_TECHNOLOGY}, {"tech", FIELD_TECHNOLOGY}, {"radio", FIELD_TECHNOLOGY}
+    };
+
+    TextRange name = trim(begin, end);
+    std::string lower(name.first, name.second);
+    for (auto& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    for (const auto& alias : aliases) {
+        if (lower == alias.first) return alias.second;
+    }
+    return FIELD_NONE;
+}
+
+bool parse_number(const char* begin, const char* end, double& value) {
+    // Fields are not NUL-terminated; numbers are short
+    TextRange text = trim(begin, end);
+    size_t length = text.second - text.first;
+    if (length == 0 || length >= 64) return false;
+    char buffer[64];
+    std::memcpy(buffer, text.first, length);
+    buffer[length] = '\0';
+    char* parsed_end;
+    value = std::strtod(buffer, &parsed_end);
+    return parsed_end != buffer;
+}
+
+void set_field(SiteRecord& record, SiteField field, const char* begin, const char* end) {
+    TextRange text = trim(begin, end);
+    switch (field) {
+        case FIELD_ID: record.id.assign(text.first, text.second); break;
+        case FIELD_TECHNOLOGY: record.technology.assign(text.first, text.second); break;
+        case FIELD_LATITUDE: parse_number(begin, end, record.latitude); break;
+        case FIELD_LONGITUDE: parse_number(begin, end, record.longitude); break;
+        case FIELD_AZIMUTH: parse_number(begin, end, record.azimuth); break;
+        case FIELD_DOWNTILT: parse_number(begin, end, record.downtilt); break;
+        case FIELD_HEIGHT: parse_number(begin, end, record.height); break;
+        case FIELD_FREQUENCY: parse_number(begin, end, record.frequency_mhz); break;
+        case FIELD_BANDWIDTH: parse_number(begin, end, record.bandwidth_mhz); break;
+        default: break;
+    }
+}
+
+int resolve_threads(int requested, size_t work_items) {
+    int threads = requested > 0 ? requested : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(threads, 1);
+    return static_cast<int>(std::min<size_t>(threads, std::max<size_t>(work_items, 1)));
+}
+
+// Runs body(worker, begin, end) over [0, count) split into contiguous blocks
+template<typename Body>
+void parallel_blocks(size_t count, int threads, Body body) {
+    if (threads <= 1) {
+        body(0, 0, count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        size_t begin = count * t / threads;
+        size_t end = count * (t + 1) / threads;
+        workers.emplace_back([&body, t, begin, end]() { body(t, begin, end); });
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+bool read_file(const std::string& path, std::string& text) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) return false;
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (size < 0) return false;
+    text.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    file.read(&text[0], size);
+    return static_cast<bool>(file) || file.eof();
+}
+
+// CSV
+
+void split_fields(const char* begin, const char* end, char delimiter, std::vector<TextRange>& fields) {
+    fields.clear();
+    const char* p = begin;
+    while (p <= end) {
+        const char* field_begin = p;
+        if (p < end && *p == '"') {
+            // Quoted: delimiters inside quotes do not split, "" is a quote
+            p++;
+            while (p < end && !(*p == '"' && (p + 1 == end || p[1] != '"'))) {
+                p += (*p == '"') ? 2 : 1;
+            }
+            if (p < end) p++;
+        }
+        while (p < end && *p != delimiter) p++;
+        fields.push_back(TextRange(field_begin, p));
+        p++;
+    }
+}
+
+void parse_csv_rows(const char* begin, const char* end, char delimiter, const std::vector<SiteField>& columns,
+                    std::vector<SiteRecord>& records) {
+    std::vector<TextRange> fields;
+    const char* line = begin;
+    while (line < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!line_end) line_end = end;
+        TextRange content = trim(line, line_end);
+        if (content.first < content.second) {
+            split_fields(line, line_end, delimiter, fields);
+            SiteRecord record = empty_record();
+            for (size_t c = 0; c < fields.size() && c < columns.size(); c++) {
+                if (columns[c] != FIELD_NONE) set_field(record, columns[c], fields[c].first, fields[c].second);
+            }
+            records.push_back(record);
+        }
+        line = line_end + 1;
+    }
+}
+
+// GeoJSON
+
+void skip_whitespace(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+}
+
+bool read_string(const char*& p, const char* end, TextRange& out) {
+    if (p >= end || *p != '"') return false;
+    const char* begin = ++p;
+    while (p < end && *p != '"') p += (*p == '\\') ? 2 : 1;
+    if (p >= end) return false;
+    out = TextRange(begin, p);
+    p++;
+    return true;
+}
+
+bool skip_value(const char*& p, const char* end) {
+    skip_whitespace(p, end);
+    if (p >= end) return false;
+    if (*p == '"') {
+        TextRange ignored;
+        return read_string(p, end, ignored);
+    }
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                TextRange ignored;
+                if (!read_string(p, end, ignored)) return false;
+                continue;
+            }
+            if (c == '{' || c == '[') depth++;
+            if (c == '}' || c == ']') depth--;
+            p++;
+            if (depth == 0) return true;
+        }
+        return false;
+    }
+    while (p < end && *p != ',' && *p != '}' && *p != ']') p++;
+    return true;
+}
+
+// Calls visit(key, value_begin, value_end) for each member, value unparsed
+template<typename Visit>
+bool for_each_member(const char*& p, const char* end, Visit visit) {
+    skip_whitespace(p, end);
+    if (p >= end || *p != '{') return false;
+    p++;
+    for (;;) {
+        skip_whitespace(p, end);
+        if (p < end && *p == '}') {
+            p++;
+            return true;
+        }
+        TextRange key;
+        if (!read_string(p, end, key)) return false;
+        skip_whitespace(p, end);
+        if (p >= end || *p != ':') return false;
+        p++;
+        skip_whitespace(p, end);
+        const char* value_begin = p;
+        if (!skip_value(p, end)) return false;
+        visit(key, value_begin, p);
+        skip_whitespace(p, end);
+        if (p < end && *p == ',') p++;
+    }
+}
+
+bool parse_feature(const char* begin, const char* end, SiteRecord& record) {
+    const char* p = begin;
+    return for_each_member(p, end, [&record](const TextRange& key, const char* value_begin, const char* value_end) {
+        std::string name(key.first, key.second);
+        const char* v = value_begin;
+        if (name == "geometry") {
+            bool point = false;
+            double coordinates[2] = {0.0, 0.0};
+            int found = 0;
+            for_each_member(v, value_end, [&](const TextRange& member, const char* b, const char* e) {
+                std::string member_name(member.first, member.second);
+                if (member_name == "type") {
+                    point = std::string(b, e).find("\"Point\"") != std::string::npos;
+                } else if (member_name == "coordinates" && *b == '[') {
+                    // [lon, lat, (alt)]
+                    const char* q = b + 1;
+                    while (found < 2 && q < e) {
+                        const char* number_end = q;
+                        while (number_end < e && *number_end != ',' && *number_end != ']') number_end++;
+                        if (!parse_number(q, number_end, coordinates[found])) break;
+                        found++;
+                        q = number_end + 1;
+                    }
+                }
+            });
+            if (point && found == 2) {
+                record.longitude = coordinates[0];
+                record.latitude = coordinates[1];
+            }
+        } else if (name == "properties") {
+            for_each_member(v, value_end, [&record](const TextRange& member, const char* b, const char* e) {
+                SiteField field = field_for_name(member.first, member.second);
+                if (field == FIELD_LATITUDE || field == FIELD_LONGITUDE || field == FIELD_NONE) return;
+                if (*b == '{' || *b == '[') return;
+                set_field(record, field, b, e);
+            });
+        } else if (name == "id" && record.id.empty()) {
+            set_field(record, FIELD_ID, value_begin, value_end);
+        }
+    });
+}
+
+bool find_features(const std::string& text, std::vector<TextRange>& features) {
+    size_t key = text.find("\"features\"");
+    if (key == std::string::npos) return false;
+    const char* p = text.data() + key + 10;
+    const char* end = text.data() + text.size();
+    skip_whitespace(p, end);
+    if (p >= end || *p != ':') return false;
+    p++;
+    skip_whitespace(p, end);
+    if (p >= end || *p != '[') return false;
+    p++;
+
+    // One serial scan for element boundaries; features parse in parallel
+    for (;;) {
+        skip_whitespace(p, end);
+        if (p >= end) return false;
+        if (*p == ']') return true;
+        const char* begin = p;
+        if (!skip_value(p, end)) return false;
+        features.push_back(TextRange(begin, p));
+        skip_whitespace(p, end);
+        if (p < end && *p == ',') p++;
+    }
+}
+
+void build_result(const CellImportConfig& config, std::vector<SiteRecord>& records, CellImportResult& result) {
+    result.rows_read = records.size();
+
+    // Origin and usable rows
+    double latitude_sum = 0.0, longitude_sum = 0.0;
+    std::vector<size_t> usable;
+    usable.reserve(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        const SiteRecord& record = records[i];
+        if (std::isnan(record.latitude) || std::isnan(record.longitude) ||
+            std::fabs(record.latitude) > 90.0 || std::fabs(record.longitude) > 180.0) {
+            continue;
+        }
+        latitude_sum += record.latitude;
+        longitude_sum += record.longitude;
+        usable.push_back(i);
+    }
+    result.rows_skipped = records.size() - usable.size();
+    result.origin_latitude = config.origin_latitude;
+    result.origin_longitude = config.origin_longitude;
+    if (config.auto_origin && !usable.empty()) {
+        result.origin_latitude = latitude_sum / usable.size();
+        result.origin_longitude = longitude_sum / usable.size();
+    }
+
+    // Carriers: distinct frequency/bandwidth pairs, lowest frequency first
+    std::vector<std::pair<double, double>> pairs;
+    for (size_t i : usable) {
+        SiteRecord& record = records[i];
+        if (std::isnan(record.frequency_mhz)) record.frequency_mhz = config.default_frequency_mhz;
+        if (std::isnan(record.bandwidth_mhz)) record.bandwidth_mhz = config.default_bandwidth_mhz;
+        pairs.push_back(std::make_pair(record.frequency_mhz, record.bandwidth_mhz));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    result.carriers.clear();
+    for (size_t c = 0; c < pairs.size(); c++) {
+        ComponentCarrier carrier;
+        carrier.carrier_id = static_cast<int>(c);
+        carrier.frequency_mhz = pairs[c].first;
+        carrier.bandwidth_mhz = pairs[c].second;
+        carrier.num_rbs = LTENetwork::rbs_for_bandwidth(pairs[c].second);
+        carrier.numerology = 0;
+        result.carriers.push_back(carrier);
+    }
+
+    // Projection and CellInfo construction, in parallel over the rows
+    size_t count = usable.size();
+    result.cells.resize(count);
+    result.source_ids.resize(count);
+    result.cell_carrier.resize(count);
+    int threads = resolve_threads(config.num_threads, count / 4096 + 1);
+    parallel_blocks(count, threads, [&](int, size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            SiteRecord& record = records[usable[k]];
+            CellInfo& cell = result.cells[k];
+            double x, y;
+            CellSiteImporter::project(record.latitude, record.longitude,
+                                      result.origin_latitude, result.origin_longitude, x, y);
+            cell.cell_id = static_cast<int>(k);
+            cell.signal_strength = -70.0;
+            cell.signal_quality = -10.0;
+            cell.interference_level = 0.05;
+            cell.load_percentage = 0;
+            cell.technology = record.technology.empty() ? "LTE" : record.technology;
+            cell.latitude = y;
+            cell.longitude = x;
+            cell.sectorized = !std::isnan(record.azimuth);
+            cell.azimuth = cell.sectorized ? record.azimuth : 0.0;
+            cell.downtilt = std::isnan(record.downtilt) ? config.default_downtilt : record.downtilt;
+            cell.antenna_height = std::isnan(record.height) ? config.default_antenna_height : record.height;
+            result.source_ids[k].swap(record.id);
+            result.cell_carrier[k] = static_cast<int>(
+                std::lower_bound(pairs.begin(), pairs.end(),
+                                 std::make_pair(record.frequency_mhz, record.bandwidth_mhz)) - pairs.begin());
+        }
+    });
+
+    result.index.build(result.cells, config.index_bucket_size);
+    result.ok = true;
+}
+
+CellImportResult empty_result() {
+    CellImportResult result;
+    result.ok = false;
+    result.origin_latitude = 0.0;
+    result.origin_longitude = 0.0;
+    result.rows_read = 0;
+    result.rows_skipped = 0;
+    result.elapsed_ms = 0.0;
+    return result;
+}
+
+} // namespace
+
+CellSiteImporter::CellSiteImporter() {
+    config = default_config();
+}
+
+CellSiteImporter::CellSiteImporter(const CellImportConfig& config) {
+    this->config = config;
+}
+
+CellImportConfig CellSiteImporter::default_config() {
+    CellImportConfig config;
+    config.auto_origin = true;
+    config.origin_latitude = 0.0;
+    config.origin_longitude = 0.0;
+    config.num_threads = 0;
+    config.default_downtilt = 6.0;
+    config.default_antenna_height = 30.0;
+    config.default_frequency_mhz = 2100.0;
+    config.default_bandwidth_mhz = 20.0;
+    config.index_bucket_size = 0.0;
+    return config;
+}
+
+void CellSiteImporter::project(double latitude, double longitude, double origin_latitude, double origin_longitude,
+                               double& x, double& y) {
+    // Distances and bearings from the origin are exact on the sphere
+    double phi = latitude * deg_to_rad;
+    double phi0 = origin_latitude * deg_to_rad;
+    double dlambda = (longitude - origin_longitude) * deg_to_rad;
+    double cos_c = std::sin(phi0) * std::sin(phi) + std::cos(phi0) * std::cos(phi) * std::cos(dlambda);
+    double c = std::acos(std::min(std::max(cos_c, -1.0), 1.0));
+    double k = c < 1e-12 ? 1.0 : c / std::sin(c);
+    x = earth_radius_m * k * std::cos(phi) * std::sin(dlambda);
+    y = earth_radius_m * k * (std::cos(phi0) * std::sin(phi) - std::sin(phi0) * std::cos(phi) * std::cos(dlambda));
+}
+
+CellImportResult CellSiteImporter::import_csv(const std::string& path) const {
+    std::string text;
+    if (!read_file(path, text)) {
+        CellImportResult result = empty_result();
+        result.error = "Cannot read " + path;
+        return result;
+    }
+    return parse_csv(text);
+}
+
+CellImportResult CellSiteImporter::import_geojson(const std::string& path) const {
+    std::string text;
+    if (!read_file(path, text)) {
+        CellImportResult result = empty_result();
+        result.error = "Cannot read " + path;
+        return result;
+    }
+    return parse_geojson(text);
+}
+
+CellImportResult CellSiteImporter::parse_csv(const std::string& text) const {
+    auto start = std::chrono::steady_clock::now();
+    CellImportResult result = empty_result();
+
+    // Header row names the columns and decides the delimiter
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* header_end = static_cast<const char*>(std::memchr(begin, '\n', text.size()));
+    if (!header_end) header_end = end;
+    size_t commas = std::count(begin, header_end, ',');
+    size_t semicolons = std::count(begin, header_end, ';');
+    size_t tabs = std::count(begin, header_end, '\t');
+    char delimiter = ',';
+    if (semicolons > commas && semicolons >= tabs) delimiter = ';';
+    if (tabs > commas && tabs > semicolons) delimiter = '\t';
+
+    std::vector<TextRange> names;
+    split_fields(begin, header_end, delimiter, names);
+    std::vector<SiteField> columns;
+    bool has_latitude = false, has_longitude = false;
+    for (const auto& name : names) {
+        columns.push_back(field_for_name(name.first, name.second));
+        has_latitude = has_latitude || columns.back() == FIELD_LATITUDE;
+        has_longitude = has_longitude || columns.back() == FIELD_LONGITUDE;
+    }
+    if (!has_latitude || !has_longitude) {
+        result.error = "CSV header has no latitude/longitude columns";
+        return result;
+    }
+
+    // Chunks end on line boundaries; each worker parses its own lines
+    const char* body = header_end < end ? header_end + 1 : end;
+    size_t body_size = end - body;
+    int threads = resolve_threads(config.num_threads, body_size / (1 << 20) + 1);
+    std::vector<const char*> cuts(threads + 1, end);
+    cuts[0] = body;
+    for (int t = 1; t < threads; t++) {
+        const char* cut = body + body_size * t / threads;
+        cut = std::max(cut, cuts[t - 1]);
+        const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+        cuts[t] = newline ? newline + 1 : end;
+    }
+
+    std::vector<std::vector<SiteRecord>> chunks(threads);
+    parallel_blocks(threads, threads, [&](int, size_t first, size_t last) {
+        for (size_t t = first; t < last; t++) {
+            parse_csv_rows(cuts[t], cuts[t + 1], delimiter, columns, chunks[t]);
+        }
+    });
+
+    std::vector<SiteRecord> records;
+    size_t total = 0;
+    for (const auto& chunk : chunks) total += chunk.size();
+    records.reserve(total);
+    for (auto& chunk : chunks) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(records));
+    }
+
+    build_result(config, records, result);
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+CellImportResult CellSiteImporter::parse_geojson(const std::string& text) const {
+    auto start = std::chrono::steady_clock::now();
+    CellImportResult result = empty_result();
+
+    std::vector<TextRange> features;
+    if (!find_features(text, features)) {
+        result.error = "No GeoJSON FeatureCollection";
+        return result;
+    }
+
+    std::vector<SiteRecord> records(features.size(), empty_record());
+    int threads = resolve_threads(config.num_threads, features.size() / 4096 + 1);
+    parallel_blocks(features.size(), threads, [&](int, size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            parse_feature(features[i].first, features[i].second, records[i]);
+        }
+    });
+
+    build_result(config, records, result);
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void CellSiteImporter::apply(const CellImportResult& result, LTENetwork& network) {
+    if (!result.ok) return;
+    network.set_cells(result.cells);
+    if (!result.carriers.empty()) {
+        network.configure_carriers(result.carriers);
+        network.set_cell_carriers(result.cell_carrier);
+    }
+    network.set_cell_spatial_index(std::make_shared<CellSpatialIndex>(result.index));
+}
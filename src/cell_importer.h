@@ -0,0 +1,70 @@
+#ifndef CELL_IMPORTER_H
+#define CELL_IMPORTER_H
+
+#include "lte_network.h"
+#include "cell_spatial_index.h"
+#include <vector>
+#include <string>
+
+struct CellImportConfig {
+    bool auto_origin;               // Project about the centroid of the sites
+    double origin_latitude;         // degrees, used when auto_origin is false
+    double origin_longitude;
+    int num_threads;                // 0: hardware concurrency
+    double default_downtilt;        // Used where a row has no value
+    double default_antenna_height;
+    double default_frequency_mhz;
+    double default_bandwidth_mhz;
+    double index_bucket_size;       // m, 0 picks one from the site density
+};
+
+// Sectors read from a site database, ready for LTENetwork. Cell IDs are the
+// row order (so cell_id == index); the database's own IDs are kept in
+// source_ids. Carriers are the distinct frequency/bandwidth pairs found.
+struct CellImportResult {
+    bool ok;
+    std::string error;
+    std::vector<CellInfo> cells;
+    std::vector<std::string> source_ids;
+    std::vector<int> cell_carrier;          // Index into carriers per cell
+    std::vector<ComponentCarrier> carriers;
+    CellSpatialIndex index;
+    double origin_latitude;
+    double origin_longitude;
+    size_t rows_read;
+    size_t rows_skipped;                    // No usable position
+    double elapsed_ms;
+};
+
+// Bulk importer for CSV (header row; comma, semicolon or tab separated) and
+// GeoJSON (FeatureCollection of Points) site files. Columns/properties are
+// matched by common names: id, lat/latitude, lon/lng/longitude, azimuth,
+// tilt/downtilt, height/antenna_height, frequency/frequency_mhz,
+// bandwidth/bandwidth_mhz, technology. The file is read once and parsed in
+// chunks on worker threads; CSV fields may be quoted but not span lines.
+class CellSiteImporter {
+private:
+    CellImportConfig config;
+
+public:
+    CellSiteImporter();
+    explicit CellSiteImporter(const CellImportConfig& config);
+
+    static CellImportConfig default_config();
+
+    CellImportResult import_csv(const std::string& path) const;
+    CellImportResult import_geojson(const std::string& path) const;
+    CellImportResult parse_csv(const std::string& text) const;
+    CellImportResult parse_geojson(const std::string& text) const;
+
+    // Replaces the network's cells and carriers with an import; each cell
+    // transmits only on its own carrier, and the network keeps the site
+    // index for radius-limited measurements
+    static void apply(const CellImportResult& result, LTENetwork& network);
+
+    // Azimuthal equidistant projection about the origin, metres east/north
+    static void project(double latitude, double longitude, double origin_latitude, double origin_longitude,
+                        double& x, double& y);
+};
+
+#endif // CELL_IMPORTER_H
@@ -0,0 +1,160 @@
+#include "cell_spatial_index.h"
+#include <algorithm>
+#include <cmath>
+
+CellSpatialIndex::CellSpatialIndex() {
+    min_x = 0.0;
+    min_y = 0.0;
+    bucket_size = 1.0;
+    buckets_x = 0;
+    buckets_y = 0;
+}
+
+int CellSpatialIndex::bucket_coord(double value, double origin, int count) const {
+    int coord = static_cast<int>(std::floor((value - origin) / bucket_size));
+    return std::min(std::max(coord, 0), count - 1);
+}
+
+void CellSpatialIndex::build(const std::vector<CellInfo>& cells, double new_bucket_size) {
+    size_t num_cells = cells.size();
+    cell_x.resize(num_cells);
+    cell_y.resize(num_cells);
+    bucket_start.clear();
+    bucket_cells.clear();
+    buckets_x = 0;
+    buckets_y = 0;
+    if (num_cells == 0) return;
+
+    double max_x = cells[0].longitude;
+    double max_y = cells[0].latitude;
+    min_x = max_x;
+    min_y = max_y;
+    for (size_t i = 0; i < num_cells; i++) {
+        cell_x[i] = cells[i].longitude;
+        cell_y[i] = cells[i].latitude;
+        min_x = std::min(min_x, cell_x[i]);
+        min_y = std::min(min_y, cell_y[i]);
+        max_x = std::max(max_x, cell_x[i]);
+        max_y = std::max(max_y, cell_y[i]);
+    }
+
+    // Default to about one site per bucket
+    double width = std::max(max_x - min_x, 1.0);
+    double height = std::max(max_y - min_y, 1.0);
+    if (new_bucket_size <= 0.0) {
+        new_bucket_size = std::sqrt(width * height / num_cells);
+    }
+    bucket_size = std::max(new_bucket_size, 1.0);
+    buckets_x = static_cast<int>(width / bucket_size) + 1;
+    buckets_y = static_cast<int>(height / bucket_size) + 1;
+
+    // Counting sort of the sites into CSR buckets
+    std::vector<int> cell_bucket(num_cells);
+    bucket_start.assign(static_cast<size_t>(buckets_x) * buckets_y + 1, 0);
+    for (size_t i = 0; i < num_cells; i++) {
+        int bx = bucket_coord(cell_x[i], min_x, buckets_x);
+        int by = bucket_coord(cell_y[i], min_y, buckets_y);
+        cell_bucket[i] = by * buckets_x + bx;
+        bucket_start[cell_bucket[i] + 1]++;
+    }
+    for (size_t b = 1; b < bucket_start.size(); b++) {
+        bucket_start[b] += bucket_start[b - 1];
+    }
+    bucket_cells.resize(num_cells);
+    std::vector<int> fill(bucket_start.begin(), bucket_start.end() - 1);
+    for (size_t i = 0; i < num_cells; i++) {
+        bucket_cells[fill[cell_bucket[i]]++] = static_cast<int>(i);
+    }
+}
+
+void CellSpatialIndex::query_radius(double x, double y, double radius, std::vector<int>& out) const {
+    if (buckets_x == 0) return;
+    int bx0 = bucket_coord(x - radius, min_x, buckets_x);
+    int bx1 = bucket_coord(x + radius, min_x, buckets_x);
+    int by0 = bucket_coord(y - radius, min_y, buckets_y);
+    int by1 = bucket_coord(y + radius, min_y, buckets_y);
+    double radius_sq = radius * radius;
+
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            int bucket = by * buckets_x + bx;
+            for (int k = bucket_start[bucket]; k < bucket_start[bucket + 1]; k++) {
+                int cell = bucket_cells[k];
+                double dx = cell_x[cell] - x;
+                double dy = cell_y[cell] - y;
+                if (dx * dx + dy * dy <= radius_sq) {
+                    out.push_back(cell);
+                }
+            }
+        }
+    }
+}
+
+void CellSpatialIndex::query_rect(double x0, double y0, double x1, double y1, double margin, std::vector<int>& out) const {
+    if (buckets_x == 0) return;
+    x0 -= margin;
+    y0 -= margin;
+    x1 += margin;
+    y1 += margin;
+    int bx0 = bucket_coord(x0, min_x, buckets_x);
+    int bx1 = bucket_coord(x1, min_x, buckets_x);
+    int by0 = bucket_coord(y0, min_y, buckets_y);
+    int by1 = bucket_coord(y1, min_y, buckets_y);
+
+    for (int by = by0; by <= by1; by++) {
+        for (int bx = bx0; bx <= bx1; bx++) {
+            int bucket = by * buckets_x + bx;
+            for (int k = bucket_start[bucket]; k < bucket_start[bucket + 1]; k++) {
+                int cell = bucket_cells[k];
+                if (cell_x[cell] >= x0 && cell_x[cell] <= x1 &&
+                    cell_y[cell] >= y0 && cell_y[cell] <= y1) {
+                    out.push_back(cell);
+                }
+            }
+        }
+    }
+}
+
+int CellSpatialIndex::nearest(double x, double y) const {
+    if (buckets_x == 0) return -1;
+    int cx = bucket_coord(x, min_x, buckets_x);
+    int cy = bucket_coord(y, min_y, buckets_y);
+    int best = -1;
+    double best_sq = 0.0;
+
+    // Grow square rings of buckets until the ring is farther than the best hit
+    int max_ring = std::max(buckets_x, buckets_y);
+    for (int ring = 0; ring <= max_ring; ring++) {
+        if (best >= 0) {
+            double ring_distance = (ring - 1) * bucket_size;
+            if (ring_distance > 0.0 && ring_distance * ring_distance > best_sq) break;
+        }
+        for (int by = cy - ring; by <= cy + ring; by++) {
+            if (by < 0 || by >= buckets_y) continue;
+            bool edge_row = (by == cy - ring || by == cy + ring);
+            for (int bx = cx - ring; bx <= cx + ring; bx += (edge_row ? 1 : 2 * std::max(ring, 1))) {
+                if (bx < 0 || bx >= buckets_x) continue;
+                int bucket = by * buckets_x + bx;
+                for (int k = bucket_start[bucket]; k < bucket_start[bucket + 1]; k++) {
+                    int cell = bucket_cells[k];
+                    double dx = cell_x[cell] - x;
+                    double dy = cell_y[cell] - y;
+                    double distance_sq = dx * dx + dy * dy;
+                    if (best < 0 || distance_sq < best_sq) {
+                        best = cell;
+                        best_sq = distance_sq;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+size_t CellSpatialIndex::size() const {
+    return cell_x.size();
+}
+
+double CellSpatialIndex::get_bucket_size() const {
+    return bucket_size;
+}
@@ -0,0 +1,39 @@
+#ifndef CELL_SPATIAL_INDEX_H
+#define CELL_SPATIAL_INDEX_H
+
+#include "lte_network.h"
+#include <vector>
+
+// Uniform grid over cell sites. Each bucket lists the indices (into the
+// cell vector given to build) of the sites inside it, so radius and
+// nearest-site queries only visit nearby buckets.
+class CellSpatialIndex {
+private:
+    double min_x;
+    double min_y;
+    double bucket_size;             // m
+    int buckets_x;
+    int buckets_y;
+    std::vector<int> bucket_start;  // CSR offsets, buckets_x * buckets_y + 1
+    std::vector<int> bucket_cells;
+    std::vector<double> cell_x;
+    std::vector<double> cell_y;
+
+    int bucket_coord(double value, double origin, int count) const;
+
+public:
+    CellSpatialIndex();
+
+    void build(const std::vector<CellInfo>& cells, double bucket_size = 0.0);
+
+    // Indices of cells within radius of (x, y), appended to out
+    void query_radius(double x, double y, double radius, std::vector<int>& out) const;
+    // Indices of cells overlapping the rectangle expanded by margin
+    void query_rect(double x0, double y0, double x1, double y1, double margin, std::vector<int>& out) const;
+    int nearest(double x, double y) const;
+
+    size_t size() const;
+    double get_bucket_size() const;
+};
+
+#endif // CELL_SPATIAL_INDEX_H
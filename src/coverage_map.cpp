@@ -0,0 +1,263 @@
+#include "coverage_map.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// FNV-1a over raw bytes
+uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t hash_value(uint64_t hash, const T& value) {
+    return hash_bytes(hash, &value, sizeof(value));
+}
+
+}
+
+CoverageMapGenerator::CoverageMapGenerator(size_t cache_capacity) {
+    this->cache_capacity = cache_capacity;
+    cache_hits = 0;
+    cache_misses = 0;
+}
+
+CoverageMapConfig CoverageMapGenerator::default_config() {
+    // Covers the default 3x3 layout from initialize_network
+    CoverageMapConfig config;
+    config.x_min = -500.0;
+    config.y_min = -500.0;
+    config.x_max = 2500.0;
+    config.y_max = 2500.0;
+    config.width = 1024;
+    config.height = 1024;
+    config.tile_size = 64;
+    config.num_threads = 0;
+    config.frequency_mhz = 2000.0;
+    config.interference_radius = 0.0;
+    return config;
+}
+
+uint64_t CoverageMapGenerator::network_signature(const LTENetwork& network) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& cell : network.get_cells()) {
+        hash = hash_value(hash, cell.cell_id);
+        hash = hash_value(hash, cell.longitude);
+        hash = hash_value(hash, cell.latitude);
+        hash = hash_value(hash, cell.sectorized);
+        hash = hash_value(hash, cell.azimuth);
+        hash = hash_value(hash, cell.downtilt);
+        hash = hash_value(hash, cell.antenna_height);
+    }
+    for (double activity : network.get_cell_activity_factors()) {
+        hash = hash_value(hash, activity);
+    }
+    return hash;
+}
+
+std::shared_ptr<const CoverageTile> CoverageMapGenerator::find_tile(uint64_t key) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = tile_cache.find(key);
+    if (it == tile_cache.end()) {
+        cache_misses++;
+        return nullptr;
+    }
+    cache_hits++;
+    return it->second;
+}
+
+void CoverageMapGenerator::store_tile(uint64_t key, const std::shared_ptr<const CoverageTile>& tile) {
+    if (cache_capacity == 0) return;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (!tile_cache.emplace(key, tile).second) return;
+    cache_order.push_back(key);
+    while (tile_cache.size() > cache_capacity) {
+        tile_cache.erase(cache_order.front());
+        cache_order.pop_front();
+    }
+}
+
+std::shared_ptr<const CoverageTile> CoverageMapGenerator::compute_tile(const LTENetwork& network,
+                                                                       const std::vector<CellInfo>& cells,
+                                                                       const std::vector<double>& activity,
+                                                                       const CellSpatialIndex& index,
+                                                                       const CoverageMapConfig& config,
+                                                                       int tile_x, int tile_y) const {
+    int px0 = tile_x * config.tile_size;
+    int py0 = tile_y * config.tile_size;
+    int tile_w = std::min(config.tile_size, config.width - px0);
+    int tile_h = std::min(config.tile_size, config.height - py0);
+    size_t count = static_cast<size_t>(tile_w) * tile_h;
+
+    double pixel_w = (config.x_max - config.x_min) / config.width;
+    double pixel_h = (config.y_max - config.y_min) / config.height;
+    std::vector<double> xs(count), ys(count);
+    for (int row = 0; row < tile_h; row++) {
+        for (int col = 0; col < tile_w; col++) {
+            xs[row * tile_w + col] = config.x_min + (px0 + col + 0.5) * pixel_w;
+            ys[row * tile_w + col] = config.y_min + (py0 + row + 0.5) * pixel_h;
+        }
+    }
+
+    // Interferers: every cell, or the cells within range of the tile
+    std::vector<int> candidates;
+    if (config.interference_radius > 0.0) {
+        index.query_rect(xs[0], ys[0], xs[count - 1], ys[count - 1], config.interference_radius, candidates);
+        if (candidates.empty() && !cells.empty()) {
+            candidates.push_back(index.nearest(xs[0], ys[0]));
+        }
+    } else {
+        for (size_t c = 0; c < cells.size(); c++) {
+            candidates.push_back(static_cast<int>(c));
+        }
+    }
+
+    std::vector<double> rsrp(count);
+    std::vector<double> best_rsrp(count, -200.0);
+    std::vector<double> total_power(count, 0.0);
+    std::vector<int32_t> best_cell(count, -1);
+    const double db_to_ln = std::log(10.0) / 10.0;
+
+    // Interference is weighted by cell activity, so the serving cell's own
+    // power is tracked separately from the weighted total
+    std::vector<double> best_weight(count, 0.0);
+    for (int c : candidates) {
+        const CellInfo& cell = cells[c];
+        double weight = activity[c];
+        network.calculate_rsrp_batch(xs.data(), ys.data(), count, cell, config.frequency_mhz, rsrp.data());
+        for (size_t i = 0; i < count; i++) {
+            total_power[i] += weight * std::exp(rsrp[i] * db_to_ln);
+            bool better = rsrp[i] > best_rsrp[i];
+            best_rsrp[i] = better ? rsrp[i] : best_rsrp[i];
+            best_cell[i] = better ? cell.cell_id : best_cell[i];
+            best_weight[i] = better ? weight : best_weight[i];
+        }
+    }
+
+    // Thermal noise as in calculate_sinr_at
+    const double noise_power = std::pow(10.0, -104.0 / 10.0);
+    auto tile = std::make_shared<CoverageTile>();
+    tile->rsrp_dbm.resize(count);
+    tile->sinr_db.resize(count);
+    tile->best_server.assign(best_cell.begin(), best_cell.end());
+    for (size_t i = 0; i < count; i++) {
+        double signal = (best_cell[i] >= 0) ? best_weight[i] * std::exp(best_rsrp[i] * db_to_ln) : 0.0;
+        double interference = std::max(total_power[i] - signal, 0.0) + noise_power;
+        tile->rsrp_dbm[i] = static_cast<float>(best_rsrp[i]);
+        tile->sinr_db[i] = static_cast<float>(best_rsrp[i] - 10.0 * std::log10(interference));
+    }
+    return tile;
+}
+
+std::shared_ptr<const CoverageMap> CoverageMapGenerator::generate(const LTENetwork& network,
+                                                                  const CoverageMapConfig& requested) {
+    CoverageMapConfig config = requested;
+    config.width = std::max(config.width, 1);
+    config.height = std::max(config.height, 1);
+    config.tile_size = std::max(config.tile_size, 1);
+
+    std::vector<CellInfo> cells = network.get_cells();
+    std::vector<double> activity = network.get_cell_activity_factors();
+    CellSpatialIndex index;
+    index.build(cells);
+
+    auto map = std::make_shared<CoverageMap>();
+    map->width = config.width;
+    map->height = config.height;
+    map->network_signature = network_signature(network);
+    map->rsrp_dbm.resize(static_cast<size_t>(config.width) * config.height);
+    map->sinr_db.resize(map->rsrp_dbm.size());
+    map->best_server.resize(map->rsrp_dbm.size());
+
+    // Every tile key shares the network and raster geometry; threads do not
+    // change the result so they stay out of the key
+    uint64_t base_key = map->network_signature;
+    base_key = hash_value(base_key, config.x_min);
+    base_key = hash_value(base_key, config.y_min);
+    base_key = hash_value(base_key, config.x_max);
+    base_key = hash_value(base_key, config.y_max);
+    base_key = hash_value(base_key, config.width);
+    base_key = hash_value(base_key, config.height);
+    base_key = hash_value(base_key, config.tile_size);
+    base_key = hash_value(base_key, config.frequency_mhz);
+    base_key = hash_value(base_key, config.interference_radius);
+
+    int tiles_x = (config.width + config.tile_size - 1) / config.tile_size;
+    int tiles_y = (config.height + config.tile_size - 1) / config.tile_size;
+    int num_tiles = tiles_x * tiles_y;
+    std::atomic<int> next_tile(0);
+    std::atomic<int> computed(0);
+
+    auto worker = [&]() {
+        for (int t = next_tile.fetch_add(1); t < num_tiles; t = next_tile.fetch_add(1)) {
+            int tile_x = t % tiles_x;
+            int tile_y = t / tiles_x;
+            uint64_t key = hash_value(hash_value(base_key, tile_x), tile_y);
+
+            std::shared_ptr<const CoverageTile> tile = find_tile(key);
+            if (!tile) {
+                tile = compute_tile(network, cells, activity, index, config, tile_x, tile_y);
+                store_tile(key, tile);
+                computed++;
+            }
+
+            // Tiles cover disjoint pixels, so the copy needs no lock
+            int px0 = tile_x * config.tile_size;
+            int py0 = tile_y * config.tile_size;
+            int tile_w = std::min(config.tile_size, config.width - px0);
+            int tile_h = std::min(config.tile_size, config.height - py0);
+            for (int row = 0; row < tile_h; row++) {
+                size_t dst = static_cast<size_t>(py0 + row) * config.width + px0;
+                size_t src = static_cast<size_t>(row) * tile_w;
+                std::memcpy(&map->rsrp_dbm[dst], &tile->rsrp_dbm[src], tile_w * sizeof(float));
+                std::memcpy(&map->sinr_db[dst], &tile->sinr_db[src], tile_w * sizeof(float));
+                std::memcpy(&map->best_server[dst], &tile->best_server[src], tile_w * sizeof(int32_t));
+            }
+        }
+    };
+
+    int num_threads = config.num_threads;
+    if (num_threads <= 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::min(num_threads, num_tiles);
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    map->tiles_computed = computed.load();
+    map->tiles_cached = num_tiles - map->tiles_computed;
+    return map;
+}
+
+void CoverageMapGenerator::clear_cache() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    tile_cache.clear();
+    cache_order.clear();
+}
+
+std::map<std::string, double> CoverageMapGenerator::get_cache_statistics() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::map<std::string, double> stats;
+    stats["cached_tiles"] = tile_cache.size();
+    stats["cache_capacity"] = cache_capacity;
+    stats["cache_hits"] = cache_hits;
+    stats["cache_misses"] = cache_misses;
+    stats["hit_rate"] = (cache_hits + cache_misses) > 0 ?
+        static_cast<double>(cache_hits) / (cache_hits + cache_misses) : 0.0;
+    return stats;
+}
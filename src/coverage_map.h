@@ -0,0 +1,78 @@
+#ifndef COVERAGE_MAP_H
+#define COVERAGE_MAP_H
+
+#include "lte_network.h"
+#include "cell_spatial_index.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+struct CoverageMapConfig {
+    double x_min;               // m, pixel centres span [x_min, x_max)
+    double y_min;
+    double x_max;
+    double y_max;
+    int width;                  // pixels
+    int height;
+    int tile_size;              // pixels per tile side
+    int num_threads;            // 0 uses every hardware thread
+    double frequency_mhz;
+    double interference_radius; // m, 0 counts every cell as an interferer
+};
+
+// Row-major rasters, row 0 at y_min
+struct CoverageMap {
+    int width;
+    int height;
+    std::vector<float> rsrp_dbm;        // Best-server RSRP
+    std::vector<float> sinr_db;         // Downlink SINR towards the best server
+    std::vector<int32_t> best_server;   // Cell ID, -1 without cells
+    uint64_t network_signature;
+    int tiles_computed;
+    int tiles_cached;
+};
+
+struct CoverageTile {
+    std::vector<float> rsrp_dbm;
+    std::vector<float> sinr_db;
+    std::vector<int32_t> best_server;
+};
+
+// Evaluates best-server, RSRP and SINR rasters in square tiles spread over
+// worker threads. Tiles are cached under a key built from the cell layout
+// and the raster geometry, so panning or re-rendering an unchanged network
+// only computes the tiles it has not seen. Interference is weighted by the
+// cells' activity factors, which are part of the key.
+class CoverageMapGenerator {
+private:
+    size_t cache_capacity;              // tiles
+    std::unordered_map<uint64_t, std::shared_ptr<const CoverageTile>> tile_cache;
+    std::deque<uint64_t> cache_order;   // Insertion order for eviction
+    std::mutex cache_mutex;
+    long long cache_hits;
+    long long cache_misses;
+
+    std::shared_ptr<const CoverageTile> find_tile(uint64_t key);
+    void store_tile(uint64_t key, const std::shared_ptr<const CoverageTile>& tile);
+    std::shared_ptr<const CoverageTile> compute_tile(const LTENetwork& network, const std::vector<CellInfo>& cells,
+                                                     const std::vector<double>& activity, const CellSpatialIndex& index,
+                                                     const CoverageMapConfig& config, int tile_x, int tile_y) const;
+
+public:
+    CoverageMapGenerator(size_t cache_capacity = 4096);
+
+    static CoverageMapConfig default_config();
+    static uint64_t network_signature(const LTENetwork& network);
+
+    std::shared_ptr<const CoverageMap> generate(const LTENetwork& network, const CoverageMapConfig& config);
+
+    void clear_cache();
+    std::map<std::string, double> get_cache_statistics();
+};
+
+#endif // COVERAGE_MAP_H
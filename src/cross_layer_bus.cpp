@@ -0,0 +1,107 @@
+#include "cross_layer_bus.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+CrossLayerRecord CrossLayerRecord::from_message(const CrossLayerMessage& message) {
+    CrossLayerRecord record;
+    record.source = message.source;
+    record.destination = message.destination;
+    record.event = message.event;
+    record.timestamp = message.timestamp;
+    record.posted_ns = 0;
+    record.parameters = message.parameters;
+    size_t length = std::min(message.message.size(), sizeof(record.message) - 1);
+    std::memcpy(record.message, message.message.data(), length);
+    record.message[length] = '\0';
+    return record;
+}
+
+void CrossLayerRecord::to_message(CrossLayerMessage& message) const {
+    message.source = source;
+    message.destination = destination;
+    message.event = event;
+    message.timestamp = timestamp;
+    message.parameters = parameters;
+    message.message.assign(this->message);
+}
+
+CrossLayerMessageBus::CrossLayerMessageBus(size_t capacity) {
+    this->capacity = 2;
+    while (this->capacity < capacity) this->capacity <<= 1;
+    mask = this->capacity - 1;
+    slots.reset(new Slot[this->capacity]);
+    for (size_t i = 0; i < this->capacity; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_position.store(0, std::memory_order_relaxed);
+    dequeue_position = 0;
+    published.store(0, std::memory_order_relaxed);
+    rejected.store(0, std::memory_order_relaxed);
+    drained = 0;
+}
+
+bool CrossLayerMessageBus::publish(const CrossLayerRecord& record) {
+    uint64_t position = enqueue_position.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[position & mask];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        int64_t lag = static_cast<int64_t>(sequence - position);
+        if (lag == 0) {
+            // Slot is free for this lap; claim it
+            if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                published.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        } else if (lag < 0) {
+            // The consumer has not freed this slot from the previous lap
+            rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool CrossLayerMessageBus::publish(const CrossLayerMessage& message) {
+    CrossLayerRecord record = CrossLayerRecord::from_message(message);
+    record.posted_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return publish(record);
+}
+
+size_t CrossLayerMessageBus::drain(CrossLayerRecord* out, size_t max_records) {
+    size_t count = 0;
+    while (count < max_records) {
+        Slot& slot = slots[dequeue_position & mask];
+        // A claimed slot whose producer has not finished stops the batch;
+        // records behind it are taken on the next drain
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1) break;
+        out[count++] = slot.record;
+        slot.sequence.store(dequeue_position + capacity, std::memory_order_release);
+        dequeue_position++;
+    }
+    drained += count;
+    return count;
+}
+
+size_t CrossLayerMessageBus::get_capacity() const {
+    return capacity;
+}
+
+size_t CrossLayerMessageBus::size_approx() const {
+    uint64_t enqueued = enqueue_position.load(std::memory_order_relaxed);
+    return enqueued > dequeue_position ? static_cast<size_t>(enqueued - dequeue_position) : 0;
+}
+
+std::map<std::string, double> CrossLayerMessageBus::get_statistics() const {
+    std::map<std::string, double> stats;
+    stats["capacity"] = capacity;
+    stats["published"] = published.load(std::memory_order_relaxed);
+    stats["rejected"] = rejected.load(std::memory_order_relaxed);
+    stats["drained"] = drained;
+    stats["pending"] = size_approx();
+    return stats;
+}
@@ -0,0 +1,66 @@
+#ifndef CROSS_LAYER_BUS_H
+#define CROSS_LAYER_BUS_H
+
+#include "cross_layer_protocol.h"
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+// CrossLayerMessage flattened to a trivially copyable record so it can sit
+// in a preallocated ring; the text is truncated to fit
+struct CrossLayerRecord {
+    LayerType source;
+    LayerType destination;
+    CrossLayerEvent event;
+    uint64_t timestamp;
+    uint64_t posted_ns;             // Steady clock at publish, for latency
+    MetricSet parameters;
+    char message[64];
+
+    static CrossLayerRecord from_message(const CrossLayerMessage& message);
+    void to_message(CrossLayerMessage& message) const;
+};
+
+// Bounded multi-producer/single-consumer ring (per-slot sequence numbers,
+// after Vyukov). Producers claim a slot with one CAS and never wait: a full
+// ring rejects the record. Only the owning thread may drain.
+class CrossLayerMessageBus {
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        CrossLayerRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity;                            // Power of two
+    size_t mask;
+
+    // Producer and consumer positions on separate cache lines
+    char pad0[64];
+    std::atomic<uint64_t> enqueue_position;
+    std::atomic<uint64_t> published;
+    std::atomic<uint64_t> rejected;
+    char pad1[64];
+    uint64_t dequeue_position;                  // Consumer only
+    uint64_t drained;
+
+    CrossLayerMessageBus(const CrossLayerMessageBus&);
+    CrossLayerMessageBus& operator=(const CrossLayerMessageBus&);
+
+public:
+    explicit CrossLayerMessageBus(size_t capacity = 1024);
+
+    // Any thread; false if the ring is full
+    bool publish(const CrossLayerRecord& record);
+    bool publish(const CrossLayerMessage& message);
+
+    // Consumer thread; copies up to max_records oldest records into out
+    size_t drain(CrossLayerRecord* out, size_t max_records);
+
+    size_t get_capacity() const;
+    // Consumer thread
+    size_t size_approx() const;
+    std::map<std::string, double> get_statistics() const;
+};
+
+#endif // CROSS_LAYER_BUS_H
@@ -7,10 +7,19 @@
 #include <map>
 #include <functional>
 #include <chrono>
+#include <random>
+#include "metric_registry.h"
+#include "hdr_histogram.h"
 
 // Forward declarations
 class TCPTahoe;
 class LTENetwork;
+class CrossLayerMessageBus;
+struct CrossLayerRecord;
+class TransportFlowTable;
+struct TransportFlowConfig;
+class PolicyEngine;
+struct LTEStateArrays;
 
 enum class LayerType {
     PHYSICAL,
@@ -32,7 +41,7 @@ enum class CrossLayerEvent {
 struct LayerInfo {
     LayerType layer;
     std::string status;
-    std::map<std::string, double> metrics;
+    MetricSet metrics;
     uint64_t timestamp;
 };
 
@@ -40,16 +49,146 @@ struct CrossLayerMessage {
     LayerType source;
     LayerType destination;
     CrossLayerEvent event;
-    std::map<std::string, double> parameters;
+    MetricSet parameters;
     uint64_t timestamp;
     std::string message;
 };
 
+// Typed views of the parameters each event carries
+struct SignalStrengthPayload {
+    double signal_strength;         // dBm
+    double mobility_speed;          // km/h
+};
+
+struct HandoverPayload {
+    double trigger_rsrp;            // dBm; the target is in the message text
+};
+
+struct CongestionPayload {
+    double congestion_level;
+};
+
+struct ErrorRatePayload {
+    double error_rate;
+    double correction_strength;
+};
+
+struct BandwidthPayload {
+    double power_save_mode;
+    double reduce_transmission_power;
+};
+
+struct LatencyPayload {
+    double latency;                 // ms
+};
+
+// Built once per dispatched message and shared by every subscriber;
+// the member matching event is the valid one
+struct CrossLayerPayload {
+    CrossLayerEvent event;
+    union {
+        SignalStrengthPayload signal;
+        HandoverPayload handover;
+        CongestionPayload congestion;
+        ErrorRatePayload error;
+        BandwidthPayload bandwidth;
+        LatencyPayload latency;
+    };
+
+    static CrossLayerPayload from_message(const CrossLayerMessage& message);
+    // Writes the payload's fields into a message's parameters
+    void write(MetricSet& parameters) const;
+};
+
+// Decision thresholds of the adaptation rules
+struct OptimizationThresholds {
+    double poor_signal_dbm;         // Below: conservative TCP, handover request
+    double good_signal_dbm;         // Above, with low interference: aggressive TCP
+    double good_interference;
+    double high_congestion;         // Raises CONGESTION_DETECTED
+    double congestion_response;     // Congestion level that throttles TCP
+    double high_loss_rate;          // Above: Tahoe
+    double low_loss_rate;           // Below, at low throughput: BBR
+    double low_throughput_mbps;
+    double high_error_rate;         // Stronger error correction
+    double robust_error_rate;       // Robust transport error handling
+    double high_mobility_kmh;       // Handover parameter profiles
+    double low_mobility_kmh;
+    double low_battery;             // Fraction; power saving below
+};
+
+// Subscriber fast path: a plain function and its context, no std::function
+typedef void (*CrossLayerCallback)(void* context, const CrossLayerMessage& message,
+                                   const CrossLayerPayload& payload);
+typedef std::function<void(const CrossLayerMessage&, const CrossLayerPayload&)> CrossLayerHandler;
+
 class CrossLayerOptimizer {
 private:
-    std::map<LayerType, LayerInfo> layer_states;
+    std::vector<LayerInfo> layer_states;   // Indexed by LayerType
+    std::vector<std::function<void(const CrossLayerMessage&)>> event_handlers;  // Every message
+
+    // Subscriptions by route, [event][destination]. Changes made while
+    // dispatching are applied once the queue is empty.
+    struct Subscriber {
+        int subscription_id;
+        CrossLayerCallback callback;    // Fast path; null when handler is used
+        void* context;
+        CrossLayerHandler handler;
+        bool active;
+    };
+    std::vector<std::vector<Subscriber>> subscription_table;
+    std::vector<std::pair<int, Subscriber>> deferred_subscriptions;    // route, subscriber
+    bool subscriptions_dirty;           // Inactive entries awaiting removal
+    int next_subscription_id;
+
+    // Messages sent while another is being handled wait here rather than
+    // recursing. A message for the same event and route as one still queued
+    // replaces it.
+    struct QueuedMessage {
+        CrossLayerMessage message;
+        int depth;                          // 0 for messages sent from outside
+        uint64_t enqueued_ns;               // First enqueue, or bus post; 0 when not instrumented
+        double enqueued_sim_ms;
+    };
+    std::vector<QueuedMessage> message_queue;   // Ring, max_queued_messages slots
+    size_t queue_head;
+    size_t queue_count;
+    std::vector<int> coalesce_slots;        // [event][source][destination] -> ring slot or -1
+    bool dispatching;
+    bool batched_dispatch;                  // true: send only queues, dispatch_pending_messages runs them
+    int current_depth;
+    int max_dispatch_depth;
+
+    uint64_t messages_sent;
+    uint64_t messages_dispatched;
+    uint64_t messages_coalesced;
+    uint64_t messages_dropped_depth;
+    uint64_t messages_dropped_queue;
+    size_t peak_queue_depth;
+
+    // Messages posted from other threads, drained by the optimizer's thread
+    std::unique_ptr<CrossLayerMessageBus> message_bus;
+    std::unique_ptr<CrossLayerRecord[]> bus_batch;
+    size_t bus_batch_size;
+    CrossLayerMessage bus_message;
+
+    // Dispatch instrumentation per event type. Only the thread dispatching
+    // for this optimizer records, so the hot path takes no locks or atomics.
+    struct EventInstrumentation {
+        HdrHistogram wall_latency_ns;       // Enqueue (bus post for posted messages) to handlers done
+        HdrHistogram sim_latency_us;        // The same on the simulation clock
+        HdrHistogram actions;               // Handlers run plus messages they sent
+        HdrHistogram queue_depth;           // Pending messages after each enqueue
+    };
+    std::vector<EventInstrumentation> event_instrumentation;   // Indexed by CrossLayerEvent
+    HdrHistogram bus_backlog;               // Records waiting when a drain starts
+    bool instrumentation_enabled;
+    double simulation_clock_ms;
+
+    // Last history_capacity dispatched messages, oldest at history_head once full
     std::vector<CrossLayerMessage> message_history;
-    std::vector<std::function<void(const CrossLayerMessage&)>> event_handlers;
+    size_t history_capacity;
+    size_t history_head;
     
     // Layer references
     std::shared_ptr<TCPTahoe> tcp_layer;
@@ -60,6 +199,7 @@ private:
     double optimization_weight_throughput;
     double optimization_weight_latency;
     double optimization_weight_energy;
+    OptimizationThresholds thresholds;
     
     // Performance metrics
     std::vector<double> throughput_history;
@@ -67,8 +207,34 @@ private:
     std::vector<double> energy_consumption_history;
     std::vector<double> packet_loss_history;
 
+    // Network condition simulation, per instance so optimizers can run on
+    // separate threads. Each random process draws from its own stream.
+    uint64_t simulation_seed;
+    uint64_t simulation_stream;
+    double mobility_position;
+    double traffic_time;
+    std::mt19937_64 interference_rng;
+
+    // Co-simulation: one transport flow per UE of lte_network
+    std::unique_ptr<TransportFlowTable> flow_table;
+    std::unique_ptr<PolicyEngine> policy_engine;
+    uint64_t policy_check_interval_ns;      // Wall clock between policy file checks
+    uint64_t next_policy_check_ns;
+
+    void apply_flow_policy(const LTEStateArrays& state);
+
+    const LayerInfo& layer_state(LayerType layer) const;
+    int coalesce_key(const CrossLayerMessage& message) const;
+    static int route_key(CrossLayerEvent event, LayerType destination);
+    int add_subscriber(CrossLayerEvent event, LayerType destination, const Subscriber& subscriber);
+    void apply_subscription_changes();
+    void enqueue_message(const CrossLayerMessage& message, int depth, uint64_t posted_ns = 0);
+    size_t handle_message(const CrossLayerMessage& message);   // Handlers run
+    void record_message(const CrossLayerMessage& message);
+
 public:
     CrossLayerOptimizer();
+    ~CrossLayerOptimizer();
     
     // Layer management
     void register_layer(LayerType layer, std::shared_ptr<void> layer_instance);
@@ -78,11 +244,46 @@ public:
     // Cross-layer communication
     void send_cross_layer_message(const CrossLayerMessage& message);
     void register_event_handler(std::function<void(const CrossLayerMessage&)> handler);
+    // Handlers that only see messages for one event and destination;
+    // dispatch cost depends only on how many match
+    int subscribe(CrossLayerEvent event, LayerType destination, CrossLayerCallback callback, void* context);
+    int subscribe(CrossLayerEvent event, LayerType destination, CrossLayerHandler handler);
+    void unsubscribe(int subscription_id);
+    size_t get_subscriber_count(CrossLayerEvent event, LayerType destination) const;
     std::vector<CrossLayerMessage> get_message_history() const;
+    void set_batched_dispatch(bool enable);
+    void dispatch_pending_messages();
+    void set_dispatch_limits(size_t max_queued_messages, int max_depth);
+    void set_message_history_capacity(size_t capacity);
+    size_t get_pending_message_count() const;
+    std::map<std::string, double> get_dispatch_statistics() const;
+    // HDR histograms per event type of the latency from enqueue to handler
+    // completion (wall clock and simulation clock), actions per message and
+    // queue depth. Keys are "<event>.<metric>.<stat>", with "all" merging
+    // every event and "bus.backlog" the records waiting per drain.
+    void set_instrumentation_enabled(bool enable);
+    void reset_instrumentation();
+    std::map<std::string, double> get_instrumentation_statistics() const;
+    // Simulated time, advanced by step_cosimulation or by the caller
+    void advance_simulation_clock(double ms);
+    double get_simulation_clock_ms() const;
+
+    // Thread-safe entry point for layers on other threads; never blocks and
+    // returns false when the bus is full. The optimizer's own thread calls
+    // drain_message_bus to dispatch what has arrived. The bus starts with 64
+    // slots (about 40 KB); multi-threaded producers should size it up front.
+    bool post_message(const CrossLayerMessage& message);
+    size_t drain_message_bus(size_t max_messages = 0);
+    void set_message_bus_capacity(size_t capacity);
+    std::map<std::string, double> get_message_bus_statistics() const;
     
     // Optimization strategies
     void enable_adaptive_optimization(bool enable);
     void set_optimization_weights(double throughput, double latency, double energy);
+    std::vector<double> get_optimization_weights() const;     // throughput, latency, energy
+    static OptimizationThresholds default_thresholds();
+    void set_thresholds(const OptimizationThresholds& thresholds);
+    OptimizationThresholds get_thresholds() const;
     void optimize_network_performance();
     void adapt_to_network_conditions();
     
@@ -101,10 +302,35 @@ public:
     std::vector<double> get_latency_history() const;
     
     // Network condition simulation
+    // Streams derive from (seed, stream), so a sweep can give every
+    // scenario the same seed and its own stream; reset() rewinds them
+    void set_simulation_seed(uint64_t seed, uint64_t stream = 0);
+    uint64_t get_simulation_seed() const;
     void simulate_mobility();
     void simulate_interference();
     void simulate_traffic_variation();
     
+    // Per-UE co-simulation: each step advances lte_network and then one
+    // fluid TCP flow per UE against its scheduled rate and SINR; the layer
+    // states carry the flows' aggregates instead of synthetic values
+    bool enable_cosimulation(const TransportFlowConfig& config);
+    void disable_cosimulation();
+    bool is_cosimulation_enabled() const;
+    bool step_cosimulation();
+    const TransportFlowTable* get_flow_table() const;
+    std::map<std::string, double> get_cosimulation_statistics() const;
+    // Declarative policy (see PolicyEngine) evaluated over every flow per
+    // co-simulation step, a loaded file re-read when it changes (checked at
+    // most every set_policy_reload_interval ms of wall clock). Rules
+    // see each flow's sinr_db, rate_mbps, goodput_mbps, cwnd, rtt_ms and
+    // queue_bytes, and every layer metric as a shared value. The flow
+    // table applies max_cwnd; other actions are left for get_policy_engine().
+    bool load_policy(const std::string& text);
+    bool load_policy_file(const std::string& path);
+    void clear_policy();
+    void set_policy_reload_interval(double interval_ms);
+    const PolicyEngine* get_policy_engine() const;
+    
     // Event handling
     void handle_signal_strength_change(double new_strength);
     void handle_handover_event(const std::string& target_cell);
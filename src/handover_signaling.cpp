@@ -0,0 +1,363 @@
+#include "handover_signaling.h"
+#include "lte_network.h"
+#include <algorithm>
+#include <cmath>
+
+HandoverSignaling::HandoverSignaling() {
+    config = default_config();
+    mme_node = 0;
+    reset();
+}
+
+HandoverSignalingConfig HandoverSignaling::default_config() {
+    HandoverSignalingConfig config;
+    config.enabled = false;
+    config.x2_latency_ms = 5.0;
+    config.s1_latency_ms = 10.0;
+    config.air_latency_ms = 2.0;
+    config.rach_ms = 10.0;
+    config.enb_processing_ms = 0.5;
+    config.mme_processing_ms = 1.0;
+    config.preparation_timeout_ms = 200.0;
+    return config;
+}
+
+void HandoverSignaling::configure(const HandoverSignalingConfig& config) {
+    this->config = config;
+}
+
+HandoverSignalingConfig HandoverSignaling::get_config() const {
+    return config;
+}
+
+bool HandoverSignaling::is_enabled() const {
+    return config.enabled;
+}
+
+void HandoverSignaling::reset() {
+    events = std::priority_queue<Event, std::vector<Event>, std::greater<Event>>();
+    next_sequence = 0;
+    procedures.clear();
+    free_procedures.clear();
+    ue_procedures.clear();
+    node_busy_until.clear();
+    mme_node = 0;
+
+    started = 0;
+    completed = 0;
+    failed = 0;
+    message_counts.assign(static_cast<size_t>(SignalingMessage::UE_CONTEXT_RELEASE) + 1, 0);
+    node_messages.clear();
+    total_queue_wait_ms = 0.0;
+    max_queue_wait_ms = 0.0;
+    peak_pending_events = 0;
+    interruption_times.clear();
+    procedure_latencies.clear();
+}
+
+void HandoverSignaling::ensure_nodes(int num_enbs) {
+    // The MME sits after the eNBs; growing the cell list moves it up
+    if (num_enbs + 1 <= static_cast<int>(node_busy_until.size())) return;
+    double mme_busy = node_busy_until.empty() ? 0.0 : node_busy_until[mme_node];
+    uint64_t mme_messages = node_messages.empty() ? 0 : node_messages[mme_node];
+    if (!node_busy_until.empty()) {
+        node_busy_until[mme_node] = 0.0;
+        node_messages[mme_node] = 0;
+    }
+    node_busy_until.resize(num_enbs + 1, 0.0);
+    node_messages.resize(num_enbs + 1, 0);
+    mme_node = num_enbs;
+    node_busy_until[mme_node] = mme_busy;
+    node_messages[mme_node] = mme_messages;
+}
+
+void HandoverSignaling::send(int procedure, SignalingMessage message, double sent_ms, double latency_ms) {
+    Event event;
+    event.time_ms = sent_ms + latency_ms;
+    event.sequence = next_sequence++;
+    event.procedure = procedure;
+    event.generation = procedures[procedure].generation;
+    event.message = message;
+    event.processed = false;
+    events.push(event);
+    message_counts[static_cast<size_t>(message)]++;
+    peak_pending_events = std::max(peak_pending_events, events.size());
+}
+
+double HandoverSignaling::process_at(int node, double arrival_ms) {
+    // FIFO single server: arrivals are seen in time order, so the service
+    // start is simply the later of arrival and the previous departure
+    double start = std::max(arrival_ms, node_busy_until[node]);
+    double service = node == mme_node ? config.mme_processing_ms : config.enb_processing_ms;
+    double wait = start - arrival_ms;
+    total_queue_wait_ms += wait;
+    max_queue_wait_ms = std::max(max_queue_wait_ms, wait);
+    node_messages[node]++;
+    node_busy_until[node] = start + service;
+    return start + service;
+}
+
+void HandoverSignaling::finish(int procedure) {
+    procedures[procedure].active = false;
+    procedures[procedure].generation++;
+    ue_procedures.erase(procedures[procedure].ue_id);
+    free_procedures.push_back(procedure);
+}
+
+bool HandoverSignaling::start_handover(int ue_id, int source_index, int target_index, int target_cell,
+                                       int num_enbs, double now_ms) {
+    if (ue_procedures.count(ue_id)) return false;
+    ensure_nodes(num_enbs);
+
+    int id;
+    if (free_procedures.empty()) {
+        id = static_cast<int>(procedures.size());
+        procedures.push_back(Procedure());
+        procedures[id].generation = 0;
+    } else {
+        id = free_procedures.back();
+        free_procedures.pop_back();
+    }
+    Procedure& procedure = procedures[id];
+    procedure.ue_id = ue_id;
+    procedure.source_node = source_index;
+    procedure.target_node = target_index;
+    procedure.target_cell = target_cell;
+    procedure.start_ms = now_ms;
+    procedure.detach_ms = now_ms;
+    procedure.active = true;
+    ue_procedures[ue_id] = id;
+    started++;
+
+    // The source handles the measurement report, then asks the target
+    double decided = process_at(source_index, now_ms);
+    send(id, SignalingMessage::HANDOVER_REQUEST, decided, config.x2_latency_ms);
+    return true;
+}
+
+bool HandoverSignaling::is_pending(int ue_id) const {
+    return ue_procedures.count(ue_id) > 0;
+}
+
+void HandoverSignaling::advance(double now_ms, std::vector<HandoverTransition>& transitions) {
+    while (!events.empty() && events.top().time_ms <= now_ms) {
+        Event event = events.top();
+        events.pop();
+        Procedure& procedure = procedures[event.procedure];
+        if (!procedure.active || procedure.generation != event.generation) continue;
+
+        // RRC to the UE is not queued; everything else is served by the
+        // destination node first and acted on when service completes
+        if (event.message != SignalingMessage::RRC_RECONFIGURATION && !event.processed) {
+            int node = procedure.target_node;
+            if (event.message == SignalingMessage::HANDOVER_REQUEST_ACK ||
+                event.message == SignalingMessage::UE_CONTEXT_RELEASE) {
+                node = procedure.source_node;
+            } else if (event.message == SignalingMessage::PATH_SWITCH_REQUEST) {
+                node = mme_node;
+            }
+            event.time_ms = process_at(node, event.time_ms);
+            event.sequence = next_sequence++;
+            event.processed = true;
+            events.push(event);
+            continue;
+        }
+
+        double t = event.time_ms;
+        HandoverTransition transition;
+        transition.ue_id = procedure.ue_id;
+        transition.target_cell = procedure.target_cell;
+        transition.time_ms = t;
+        transition.interruption_ms = 0.0;
+        transition.latency_ms = 0.0;
+
+        switch (event.message) {
+            case SignalingMessage::HANDOVER_REQUEST:
+                send(event.procedure, SignalingMessage::HANDOVER_REQUEST_ACK, t, config.x2_latency_ms);
+                break;
+            case SignalingMessage::HANDOVER_REQUEST_ACK:
+                if (t - procedure.start_ms > config.preparation_timeout_ms) {
+                    // TRELOCprep expired; the UE stays on the source
+                    transition.kind = HandoverTransition::FAIL;
+                    transition.latency_ms = t - procedure.start_ms;
+                    transitions.push_back(transition);
+                    failed++;
+                    finish(event.procedure);
+                    break;
+                }
+                send(event.procedure, SignalingMessage::RRC_RECONFIGURATION, t, config.air_latency_ms);
+                send(event.procedure, SignalingMessage::SN_STATUS_TRANSFER, t, config.x2_latency_ms);
+                break;
+            case SignalingMessage::RRC_RECONFIGURATION:
+                procedure.detach_ms = t;
+                transition.kind = HandoverTransition::DETACH;
+                transitions.push_back(transition);
+                send(event.procedure, SignalingMessage::RRC_RECONFIGURATION_COMPLETE, t,
+                     config.rach_ms + config.air_latency_ms);
+                break;
+            case SignalingMessage::SN_STATUS_TRANSFER:
+                break;
+            case SignalingMessage::RRC_RECONFIGURATION_COMPLETE:
+                transition.kind = HandoverTransition::ATTACH;
+                transition.interruption_ms = t - procedure.detach_ms;
+                transitions.push_back(transition);
+                interruption_times.push_back(transition.interruption_ms);
+                send(event.procedure, SignalingMessage::PATH_SWITCH_REQUEST, t, config.s1_latency_ms);
+                break;
+            case SignalingMessage::PATH_SWITCH_REQUEST:
+                send(event.procedure, SignalingMessage::PATH_SWITCH_ACK, t, config.s1_latency_ms);
+                break;
+            case SignalingMessage::PATH_SWITCH_ACK:
+                send(event.procedure, SignalingMessage::UE_CONTEXT_RELEASE, t, config.x2_latency_ms);
+                break;
+            case SignalingMessage::UE_CONTEXT_RELEASE:
+                transition.kind = HandoverTransition::COMPLETE;
+                transition.latency_ms = t - procedure.start_ms;
+                transitions.push_back(transition);
+                procedure_latencies.push_back(transition.latency_ms);
+                completed++;
+                finish(event.procedure);
+                break;
+        }
+    }
+}
+
+std::map<std::string, double> HandoverSignaling::get_statistics() const {
+    std::map<std::string, double> stats;
+    stats["started"] = started;
+    stats["completed"] = completed;
+    stats["failed"] = failed;
+    stats["pending"] = ue_procedures.size();
+    stats["peak_pending_messages"] = peak_pending_events;
+
+    uint64_t total_messages = 0;
+    for (uint64_t count : message_counts) total_messages += count;
+    stats["messages"] = total_messages;
+    stats["x2_messages"] = message_counts[static_cast<size_t>(SignalingMessage::HANDOVER_REQUEST)] +
+                           message_counts[static_cast<size_t>(SignalingMessage::HANDOVER_REQUEST_ACK)] +
+                           message_counts[static_cast<size_t>(SignalingMessage::SN_STATUS_TRANSFER)] +
+                           message_counts[static_cast<size_t>(SignalingMessage::UE_CONTEXT_RELEASE)];
+    stats["s1_messages"] = message_counts[static_cast<size_t>(SignalingMessage::PATH_SWITCH_REQUEST)] +
+                           message_counts[static_cast<size_t>(SignalingMessage::PATH_SWITCH_ACK)];
+
+    uint64_t served = 0, busiest_enb = 0;
+    for (size_t node = 0; node < node_messages.size(); node++) {
+        served += node_messages[node];
+        if (static_cast<int>(node) != mme_node) busiest_enb = std::max(busiest_enb, node_messages[node]);
+    }
+    stats["busiest_enb_messages"] = busiest_enb;
+    stats["mme_messages"] = node_messages.empty() ? 0 : node_messages[mme_node];
+    stats["mean_queue_wait_ms"] = served > 0 ? total_queue_wait_ms / served : 0.0;
+    stats["max_queue_wait_ms"] = max_queue_wait_ms;
+
+    double interruption_sum = 0.0, interruption_max = 0.0;
+    for (double t : interruption_times) {
+        interruption_sum += t;
+        interruption_max = std::max(interruption_max, t);
+    }
+    double latency_sum = 0.0, latency_max = 0.0;
+    for (double t : procedure_latencies) {
+        latency_sum += t;
+        latency_max = std::max(latency_max, t);
+    }
+    stats["mean_interruption_ms"] = interruption_times.empty() ? 0.0 : interruption_sum / interruption_times.size();
+    stats["max_interruption_ms"] = interruption_max;
+    stats["mean_procedure_ms"] = procedure_latencies.empty() ? 0.0 : latency_sum / procedure_latencies.size();
+    stats["max_procedure_ms"] = latency_max;
+    return stats;
+}
+
+std::vector<double> HandoverSignaling::get_interruption_times() const {
+    return interruption_times;
+}
+
+void LTENetwork::configure_handover_signaling(const HandoverSignalingConfig& config) {
+    handover_signaling.configure(config);
+}
+
+HandoverSignalingConfig LTENetwork::get_handover_signaling_config() const {
+    return handover_signaling.get_config();
+}
+
+HandoverEvent LTENetwork::start_signaled_handover(int ue_id, int target_cell) {
+    // Times are simulated milliseconds on the signaling clock
+    HandoverEvent handover;
+    handover.ue_id = ue_id;
+    handover.source_cell = -1;
+    handover.target_cell = target_cell;
+    handover.type = HandoverType::INTRA_LTE;
+    handover.trigger_rsrp = 0.0;
+    handover.target_rsrp = 0.0;
+    handover.start_time = static_cast<uint64_t>(signaling_clock_ms);
+    handover.completion_time = 0;
+    handover.success = false;
+
+    int target_index = find_cell_index(target_cell);
+    for (const auto& user : users) {
+        if (user.ue_id != ue_id) continue;
+        handover.source_cell = user.serving_cell;
+        int source_index = find_cell_index(user.serving_cell);
+        if (source_index < 0 || target_index < 0) {
+            handover.completion_time = handover.start_time;
+            handover.failure_reason = "Unknown cell";
+            return handover;
+        }
+        handover.trigger_rsrp = calculate_rsrp_at(user.x_position, user.y_position, cells[source_index]);
+        handover.target_rsrp = calculate_rsrp_at(user.x_position, user.y_position, cells[target_index]);
+        if (!handover_signaling.start_handover(ue_id, source_index, target_index, target_cell,
+                                               static_cast<int>(cells.size()), signaling_clock_ms)) {
+            handover.completion_time = handover.start_time;
+            handover.failure_reason = "Handover already in progress";
+        }
+        return handover;
+    }
+    handover.completion_time = handover.start_time;
+    handover.failure_reason = "Unknown UE";
+    return handover;
+}
+
+void LTENetwork::process_handover_signaling() {
+    // The UE keeps its source link through preparation, is out of service
+    // from RRC reconfiguration until it reaches the target, and the
+    // history entry closes when the source releases the context
+    signaling_clock_ms += get_slot_duration_ms();
+    std::vector<HandoverTransition> transitions;
+    handover_signaling.advance(signaling_clock_ms, transitions);
+
+    for (const auto& transition : transitions) {
+        int index = find_user_index(transition.ue_id);
+        if (index >= 0) {
+            UserEquipment& user = users[index];
+            if (transition.kind == HandoverTransition::DETACH) {
+                user.state = LTEState::HANDOVER_EXECUTION;
+                user.current_throughput = 0.0;
+            } else if (transition.kind == HandoverTransition::ATTACH) {
+                // This step's scheduling pass gives it a rate on the target
+                user.serving_cell = transition.target_cell;
+                user.state = LTEState::CONNECTED;
+            }
+        }
+        if (transition.kind != HandoverTransition::COMPLETE && transition.kind != HandoverTransition::FAIL) {
+            continue;
+        }
+
+        // Close the UE's open history entry
+        auto open = open_handover_entries.find(transition.ue_id);
+        if (open == open_handover_entries.end()) continue;
+        HandoverEvent& entry = handover_history[open->second];
+        entry.completion_time = entry.start_time + static_cast<uint64_t>(std::ceil(transition.latency_ms));
+        entry.success = transition.kind == HandoverTransition::COMPLETE;
+        if (!entry.success) entry.failure_reason = "TRELOCprep expiry";
+        open_handover_entries.erase(open);
+    }
+}
+
+std::map<std::string, double> LTENetwork::get_handover_signaling_statistics() const {
+    std::map<std::string, double> stats = handover_signaling.get_statistics();
+    stats["clock_ms"] = signaling_clock_ms;
+    return stats;
+}
+
+std::vector<double> LTENetwork::get_handover_interruption_times() const {
+    return handover_signaling.get_interruption_times();
+}
@@ -0,0 +1,122 @@
+#ifndef HANDOVER_SIGNALING_H
+#define HANDOVER_SIGNALING_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <cstdint>
+
+// X2 handover messages, TS 36.300 10.1.2.1
+enum class SignalingMessage {
+    HANDOVER_REQUEST,               // Source -> target, X2
+    HANDOVER_REQUEST_ACK,           // Target -> source, X2
+    RRC_RECONFIGURATION,            // Source -> UE, UE detaches on receipt
+    SN_STATUS_TRANSFER,             // Source -> target, X2
+    RRC_RECONFIGURATION_COMPLETE,   // UE -> target after random access
+    PATH_SWITCH_REQUEST,            // Target -> MME, S1
+    PATH_SWITCH_ACK,                // MME -> target, S1
+    UE_CONTEXT_RELEASE              // Target -> source, X2
+};
+
+struct HandoverSignalingConfig {
+    bool enabled;                   // false: handovers complete instantly
+    double x2_latency_ms;
+    double s1_latency_ms;
+    double air_latency_ms;          // RRC over Uu
+    double rach_ms;                 // UE synchronisation and random access on the target
+    double enb_processing_ms;       // Service time per message at an eNB
+    double mme_processing_ms;
+    double preparation_timeout_ms;  // TRELOCprep; later acks fail the handover
+};
+
+// What the network has to apply as signaling progresses
+struct HandoverTransition {
+    enum Kind { DETACH, ATTACH, COMPLETE, FAIL };
+    Kind kind;
+    int ue_id;
+    int target_cell;
+    double time_ms;
+    double interruption_ms;         // ATTACH: time since DETACH
+    double latency_ms;              // COMPLETE / FAIL: time since the decision
+};
+
+// Discrete-event model of handover signaling. Messages travel over links
+// with fixed latency and queue at their destination node, every eNB (by
+// cell index) and the MME being a FIFO single server, so a burst of
+// handovers into the same cells builds up processing delay.
+class HandoverSignaling {
+private:
+    struct Event {
+        double time_ms;             // Arrival at the destination node
+        uint64_t sequence;          // FIFO among equal times
+        int procedure;
+        uint32_t generation;        // Procedure slots are reused
+        SignalingMessage message;
+        bool processed;             // false: arrival, true: service completed
+        bool operator>(const Event& other) const {
+            return time_ms > other.time_ms || (time_ms == other.time_ms && sequence > other.sequence);
+        }
+    };
+
+    struct Procedure {
+        int ue_id;
+        int source_node;
+        int target_node;
+        int target_cell;
+        double start_ms;
+        double detach_ms;
+        uint32_t generation;
+        bool active;
+    };
+
+    HandoverSignalingConfig config;
+    int mme_node;
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    uint64_t next_sequence;
+    std::vector<Procedure> procedures;
+    std::vector<int> free_procedures;
+    std::unordered_map<int, int> ue_procedures;     // ue_id -> procedure
+    std::vector<double> node_busy_until;
+
+    // Statistics
+    uint64_t started;
+    uint64_t completed;
+    uint64_t failed;
+    std::vector<uint64_t> message_counts;           // Per SignalingMessage
+    std::vector<uint64_t> node_messages;
+    double total_queue_wait_ms;
+    double max_queue_wait_ms;
+    size_t peak_pending_events;
+    std::vector<double> interruption_times;
+    std::vector<double> procedure_latencies;
+
+    void ensure_nodes(int num_enbs);
+    void send(int procedure, SignalingMessage message, double sent_ms, double latency_ms);
+    double process_at(int node, double arrival_ms);
+    void finish(int procedure);
+
+public:
+    HandoverSignaling();
+
+    static HandoverSignalingConfig default_config();
+    void configure(const HandoverSignalingConfig& config);
+    HandoverSignalingConfig get_config() const;
+    bool is_enabled() const;
+
+    // Starts a procedure once the source has decided; false if one is running
+    bool start_handover(int ue_id, int source_index, int target_index, int target_cell,
+                        int num_enbs, double now_ms);
+    bool is_pending(int ue_id) const;
+
+    // Delivers every message due by now_ms
+    void advance(double now_ms, std::vector<HandoverTransition>& transitions);
+    void reset();
+
+    std::map<std::string, double> get_statistics() const;
+    std::vector<double> get_interruption_times() const;
+};
+
+#endif // HANDOVER_SIGNALING_H
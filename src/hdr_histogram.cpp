@@ -0,0 +1,121 @@
+#include "hdr_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+int highest_bit(uint64_t value) {
+    int bit = 0;
+    if (value >> 32) { value >>= 32; bit += 32; }
+    if (value >> 16) { value >>= 16; bit += 16; }
+    if (value >> 8) { value >>= 8; bit += 8; }
+    if (value >> 4) { value >>= 4; bit += 4; }
+    if (value >> 2) { value >>= 2; bit += 2; }
+    if (value >> 1) { bit += 1; }
+    return bit;
+}
+
+} // namespace
+
+HdrHistogram::HdrHistogram(int precision_bits) {
+    this->precision_bits = std::max(2, std::min(precision_bits, 16));
+    sub_bucket_count = uint64_t(1) << this->precision_bits;
+    reset();
+}
+
+// Values below sub_bucket_count index themselves. Above, the range
+// [2^b, 2^(b+1)) keeps its top precision_bits bits: the upper half of
+// sub-buckets of a histogram scaled down by 2^(b - precision_bits + 1).
+size_t HdrHistogram::index_of(uint64_t value) const {
+    if (value < sub_bucket_count) return static_cast<size_t>(value);
+    int shift = highest_bit(value) - precision_bits + 1;
+    uint64_t half = sub_bucket_count / 2;
+    return static_cast<size_t>(sub_bucket_count + (shift - 1) * half + ((value >> shift) - half));
+}
+
+uint64_t HdrHistogram::highest_value_at(size_t index) const {
+    if (index < sub_bucket_count) return index;
+    uint64_t half = sub_bucket_count / 2;
+    uint64_t shift = (index - sub_bucket_count) / half + 1;
+    uint64_t sub_bucket = (index - sub_bucket_count) % half + half;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+void HdrHistogram::record(uint64_t value) {
+    size_t index = index_of(value);
+    if (index >= counts.size()) counts.resize(index + 1, 0);
+    counts[index]++;
+    total_count++;
+    min_value = std::min(min_value, value);
+    max_value = std::max(max_value, value);
+    sum += static_cast<double>(value);
+}
+
+void HdrHistogram::merge(const HdrHistogram& other) {
+    if (other.total_count == 0) return;
+    if (other.precision_bits == precision_bits) {
+        if (other.counts.size() > counts.size()) counts.resize(other.counts.size(), 0);
+        for (size_t i = 0; i < other.counts.size(); i++) counts[i] += other.counts[i];
+    } else {
+        // Re-bucket at this precision from the other's bucket upper bounds
+        for (size_t i = 0; i < other.counts.size(); i++) {
+            if (other.counts[i] == 0) continue;
+            size_t index = index_of(std::min(other.highest_value_at(i), other.max_value));
+            if (index >= counts.size()) counts.resize(index + 1, 0);
+            counts[index] += other.counts[i];
+        }
+    }
+    total_count += other.total_count;
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+    sum += other.sum;
+}
+
+void HdrHistogram::reset() {
+    counts.clear();
+    total_count = 0;
+    min_value = UINT64_MAX;
+    max_value = 0;
+    sum = 0.0;
+}
+
+uint64_t HdrHistogram::get_count() const {
+    return total_count;
+}
+
+uint64_t HdrHistogram::get_min() const {
+    return total_count ? min_value : 0;
+}
+
+uint64_t HdrHistogram::get_max() const {
+    return max_value;
+}
+
+double HdrHistogram::get_mean() const {
+    return total_count ? sum / total_count : 0.0;
+}
+
+uint64_t HdrHistogram::value_at_percentile(double percentile) const {
+    if (total_count == 0) return 0;
+    double fraction = std::max(0.0, std::min(percentile, 100.0)) / 100.0;
+    uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(fraction * total_count)), 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(highest_value_at(i), max_value);
+    }
+    return max_value;
+}
+
+std::map<std::string, double> HdrHistogram::get_statistics(double scale) const {
+    std::map<std::string, double> stats;
+    stats["count"] = total_count;
+    stats["mean"] = get_mean() * scale;
+    stats["min"] = get_min() * scale;
+    stats["max"] = get_max() * scale;
+    stats["p50"] = value_at_percentile(50.0) * scale;
+    stats["p90"] = value_at_percentile(90.0) * scale;
+    stats["p99"] = value_at_percentile(99.0) * scale;
+    stats["p999"] = value_at_percentile(99.9) * scale;
+    return stats;
+}
@@ -0,0 +1,44 @@
+#ifndef HDR_HISTOGRAM_H
+#define HDR_HISTOGRAM_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+
+// Log-linear histogram after HdrHistogram: each power-of-two range is split
+// into 2^(precision_bits - 1) linear sub-buckets, so a recorded value is
+// kept to within 2^-(precision_bits - 1) relative error across the whole
+// 64-bit range. record() is a few integer operations and an increment; the
+// count array grows only to the largest value seen. One writer at a time.
+class HdrHistogram {
+private:
+    int precision_bits;
+    uint64_t sub_bucket_count;          // 2^precision_bits
+    std::vector<uint64_t> counts;
+    uint64_t total_count;
+    uint64_t min_value;
+    uint64_t max_value;
+    double sum;
+
+    size_t index_of(uint64_t value) const;
+    uint64_t highest_value_at(size_t index) const;
+
+public:
+    explicit HdrHistogram(int precision_bits = 7);
+
+    void record(uint64_t value);
+    void merge(const HdrHistogram& other);
+    void reset();
+
+    uint64_t get_count() const;
+    uint64_t get_min() const;
+    uint64_t get_max() const;
+    double get_mean() const;
+    // Upper bound of the bucket holding the percentile (0-100), capped at max
+    uint64_t value_at_percentile(double percentile) const;
+    // count, mean, min, max, p50, p90, p99, p999; values multiplied by scale
+    std::map<std::string, double> get_statistics(double scale = 1.0) const;
+};
+
+#endif // HDR_HISTOGRAM_H
@@ -0,0 +1,189 @@
+#include "link_abstraction.h"
+#include <cmath>
+#include <algorithm>
+
+LinkAbstraction::LinkAbstraction(double min_sinr_db, double max_sinr_db, double step_db) {
+    table_min_sinr_db = min_sinr_db;
+    table_step_db = step_db;
+    table_inv_step = 1.0 / step_db;
+    table_size = static_cast<int>(std::round((max_sinr_db - min_sinr_db) / step_db)) + 1;
+    bler_slope_db = 0.8;
+
+    build_cqi_table();
+    build_mcs_table();
+    build_bler_tables();
+}
+
+void LinkAbstraction::build_cqi_table() {
+    // 3GPP TS 36.213 Table 7.2.3-1 with typical AWGN 10% BLER thresholds
+    // and EESM beta values for a 1 ms TTI
+    cqi_table = {
+        {1,  ModulationScheme::QPSK,   78, 0.1523, -6.7,  1.49},
+        {2,  ModulationScheme::QPSK,  120, 0.2344, -4.7,  1.53},
+        {3,  ModulationScheme::QPSK,  193, 0.3770, -2.3,  1.57},
+        {4,  ModulationScheme::QPSK,  308, 0.6016,  0.2,  1.61},
+        {5,  ModulationScheme::QPSK,  449, 0.8770,  2.4,  1.69},
+        {6,  ModulationScheme::QPSK,  602, 1.1758,  4.3,  1.69},
+        {7,  ModulationScheme::QAM16, 378, 1.4766,  5.9,  3.36},
+        {8,  ModulationScheme::QAM16, 490, 1.9141,  8.1,  4.56},
+        {9,  ModulationScheme::QAM16, 616, 2.4063, 10.3,  6.42},
+        {10, ModulationScheme::QAM64, 466, 2.7305, 11.7,  7.33},
+        {11, ModulationScheme::QAM64, 567, 3.3223, 14.1,  7.68},
+        {12, ModulationScheme::QAM64, 666, 3.9023, 16.3,  9.21},
+        {13, ModulationScheme::QAM64, 772, 4.5234, 18.7, 10.81},
+        {14, ModulationScheme::QAM64, 873, 5.1152, 21.0, 13.76},
+        {15, ModulationScheme::QAM64, 948, 5.5547, 22.7, 14.50}
+    };
+}
+
+void LinkAbstraction::build_mcs_table() {
+    // MCS 0-28 (TS 36.213 Table 7.1.7.1-1), each tied to the CQI whose
+    // efficiency it is closest to
+    static const int mcs_cqi[29] = {
+        1, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 9,
+        10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15
+    };
+
+    mcs_table.clear();
+    for (int mcs = 0; mcs <= 28; mcs++) {
+        MCSEntry entry;
+        entry.mcs = mcs;
+        if (mcs <= 9) {
+            entry.modulation = ModulationScheme::QPSK;
+            entry.tbs_index = mcs;
+        } else if (mcs <= 16) {
+            entry.modulation = ModulationScheme::QAM16;
+            entry.tbs_index = mcs - 1;
+        } else {
+            entry.modulation = ModulationScheme::QAM64;
+            entry.tbs_index = mcs - 2;
+        }
+        entry.cqi = mcs_cqi[mcs];
+        mcs_table.push_back(entry);
+    }
+}
+
+void LinkAbstraction::build_bler_tables() {
+    int num_rows = get_max_cqi() + 1;
+    bler_table.assign(static_cast<size_t>(num_rows) * table_size, 1.0);
+
+    // Waterfall curve BLER = 0.5 * erfc((x - x50) / (sqrt(2) * sigma)),
+    // anchored so that BLER(threshold) = 10%
+    const double z_10_percent = 1.2816;
+    for (int cqi = 1; cqi < num_rows; cqi++) {
+        double x50 = cqi_table[cqi - 1].sinr_threshold_db - z_10_percent * bler_slope_db;
+        double* row = &bler_table[static_cast<size_t>(cqi) * table_size];
+        for (int i = 0; i < table_size; i++) {
+            double sinr_db = table_min_sinr_db + i * table_step_db;
+            row[i] = 0.5 * std::erfc((sinr_db - x50) / (std::sqrt(2.0) * bler_slope_db));
+        }
+    }
+}
+
+const std::vector<CQIEntry>& LinkAbstraction::get_cqi_table() const {
+    return cqi_table;
+}
+
+const std::vector<MCSEntry>& LinkAbstraction::get_mcs_table() const {
+    return mcs_table;
+}
+
+int LinkAbstraction::get_max_cqi() const {
+    return static_cast<int>(cqi_table.size());
+}
+
+double LinkAbstraction::effective_sinr_eesm(const double* rb_sinr_db, size_t num_rbs, double beta) const {
+    if (num_rbs == 0) return table_min_sinr_db;
+
+    // SINR_eff = -beta * ln(mean(exp(-sinr_i / beta))), evaluated relative to
+    // the weakest RB so the exponentials cannot underflow at high SINR
+    const double db_to_ln = std::log(10.0) / 10.0;
+    double min_linear = std::exp(rb_sinr_db[0] * db_to_ln);
+    for (size_t i = 1; i < num_rbs; i++) {
+        min_linear = std::min(min_linear, std::exp(rb_sinr_db[i] * db_to_ln));
+    }
+
+    double inv_beta = 1.0 / beta;
+    double sum = 0.0;
+    for (size_t i = 0; i < num_rbs; i++) {
+        double linear = std::exp(rb_sinr_db[i] * db_to_ln);
+        sum += std::exp(-(linear - min_linear) * inv_beta);
+    }
+
+    double effective_linear = min_linear - beta * std::log(sum / num_rbs);
+    return 10.0 * std::log10(std::max(effective_linear, 1e-12));
+}
+
+double LinkAbstraction::effective_sinr_eesm(const std::vector<double>& rb_sinr_db, int cqi) const {
+    return effective_sinr_eesm(rb_sinr_db.data(), rb_sinr_db.size(), get_eesm_beta(cqi));
+}
+
+int LinkAbstraction::select_cqi(double sinr_db) const {
+    // Highest CQI whose 10% BLER threshold is met; thresholds are monotonic
+    // so this is a count rather than a search
+    int cqi = 0;
+    for (const auto& entry : cqi_table) {
+        cqi += (sinr_db >= entry.sinr_threshold_db) ? 1 : 0;
+    }
+    return cqi;
+}
+
+int LinkAbstraction::cqi_to_mcs(int cqi) const {
+    cqi = std::min(std::max(cqi, 1), get_max_cqi());
+    int mcs = 0;
+    for (const auto& entry : mcs_table) {
+        mcs = (entry.cqi <= cqi) ? entry.mcs : mcs;
+    }
+    return mcs;
+}
+
+int LinkAbstraction::mcs_to_cqi(int mcs) const {
+    mcs = std::min(std::max(mcs, 0), static_cast<int>(mcs_table.size()) - 1);
+    return mcs_table[mcs].cqi;
+}
+
+double LinkAbstraction::get_spectral_efficiency(int cqi) const {
+    if (cqi <= 0) return 0.0;
+    return cqi_table[std::min(cqi, get_max_cqi()) - 1].spectral_efficiency;
+}
+
+double LinkAbstraction::get_eesm_beta(int cqi) const {
+    cqi = std::min(std::max(cqi, 1), get_max_cqi());
+    return cqi_table[cqi - 1].eesm_beta;
+}
+
+double LinkAbstraction::lookup_bler(double sinr_db, int cqi) const {
+    double bler;
+    lookup_bler_batch(&sinr_db, &cqi, &bler, 1);
+    return bler;
+}
+
+void LinkAbstraction::lookup_bler_batch(const double* sinr_db, const int* cqi, double* bler_out, size_t count) const {
+    const double* table = bler_table.data();
+    const double max_pos = static_cast<double>(table_size - 1);
+    const int last_index = table_size - 2;
+    const int max_cqi = get_max_cqi();
+
+    for (size_t n = 0; n < count; n++) {
+        double pos = (sinr_db[n] - table_min_sinr_db) * table_inv_step;
+        pos = std::min(std::max(pos, 0.0), max_pos);
+        int i = std::min(static_cast<int>(pos), last_index);
+        double frac = pos - i;
+        int row = std::min(std::max(cqi[n], 0), max_cqi);
+        const double* curve = table + static_cast<size_t>(row) * table_size;
+        bler_out[n] = curve[i] + frac * (curve[i + 1] - curve[i]);
+    }
+}
+
+void LinkAbstraction::select_cqi_batch(const double* sinr_db, int* cqi_out, size_t count) const {
+    for (size_t n = 0; n < count; n++) {
+        cqi_out[n] = 0;
+    }
+    for (const auto& entry : cqi_table) {
+        double threshold = entry.sinr_threshold_db;
+        for (size_t n = 0; n < count; n++) {
+            cqi_out[n] += (sinr_db[n] >= threshold) ? 1 : 0;
+        }
+    }
+}
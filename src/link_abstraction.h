@@ -0,0 +1,76 @@
+#ifndef LINK_ABSTRACTION_H
+#define LINK_ABSTRACTION_H
+
+#include <vector>
+#include <cstddef>
+
+enum class ModulationScheme {
+    QPSK,
+    QAM16,
+    QAM64
+};
+
+struct CQIEntry {
+    int cqi;
+    ModulationScheme modulation;
+    int code_rate_x1024;
+    double spectral_efficiency;   // bits per resource element
+    double sinr_threshold_db;     // SINR for 10% BLER (AWGN)
+    double eesm_beta;             // EESM calibration factor
+};
+
+struct MCSEntry {
+    int mcs;
+    ModulationScheme modulation;
+    int tbs_index;
+    int cqi;                      // CQI entry the MCS is calibrated against
+};
+
+// Link-to-system abstraction: maps per-RB SINR to an effective SINR (EESM),
+// selects CQI/MCS and looks up BLER from precomputed, linearly interpolated
+// tables. All lookups are clamped index arithmetic with no data-dependent
+// branches so the batch variants vectorize.
+class LinkAbstraction {
+private:
+    std::vector<CQIEntry> cqi_table;
+    std::vector<MCSEntry> mcs_table;
+
+    // BLER lookup tables, one row of table_size points per CQI (1-based CQI,
+    // row 0 is the out-of-range CQI 0 and is always 1.0)
+    std::vector<double> bler_table;
+    double table_min_sinr_db;
+    double table_step_db;
+    double table_inv_step;
+    int table_size;
+    double bler_slope_db;         // Std-dev of the erfc waterfall in dB
+
+    void build_cqi_table();
+    void build_mcs_table();
+    void build_bler_tables();
+
+public:
+    LinkAbstraction(double min_sinr_db = -15.0, double max_sinr_db = 35.0, double step_db = 0.1);
+
+    // Tables
+    const std::vector<CQIEntry>& get_cqi_table() const;
+    const std::vector<MCSEntry>& get_mcs_table() const;
+    int get_max_cqi() const;
+
+    // Effective SINR over the allocated RBs
+    double effective_sinr_eesm(const double* rb_sinr_db, size_t num_rbs, double beta) const;
+    double effective_sinr_eesm(const std::vector<double>& rb_sinr_db, int cqi) const;
+
+    // CQI/MCS mapping
+    int select_cqi(double sinr_db) const;
+    int cqi_to_mcs(int cqi) const;
+    int mcs_to_cqi(int mcs) const;
+    double get_spectral_efficiency(int cqi) const;
+    double get_eesm_beta(int cqi) const;
+
+    // BLER lookups
+    double lookup_bler(double sinr_db, int cqi) const;
+    void lookup_bler_batch(const double* sinr_db, const int* cqi, double* bler_out, size_t count) const;
+    void select_cqi_batch(const double* sinr_db, int* cqi_out, size_t count) const;
+};
+
+#endif // LINK_ABSTRACTION_H
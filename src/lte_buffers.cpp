@@ -0,0 +1,61 @@
+#include "lte_network.h"
+#include <algorithm>
+
+void LTENetwork::configure_downlink_buffers(int max_ues, int capacity_per_ue,
+                                            double discard_timer_ms, double tti_ms) {
+    downlink_buffers.configure(max_ues, capacity_per_ue, discard_timer_ms);
+    downlink_tti_ms = std::max(tti_ms, 0.001);
+    buffer_clock_ms = 0.0;
+}
+
+bool LTENetwork::downlink_buffers_enabled() const {
+    return downlink_buffers.enabled();
+}
+
+bool LTENetwork::enqueue_downlink(int ue_id, uint32_t sdu_id, uint32_t bytes) {
+    return downlink_buffers.enqueue(ue_id, sdu_id, bytes, buffer_clock_ms);
+}
+
+void LTENetwork::drain_downlink_buffers() {
+    // Each step is one TTI; a UE can send what its allocation carries in it
+    buffer_clock_ms += downlink_tti_ms;
+    for (const auto& user : users) {
+        int slot = downlink_buffers.find_slot(user.ue_id);
+        if (slot < 0) continue;
+        downlink_buffers.discard_expired(slot, buffer_clock_ms);
+
+        // Paused during handover; the drain still samples the head's delay
+        double budget = 0.0;
+        if (user.state == LTEState::CONNECTED) {
+            budget = std::max(user.current_throughput * 1e6 / 8.0 * downlink_tti_ms / 1000.0, 0.0);
+        }
+        downlink_buffers.drain(slot, static_cast<uint64_t>(budget), buffer_clock_ms);
+    }
+}
+
+double LTENetwork::get_queuing_delay(int ue_id) const {
+    return downlink_buffers.get_queuing_delay(ue_id);
+}
+
+double LTENetwork::get_head_of_line_delay(int ue_id) const {
+    return downlink_buffers.get_head_of_line_delay(ue_id, buffer_clock_ms);
+}
+
+uint64_t LTENetwork::get_delivered_bytes(int ue_id) const {
+    return downlink_buffers.get_last_served_bytes(ue_id);
+}
+
+int LTENetwork::get_discarded_sdus(int ue_id) const {
+    return downlink_buffers.get_last_discards(ue_id);
+}
+
+uint64_t LTENetwork::get_buffered_bytes(int ue_id) const {
+    return downlink_buffers.get_queued_bytes(ue_id);
+}
+
+std::map<std::string, double> LTENetwork::get_buffer_statistics() const {
+    std::map<std::string, double> stats = downlink_buffers.get_statistics();
+    stats["tti_ms"] = downlink_tti_ms;
+    stats["clock_ms"] = buffer_clock_ms;
+    return stats;
+}
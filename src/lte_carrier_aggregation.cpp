@@ -0,0 +1,477 @@
+#include "lte_network.h"
+#include <algorithm>
+#include <cmath>
+
+int LTENetwork::rbs_for_bandwidth(double bandwidth_mhz) {
+    // TS 36.101 transmission bandwidth configurations
+    if (bandwidth_mhz < 2.0) return 6;
+    if (bandwidth_mhz < 4.0) return 15;
+    if (bandwidth_mhz < 7.5) return 25;
+    if (bandwidth_mhz < 12.5) return 50;
+    if (bandwidth_mhz < 17.5) return 75;
+    return 100;
+}
+
+void LTENetwork::configure_carriers(const std::vector<ComponentCarrier>& new_carriers) {
+    carriers.clear();
+    nr_mode = false;
+    nr_numerology = 0;
+    csi_report_period = 1;
+    downlink_tti_ms = 1.0;
+    for (size_t i = 0; i < new_carriers.size(); i++) {
+        ComponentCarrier carrier = new_carriers[i];
+        carrier.carrier_id = static_cast<int>(i);
+        carrier.numerology = 0;
+        if (carrier.num_rbs <= 0) {
+            carrier.num_rbs = rbs_for_bandwidth(carrier.bandwidth_mhz);
+        }
+        carriers.push_back(carrier);
+    }
+    build_carrier_grids();
+}
+
+std::vector<ComponentCarrier> LTENetwork::get_carriers() const {
+    return carriers;
+}
+
+void LTENetwork::build_carrier_grids() {
+    if (carriers.empty()) {
+        // Single 20 MHz carrier at 2100 MHz, the historical default
+        ComponentCarrier carrier;
+        carrier.carrier_id = 0;
+        carrier.frequency_mhz = 2100.0;
+        carrier.bandwidth_mhz = 20.0;
+        carrier.num_rbs = 100;
+        carrier.numerology = 0;
+        carriers.push_back(carrier);
+    }
+
+    carrier_grids.clear();
+    for (const auto& carrier : carriers) {
+        CarrierResourceGrid grid;
+        grid.carrier = carrier;
+        grid.num_cells = static_cast<int>(cells.size());
+        grid.rb_owner.assign(static_cast<size_t>(grid.num_cells) * carrier.num_rbs, -1);
+        grid.cell_activity.assign(grid.num_cells, 1.0);
+        for (int i = 0; i < grid.num_cells; i++) {
+            if (!cell_on_carrier(i, carrier_grids.size())) grid.cell_activity[i] = 0.0;
+        }
+        grid.external_activity.assign(grid.num_cells, 0);
+        grid.user_first_rb.assign(users.size(), 0);
+        grid.user_num_rbs.assign(users.size(), 0);
+        grid.user_cqi.assign(users.size(), 0);
+        carrier_grids.push_back(grid);
+    }
+    apply_reported_loads();
+    carrier_user_throughput.assign(carriers.size() * users.size(), 0.0);
+    carrier_sinr_cache.clear();
+}
+
+void LTENetwork::set_carrier_scheduling_parameters(int pdcch_grants, bool parallel) {
+    pdcch_grants_per_carrier = std::max(pdcch_grants, 1);
+    parallel_carrier_scheduling = parallel;
+}
+
+void LTENetwork::set_cell_carriers(const std::vector<int>& carrier_per_cell) {
+    cell_carrier = carrier_per_cell;
+    build_carrier_grids();
+}
+
+std::vector<int> LTENetwork::get_cell_carriers() const {
+    return cell_carrier;
+}
+
+bool LTENetwork::cell_on_carrier(size_t cell_index, size_t carrier_index) const {
+    // Cells without a valid single-carrier entry transmit on every carrier
+    if (cell_index >= cell_carrier.size()) return true;
+    int carrier = cell_carrier[cell_index];
+    if (carrier < 0 || carrier >= static_cast<int>(carriers.size())) return true;
+    return static_cast<size_t>(carrier) == carrier_index;
+}
+
+size_t LTENetwork::primary_carrier_index(const UserEquipment& user, int cell_index) const {
+    // Only carriers the serving cell transmits on; a single-carrier cell
+    // anchors the UE on its own carrier
+    size_t primary = static_cast<size_t>(std::abs(user.primary_carrier)) % carriers.size();
+    if (!cell_on_carrier(cell_index, primary)) primary = cell_carrier[cell_index];
+    return primary;
+}
+
+bool LTENetwork::carrier_grids_stale() const {
+    return carrier_grids.size() != carriers.size() || carriers.empty() ||
+           (!carrier_grids.empty() && carrier_grids[0].num_cells != static_cast<int>(cells.size()));
+}
+
+void LTENetwork::carrier_aggregation_scheduler() {
+    if (carrier_grids_stale()) {
+        build_carrier_grids();
+    }
+
+    size_t num_carriers = carriers.size();
+    size_t num_users = users.size();
+    carrier_user_throughput.assign(num_carriers * num_users, 0.0);
+
+    // Cross-carrier scheduling: every DL assignment, whatever carrier it
+    // lands on, uses a PDCCH candidate on the UE's primary carrier, so the
+    // control budget is settled serially before the per-carrier schedulers
+    // run. Each grid's eligible_users holds the user indices admitted to it.
+    for (auto& grid : carrier_grids) {
+        grid.eligible_users.clear();
+    }
+    pdcch_budget.assign(cells.size() * num_carriers, pdcch_grants_per_carrier);
+    pdcch_queues.resize(cells.size() * num_carriers);
+    for (auto& queue : pdcch_queues) {
+        queue.clear();
+    }
+    scheduler_olla_offsets.assign(num_users, 0.0);
+
+    for (size_t u = 0; u < num_users; u++) {
+        const UserEquipment& user = users[u];
+        scheduler_olla_offsets[u] = get_olla_offset(user.ue_id);
+        if (user.state != LTEState::CONNECTED) continue;
+        int cell = find_cell_index(user.serving_cell);
+        if (cell < 0) continue;
+
+        size_t primary = primary_carrier_index(user, cell);
+
+        // PF metric from the last CSI on the primary carrier over the UE's
+        // average rate, which decays while it goes without a grant. UEs last
+        // reported out of range by this cell only get grants left over; UEs
+        // with no report from it yet rank at the top CQI so they get measured.
+        int cqi = link_abstraction.get_max_cqi();
+        if (carrier_sinr_cache.size() == num_carriers * num_users && csi_serving_cell.size() == num_users &&
+            csi_serving_cell[u] == user.serving_cell) {
+            cqi = link_abstraction.select_cqi(carrier_sinr_cache[primary * num_users + u] - scheduler_olla_offsets[u]);
+        }
+        double metric = link_abstraction.get_spectral_efficiency(cqi) / std::max(user.average_throughput, 1e-6);
+        pdcch_queues[cell * num_carriers + primary].push_back({metric, static_cast<int>(u)});
+    }
+
+    // Each cell spends its grants on its best-ranked candidates
+    for (size_t q = 0; q < pdcch_queues.size(); q++) {
+        auto& queue = pdcch_queues[q];
+        if (queue.empty()) continue;
+        std::sort(queue.begin(), queue.end(), std::greater<std::pair<double, int>>());
+        size_t cell = q / num_carriers;
+        size_t primary = q % num_carriers;
+        int& budget = pdcch_budget[q];
+        for (size_t rank = 0; rank < queue.size() && budget > 0; rank++) {
+            int u = queue[rank].second;
+            int configured = std::min(std::max(users[u].max_component_carriers, 1), static_cast<int>(num_carriers));
+            if (nr_mode) configured = 1;  // One active bandwidth part
+            int added = 0;
+            for (size_t k = 0; k < num_carriers && added < configured && budget > 0; k++) {
+                size_t c = (primary + k) % num_carriers;
+                if (!cell_on_carrier(cell, c)) continue;
+                carrier_grids[c].eligible_users.push_back(u);
+                budget--;
+                added++;
+            }
+        }
+    }
+    
+    // Channel state is re-measured at each CSI report, and for UEs whose
+    // serving cell changed since their last one
+    bool report_due = step_count % csi_report_period == 0;
+    if (carrier_sinr_cache.size() != num_carriers * num_users || csi_serving_cell.size() != num_users) {
+        carrier_sinr_cache.assign(num_carriers * num_users, 0.0);
+        csi_serving_cell.assign(num_users, -1);
+        report_due = true;
+    }
+    csi_refresh.assign(num_users, 0);
+    for (size_t u = 0; u < num_users; u++) {
+        if (report_due || csi_serving_cell[u] != users[u].serving_cell) {
+            csi_refresh[u] = 1;
+        }
+    }
+    
+    // Per-carrier schedulers touch only their own grid and their own slice
+    // of carrier_user_throughput / carrier_bler, so they run in parallel
+    carrier_bler.assign(num_carriers * num_users, 0.0);
+    refresh_received_power();
+    if (parallel_carrier_scheduling && num_carriers > 1) {
+        std::function<void(size_t)> task = [this](size_t c) { schedule_carrier(c); };
+        carrier_workers.run(num_carriers, task);
+    } else {
+        for (size_t c = 0; c < num_carriers; c++) {
+            schedule_carrier(c);
+        }
+    }
+
+    // Only admitted UEs were measured, so only they have CSI from this cell
+    for (const auto& grid : carrier_grids) {
+        for (int u : grid.eligible_users) {
+            csi_serving_cell[u] = users[u].serving_cell;
+        }
+    }
+
+    // Cell activity over the cell's carriers, weighted by carrier size
+    apply_reported_loads();
+    for (size_t i = 0; i < cells.size(); i++) {
+        double used_rbs = 0.0, total_rbs = 0.0;
+        for (size_t c = 0; c < num_carriers; c++) {
+            if (!cell_on_carrier(i, c)) continue;
+            const CarrierResourceGrid& grid = carrier_grids[c];
+            used_rbs += grid.cell_activity[i] * grid.carrier.num_rbs;
+            total_rbs += grid.carrier.num_rbs;
+        }
+        set_cell_activity(i, total_rbs > 0.0 ? used_rbs / total_rbs : 0.0);
+    }
+
+    // Aggregate across carriers and drive the outer loop with the mean BLER
+    // of the carriers each UE was scheduled on
+    for (size_t u = 0; u < num_users; u++) {
+        UserEquipment& user = users[u];
+        user.allocated_rbs.clear();
+        if (user.state != LTEState::CONNECTED) {
+            user.current_throughput = 0.0;  // Idle or detached UEs carry no traffic
+            continue;
+        }
+
+        double total = 0.0, bler_sum = 0.0;
+        int scheduled = 0;
+        for (size_t c = 0; c < num_carriers; c++) {
+            double throughput = carrier_user_throughput[c * num_users + u];
+            total += throughput;
+            if (throughput > 0.0) {
+                bler_sum += carrier_bler[c * num_users + u];
+                scheduled++;
+            }
+            append_allocated_rbs(user, c, u);
+        }
+        user.current_throughput = total;
+        user.average_throughput += 0.05 * (total - user.average_throughput);  // ~20 TTI window
+
+        if (scheduled > 0) {
+            double& offset = user_olla_offsets[user.ue_id];
+            offset += olla_step_db * (bler_sum / scheduled - olla_target_bler) / (1.0 - olla_target_bler);
+            offset = std::max(-10.0, std::min(offset, 10.0));
+        }
+    }
+}
+
+void LTENetwork::schedule_carrier(size_t carrier_index) {
+    CarrierResourceGrid& grid = carrier_grids[carrier_index];
+    const ComponentCarrier& carrier = grid.carrier;
+    size_t num_users = users.size();
+    std::fill(grid.rb_owner.begin(), grid.rb_owner.end(), -1);
+    grid.user_first_rb.assign(num_users, 0);
+    grid.user_num_rbs.assign(num_users, 0);
+    grid.user_cqi.assign(num_users, 0);
+    grid.user_sinr.assign(num_users, 0.0);
+
+    // Group the admitted users by serving cell
+    grid.cell_queues.resize(grid.num_cells);
+    for (auto& queue : grid.cell_queues) {
+        queue.clear();
+    }
+    std::vector<std::vector<std::pair<double, int>>>& cell_queues = grid.cell_queues;
+    std::vector<double>& user_sinr = grid.user_sinr;
+    std::vector<int32_t>& user_cqi = grid.user_cqi;
+    update_interference_sums(grid);
+    for (int u : grid.eligible_users) {
+        const UserEquipment& user = users[u];
+        int index = find_cell_index(user.serving_cell);
+        if (index < 0) continue;
+
+        // Proportional fair metric on this carrier's own SINR, with the
+        // interferers' activity on this carrier as of the last CSI report
+        double& sinr = carrier_sinr_cache[carrier_index * num_users + u];
+        if (csi_refresh[u]) {
+            sinr = carrier_sinr(grid, u, index);
+        }
+        int cqi = link_abstraction.select_cqi(sinr - scheduler_olla_offsets[u]);
+        if (cqi == 0) continue;  // Out of range on this carrier
+        user_sinr[u] = sinr;
+        user_cqi[u] = cqi;
+        double rate = link_abstraction.get_spectral_efficiency(cqi);
+        double metric = rate / std::max(user.average_throughput, 1e-6);
+        cell_queues[index].push_back({metric, u});
+    }
+
+    // 12 x 14 REs per RB per TTI/slot; NR slots are 2^mu per millisecond
+    double data_res_per_rb = 168.0 * (1.0 - control_overhead);
+    double slots_per_ms = static_cast<double>(1 << carrier.numerology);
+    for (int cell = 0; cell < grid.num_cells; cell++) {
+        // Cells scheduled elsewhere keep the activity they were given, and
+        // UEs still in transit to them get no allocation here
+        if (grid.external_activity[cell]) continue;
+        auto& queue = cell_queues[cell];
+        grid.cell_activity[cell] = 0.0;
+        if (queue.empty() || !cell_on_carrier(cell, carrier_index)) continue;
+        std::sort(queue.begin(), queue.end(), std::greater<std::pair<double, int>>());
+
+        // Equal share of the carrier, remainder to the best PF metrics
+        int share = carrier.num_rbs / static_cast<int>(queue.size());
+        int remainder = carrier.num_rbs % static_cast<int>(queue.size());
+        int next_rb = 0;
+        int32_t* owners = &grid.rb_owner[static_cast<size_t>(cell) * carrier.num_rbs];
+
+        for (size_t rank = 0; rank < queue.size(); rank++) {
+            int u = queue[rank].second;
+            int num_rbs = share + (static_cast<int>(rank) < remainder ? 1 : 0);
+            int cqi = user_cqi[u];
+            if (num_rbs == 0) continue;
+
+            for (int rb = 0; rb < num_rbs; rb++) {
+                owners[next_rb + rb] = users[u].ue_id;
+            }
+            grid.user_first_rb[u] = next_rb;
+            grid.user_num_rbs[u] = num_rbs;
+            next_rb += num_rbs;
+            grid.cell_activity[cell] += static_cast<double>(num_rbs) / carrier.num_rbs;
+
+            double bler = link_abstraction.lookup_bler(user_sinr[u], cqi);
+            double bits_per_tti = link_abstraction.get_spectral_efficiency(cqi) * data_res_per_rb * num_rbs;
+            carrier_user_throughput[carrier_index * num_users + u] = bits_per_tti * slots_per_ms * (1.0 - bler) / 1000.0;
+            carrier_bler[carrier_index * num_users + u] = bler;
+        }
+    }
+}
+
+void LTENetwork::append_allocated_rbs(UserEquipment& user, size_t carrier_index, size_t user_index) {
+    const CarrierResourceGrid& grid = carrier_grids[carrier_index];
+    int num_rbs = grid.user_num_rbs[user_index];
+    if (num_rbs == 0) return;
+
+    // Mirror the grid into the UE's RB list so per-UE link adaptation
+    // queries see this TTI's allocation; the CQI reported is the one of the
+    // lowest carrier the UE was scheduled on
+    const ComponentCarrier& carrier = grid.carrier;
+    int cell = find_cell_index(user.serving_cell);
+    double rb_mhz = 0.18 * (1 << carrier.numerology);
+    if (user.allocated_rbs.empty()) {
+        user_cqi_values[user.ue_id] = grid.user_cqi[user_index];
+    }
+    for (int rb = grid.user_first_rb[user_index]; rb < grid.user_first_rb[user_index] + num_rbs; rb++) {
+        ResourceBlock block;
+        block.rb_id = cell * carrier.num_rbs + rb;
+        block.type = ResourceBlockType::DOWNLINK;
+        block.allocated = true;
+        block.user_id = user.ue_id;
+        block.frequency = carrier.frequency_mhz + (rb - carrier.num_rbs / 2.0) * rb_mhz;
+        block.bandwidth = 180 << carrier.numerology;
+        block.allocation_time = step_count;
+        user.allocated_rbs.push_back(block);
+    }
+}
+
+double LTENetwork::get_carrier_cell_activity(size_t carrier_index, int cell_id) const {
+    int index = find_cell_index(cell_id);
+    if (carrier_index >= carrier_grids.size() || index < 0 ||
+        index >= carrier_grids[carrier_index].num_cells) {
+        return 0.0;
+    }
+    return carrier_grids[carrier_index].cell_activity[index];
+}
+
+void LTENetwork::set_external_cell_activity(size_t carrier_index, int cell_id, double activity) {
+    // The cell stops being scheduled here; its activity on this carrier is
+    // whatever the owner reports, e.g. another region of a partitioned run
+    if (carrier_grids_stale()) {
+        build_carrier_grids();
+    }
+    int index = find_cell_index(cell_id);
+    if (carrier_index >= carrier_grids.size() || index < 0) return;
+    CarrierResourceGrid& grid = carrier_grids[carrier_index];
+    grid.external_activity[index] = 1;
+    grid.cell_activity[index] = std::max(0.0, std::min(activity, 1.0));
+}
+
+CarrierWorkerPool::CarrierWorkerPool() {
+    task = nullptr;
+    task_count = 0;
+    next_task.store(0);
+    finished_workers = 0;
+    generation = 0;
+    stopping = false;
+}
+
+CarrierWorkerPool::CarrierWorkerPool(const CarrierWorkerPool&) : CarrierWorkerPool() {}
+
+CarrierWorkerPool& CarrierWorkerPool::operator=(const CarrierWorkerPool&) {
+    // Threads belong to the network that started them
+    return *this;
+}
+
+CarrierWorkerPool::~CarrierWorkerPool() {
+    stop();
+}
+
+size_t CarrierWorkerPool::size() const {
+    return threads.size();
+}
+
+void CarrierWorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& thread : threads) thread.join();
+    threads.clear();
+    stopping = false;
+}
+
+void CarrierWorkerPool::run_tasks() {
+    for (size_t i = next_task.fetch_add(1); i < task_count; i = next_task.fetch_add(1)) {
+        (*task)(i);
+    }
+}
+
+void CarrierWorkerPool::worker_loop(uint64_t seen) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_ready.wait(lock, [this, seen]() { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+
+        lock.unlock();
+        run_tasks();
+        lock.lock();
+        if (++finished_workers == threads.size()) {
+            work_done.notify_one();
+        }
+    }
+}
+
+void CarrierWorkerPool::run(size_t count, const std::function<void(size_t)>& work) {
+    if (count == 0) return;
+    while (threads.size() + 1 < count) {
+        // Started at the current generation, so the worker joins this run
+        threads.push_back(std::thread(&CarrierWorkerPool::worker_loop, this, generation));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &work;
+        task_count = count;
+        next_task.store(0);
+        finished_workers = 0;
+        generation++;
+    }
+    work_ready.notify_all();
+    run_tasks();
+
+    // Every worker checks in, even those that found no task left, so none
+    // can still be reading this call's task once run() returns
+    std::unique_lock<std::mutex> lock(mutex);
+    work_done.wait(lock, [this]() { return finished_workers == threads.size(); });
+    task = nullptr;
+}
+
+std::vector<double> LTENetwork::get_user_carrier_throughput(int ue_id) const {
+    std::vector<double> per_carrier(carriers.size(), 0.0);
+    size_t num_users = users.size();
+    if (carrier_user_throughput.size() != carriers.size() * num_users) return per_carrier;
+
+    for (size_t u = 0; u < num_users; u++) {
+        if (users[u].ue_id == ue_id) {
+            for (size_t c = 0; c < carriers.size(); c++) {
+                per_carrier[c] = carrier_user_throughput[c * num_users + u];
+            }
+            break;
+        }
+    }
+    return per_carrier;
+}
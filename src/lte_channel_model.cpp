@@ -0,0 +1,302 @@
+#include "lte_network.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+bool same_cell_geometry(const CellInfo& a, const CellInfo& b) {
+    return a.cell_id == b.cell_id && a.latitude == b.latitude && a.longitude == b.longitude &&
+           a.sectorized == b.sectorized && a.azimuth == b.azimuth && a.downtilt == b.downtilt &&
+           a.antenna_height == b.antenna_height;
+}
+
+} // namespace
+
+double LTENetwork::calculate_rsrp_at(double x, double y, const CellInfo& cell) const {
+    // The path loss model is calibrated at 2 GHz
+    return calculate_rsrp_at(x, y, cell, 2000.0);
+}
+
+double LTENetwork::calculate_rsrp_at(double x, double y, const CellInfo& cell, double frequency_mhz) const {
+    // Calculate distance
+    double distance = std::sqrt(std::pow(x - cell.longitude, 2) +
+                               std::pow(y - cell.latitude, 2));
+
+    // Path loss model: PL = 128.1 + 37.6*log10(distance_km)
+    double path_loss = 128.1 + 37.6 * std::log10(std::max(distance / 1000.0, 0.001));
+
+    // Carrier frequency correction relative to the 2 GHz calibration
+    path_loss += 20.0 * std::log10(frequency_mhz / 2000.0);
+
+    // RSRP = Tx_Power - Path_Loss + Antenna_Gain - Shadowing
+    double tx_power = 46.0;  // dBm (typical for macro cell)
+    double antenna_gain = antenna_pattern.get_max_gain(); // dBi (omni)
+    if (cell.sectorized) {
+        antenna_gain = antenna_pattern.gain_towards(x - cell.longitude, y - cell.latitude,
+                                                    cell.antenna_height, cell.azimuth, cell.downtilt);
+    }
+    double shadowing = 0.0;  // Simplified - no shadowing
+
+    double rsrp = tx_power - path_loss + antenna_gain - shadowing;
+
+    return rsrp;
+}
+
+void LTENetwork::calculate_rsrp_batch(const double* x, const double* y, size_t count, const CellInfo& cell,
+                                      double frequency_mhz, double* rsrp_out) const {
+    // Same model as calculate_rsrp_at, written over squared distance so the
+    // loop has no sqrt: 37.6*log10(d_km) = 18.8*log10(d_m^2) - 112.8
+    double constant = 46.0 - (128.1 - 112.8) - 20.0 * std::log10(frequency_mhz / 2000.0);
+    for (size_t i = 0; i < count; i++) {
+        double dx = x[i] - cell.longitude;
+        double dy = y[i] - cell.latitude;
+        double distance_sq = std::max(dx * dx + dy * dy, 1.0);
+        rsrp_out[i] = constant - 18.8 * std::log10(distance_sq);
+    }
+
+    double antenna_gain = antenna_pattern.get_max_gain();
+    if (!cell.sectorized) {
+        for (size_t i = 0; i < count; i++) {
+            rsrp_out[i] += antenna_gain;
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        rsrp_out[i] += antenna_pattern.gain_towards(x[i] - cell.longitude, y[i] - cell.latitude,
+                                                    cell.antenna_height, cell.azimuth, cell.downtilt);
+    }
+}
+
+double LTENetwork::calculate_sinr_at(double x, double y, int cell_id) const {
+    return calculate_sinr_at(x, y, cell_id, 2000.0);
+}
+
+double LTENetwork::calculate_sinr_at(double x, double y, int cell_id, double frequency_mhz) const {
+    return calculate_sinr_at(x, y, cell_id, frequency_mhz, cell_activity);
+}
+
+double LTENetwork::calculate_sinr_at(double x, double y, int cell_id, double frequency_mhz,
+                                     const std::vector<double>& activity) const {
+    // Single pass over the cells: the serving cell is the signal, every
+    // other cell interferes in proportion to the RBs it transmits on
+    double signal_rsrp = -200.0;
+    double total_interference_noise = 0.0;
+
+    for (size_t i = 0; i < cells.size(); i++) {
+        const CellInfo& cell = cells[i];
+        if (cell.cell_id == cell_id) {
+            signal_rsrp = calculate_rsrp_at(x, y, cell, frequency_mhz);
+            continue;
+        }
+        double weight = (load_weighted_interference && i < activity.size()) ? activity[i] : 1.0;
+        if (weight <= 0.0) continue;
+        double rsrp = calculate_rsrp_at(x, y, cell, frequency_mhz);
+        total_interference_noise += weight * std::pow(10.0, rsrp / 10.0);
+    }
+
+    // Add thermal noise
+    double noise_power = -104.0; // dBm
+    total_interference_noise += std::pow(10.0, noise_power / 10.0);
+
+    // SINR = Signal / (Interference + Noise)
+    return signal_rsrp - 10.0 * std::log10(total_interference_noise);
+}
+
+void LTENetwork::refresh_received_power() {
+    size_t num_cells = cells.size();
+    size_t num_users = users.size();
+    bool layout_changed = rx_cells.size() != num_cells;
+    for (size_t c = 0; c < num_cells && !layout_changed; c++) {
+        layout_changed = !same_cell_geometry(rx_cells[c], cells[c]);
+    }
+    if (layout_changed) {
+        rx_cells = cells;
+        rx_ue_ids.clear();
+    }
+    rx_power_mw.resize(num_users * num_cells);
+    rx_position.resize(2 * num_users);
+    rx_ue_ids.resize(num_users, -1);
+    rx_changed.assign(num_users, 0);
+
+    for (size_t u = 0; u < num_users; u++) {
+        const UserEquipment& user = users[u];
+        if (rx_ue_ids[u] == user.ue_id && rx_position[2 * u] == user.x_position &&
+            rx_position[2 * u + 1] == user.y_position) continue;
+        double* row = &rx_power_mw[u * num_cells];
+        for (size_t c = 0; c < num_cells; c++) {
+            row[c] = std::pow(10.0, calculate_rsrp_at(user.x_position, user.y_position, cells[c]) / 10.0);
+        }
+        rx_ue_ids[u] = user.ue_id;
+        rx_position[2 * u] = user.x_position;
+        rx_position[2 * u + 1] = user.y_position;
+        rx_changed[u] = 1;
+    }
+}
+
+void LTENetwork::update_interference_sums(CarrierResourceGrid& grid) {
+    size_t num_cells = cells.size();
+    size_t num_users = users.size();
+    bool rebuild = grid.applied_activity.size() != num_cells || grid.interference_mw.size() != num_users;
+    if (rebuild) {
+        grid.applied_activity.assign(num_cells, 0.0);
+        grid.interference_mw.assign(num_users, 0.0);
+    }
+
+    // A cell whose activity moved adds the change times its power to every
+    // UE's sum; at steady load nothing moves and this is free
+    std::vector<std::pair<int, double>>& changes = grid.activity_changes;
+    changes.clear();
+    for (size_t c = 0; c < num_cells; c++) {
+        double activity = load_weighted_interference ? grid.cell_activity[c] : 1.0;
+        double delta = activity - grid.applied_activity[c];
+        if (delta == 0.0) continue;
+        grid.applied_activity[c] = activity;
+        changes.push_back({static_cast<int>(c), delta});
+    }
+    if (!rebuild && !changes.empty()) {
+        for (size_t u = 0; u < num_users; u++) {
+            const double* row = &rx_power_mw[u * num_cells];
+            double sum = 0.0;
+            for (const auto& change : changes) {
+                sum += change.second * row[change.first];
+            }
+            grid.interference_mw[u] += sum;
+        }
+    }
+
+    // UEs with a new row start over from the full sum
+    for (size_t u = 0; u < num_users; u++) {
+        if (!rebuild && !rx_changed[u]) continue;
+        const double* row = &rx_power_mw[u * num_cells];
+        double sum = 0.0;
+        for (size_t c = 0; c < num_cells; c++) {
+            sum += grid.applied_activity[c] * row[c];
+        }
+        grid.interference_mw[u] = sum;
+    }
+}
+
+double LTENetwork::carrier_sinr(const CarrierResourceGrid& grid, size_t user_index, int cell_index) const {
+    // The model of calculate_sinr_at; its frequency correction scales every
+    // cell alike, so the 2 GHz sums serve every carrier
+    double signal = rx_power_mw[user_index * cells.size() + cell_index];
+    double interference = grid.interference_mw[user_index] - grid.applied_activity[cell_index] * signal;
+    double scale = std::pow(2000.0 / grid.carrier.frequency_mhz, 2);
+    double noise = std::pow(10.0, -104.0 / 10.0);
+    return 10.0 * std::log10(scale * signal) - 10.0 * std::log10(scale * std::max(interference, 0.0) + noise);
+}
+
+bool LTENetwork::interference_sums_current() const {
+    // The scheduler's rows and sums match the current users and cells
+    if (carrier_grids_stale() || rx_ue_ids.size() != users.size() || rx_cells.size() != cells.size()) return false;
+    for (size_t c = 0; c < cells.size(); c++) {
+        if (!same_cell_geometry(rx_cells[c], cells[c])) return false;
+    }
+    for (const auto& grid : carrier_grids) {
+        if (grid.interference_mw.size() != users.size() || grid.applied_activity.size() != cells.size()) return false;
+    }
+    return true;
+}
+
+double LTENetwork::primary_carrier_sinr(size_t user_index, bool sums_current) const {
+    // From the scheduler's sums; UEs moved since it ran are measured directly
+    const UserEquipment& user = users[user_index];
+    int cell = find_cell_index(user.serving_cell);
+    if (cell < 0 || carrier_grids_stale()) {
+        return calculate_sinr_at(user.x_position, user.y_position, user.serving_cell);
+    }
+    const CarrierResourceGrid& grid = carrier_grids[primary_carrier_index(user, cell)];
+    if (sums_current && rx_ue_ids[user_index] == user.ue_id && rx_position[2 * user_index] == user.x_position &&
+        rx_position[2 * user_index + 1] == user.y_position) {
+        return carrier_sinr(grid, user_index, cell);
+    }
+    return calculate_sinr_at(user.x_position, user.y_position, user.serving_cell, grid.carrier.frequency_mhz,
+                             grid.cell_activity);
+}
+
+double LTENetwork::calculate_rsrp(int ue_id, int cell_id) {
+    UserEquipment user = get_user_info(ue_id);
+    CellInfo cell = get_cell_info(cell_id);
+
+    return calculate_rsrp_at(user.x_position, user.y_position, cell);
+}
+
+double LTENetwork::calculate_rsrq(int ue_id, int cell_id) {
+    double rsrp = calculate_rsrp(ue_id, cell_id);
+
+    // Calculate interference from other cells, weighted by their activity
+    double total_interference = 0.0;
+    for (const auto& cell : cells) {
+        if (cell.cell_id != cell_id) {
+            double interference_rsrp = calculate_rsrp(ue_id, cell.cell_id);
+            total_interference += get_cell_activity(cell.cell_id) * std::pow(10.0, interference_rsrp / 10.0);
+        }
+    }
+
+    // RSRQ = RSRP / (RSSI), where RSSI includes signal + interference + noise
+    double noise_power = -104.0; // dBm (thermal noise)
+    double rssi = 10.0 * std::log10(std::pow(10.0, rsrp / 10.0) + total_interference +
+                                   std::pow(10.0, noise_power / 10.0));
+
+    double rsrq = rsrp - rssi;
+
+    return rsrq;
+}
+
+double LTENetwork::calculate_sinr(int ue_id, int cell_id) {
+    UserEquipment user = get_user_info(ue_id);
+
+    return calculate_sinr_at(user.x_position, user.y_position, cell_id);
+}
+
+int LTENetwork::find_cell_index(int cell_id) const {
+    // Cell IDs usually equal their index
+    if (cell_id >= 0 && cell_id < static_cast<int>(cells.size()) && cells[cell_id].cell_id == cell_id) {
+        return cell_id;
+    }
+    for (size_t i = 0; i < cells.size(); i++) {
+        if (cells[i].cell_id == cell_id) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void LTENetwork::set_cell_activity(size_t index, double activity) {
+    if (index >= cells.size()) return;
+    if (cell_activity.size() < cells.size()) {
+        cell_activity.resize(cells.size(), 1.0);
+    }
+    cell_activity[index] = std::min(std::max(activity, 0.0), 1.0);
+    cells[index].load_percentage = static_cast<int>(std::round(cell_activity[index] * 100.0));
+}
+
+void LTENetwork::apply_reported_loads() {
+    // Cells scheduled elsewhere keep the activity they were given
+    for (size_t i = 0; i < reported_cell_load.size() && i < cells.size(); i++) {
+        if (reported_cell_load[i] < 0.0) continue;
+        for (size_t c = 0; c < carrier_grids.size(); c++) {
+            CarrierResourceGrid& grid = carrier_grids[c];
+            if (i >= grid.cell_activity.size() || grid.external_activity[i] || !cell_on_carrier(i, c)) continue;
+            grid.cell_activity[i] = reported_cell_load[i];
+        }
+    }
+}
+
+double LTENetwork::get_cell_activity(int cell_id) const {
+    if (!load_weighted_interference) return 1.0;
+    int index = find_cell_index(cell_id);
+    if (index < 0 || index >= static_cast<int>(cell_activity.size())) return 1.0;
+    return cell_activity[index];
+}
+
+std::vector<double> LTENetwork::get_cell_activity_factors() const {
+    std::vector<double> factors(cells.size(), 1.0);
+    if (load_weighted_interference) {
+        std::copy(cell_activity.begin(), cell_activity.begin() + std::min(cell_activity.size(), factors.size()),
+                  factors.begin());
+    }
+    return factors;
+}
+
+void LTENetwork::set_load_weighted_interference(bool enabled) {
+    load_weighted_interference = enabled;
+}
@@ -0,0 +1,97 @@
+#include "lte_network.h"
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+const std::vector<double>& LTENetwork::calculate_rb_sinrs(int ue_id) {
+    rb_sinr_scratch.clear();
+    for (const auto& user : users) {
+        if (user.ue_id != ue_id) continue;
+        if (user.allocated_rbs.empty()) break;
+
+        // The propagation model is frequency-flat, so every allocated RB sees the
+        // wideband SINR; EESM still applies unchanged to frequency-selective input
+        double sinr = calculate_sinr_at(user.x_position, user.y_position, user.serving_cell);
+        rb_sinr_scratch.assign(user.allocated_rbs.size(), sinr);
+        break;
+    }
+    return rb_sinr_scratch;
+}
+
+double LTENetwork::calculate_effective_sinr(int ue_id, int cqi) {
+    const std::vector<double>& rb_sinrs = calculate_rb_sinrs(ue_id);
+    if (rb_sinrs.empty()) return -100.0;
+    return link_abstraction.effective_sinr_eesm(rb_sinrs, cqi);
+}
+
+int LTENetwork::select_user_cqi(int ue_id) {
+    const std::vector<double>& rb_sinrs = calculate_rb_sinrs(ue_id);
+    if (rb_sinrs.empty()) return 0;
+    return select_rb_cqi(ue_id, rb_sinrs);
+}
+
+int LTENetwork::select_rb_cqi(int ue_id, const std::vector<double>& rb_sinrs) {
+    // Pick the EESM beta from the wideband CQI, then map the effective SINR
+    // (corrected by the outer loop) back to a CQI
+    double mean_sinr = std::accumulate(rb_sinrs.begin(), rb_sinrs.end(), 0.0) / rb_sinrs.size();
+    int wideband_cqi = link_abstraction.select_cqi(mean_sinr);
+    double effective_sinr = link_abstraction.effective_sinr_eesm(rb_sinrs, wideband_cqi);
+
+    int cqi = link_abstraction.select_cqi(effective_sinr - get_olla_offset(ue_id));
+    user_cqi_values[ue_id] = cqi;
+    return cqi;
+}
+
+double LTENetwork::calculate_user_throughput(int ue_id) {
+    // One SINR evaluation per call: CQI and BLER both come from this allocation
+    const std::vector<double>& rb_sinrs = calculate_rb_sinrs(ue_id);
+    if (rb_sinrs.empty()) return 0.0;
+    int cqi = select_rb_cqi(ue_id, rb_sinrs);
+    if (cqi == 0) return 0.0;
+
+    double bler = link_abstraction.lookup_bler(link_abstraction.effective_sinr_eesm(rb_sinrs, cqi), cqi);
+
+    // 12 subcarriers x 14 symbols per RB per TTI/slot, minus control/RS overhead
+    double data_res_per_rb = 168.0 * (1.0 - control_overhead);
+    double slots_per_ms = nr_mode ? static_cast<double>(1 << nr_numerology) : 1.0;
+    double bits_per_tti = link_abstraction.get_spectral_efficiency(cqi) * data_res_per_rb * rb_sinrs.size();
+    return bits_per_tti * slots_per_ms * (1.0 - bler) / 1000.0;  // bits per ms -> Mbps
+}
+
+void LTENetwork::report_harq_feedback(int ue_id, bool ack) {
+    // OLLA: a NACK backs off by a full step, an ACK recovers by
+    // step * target / (1 - target), converging on the target BLER
+    double& offset = user_olla_offsets[ue_id];
+    if (ack) {
+        offset -= olla_step_db * olla_target_bler / (1.0 - olla_target_bler);
+    } else {
+        offset += olla_step_db;
+    }
+    offset = std::max(-10.0, std::min(offset, 10.0));
+}
+
+void LTENetwork::set_link_adaptation_parameters(double target_bler, double step_db) {
+    olla_target_bler = std::max(0.001, std::min(target_bler, 0.5));
+    olla_step_db = std::max(step_db, 0.0);
+}
+
+int LTENetwork::get_user_cqi(int ue_id) const {
+    auto it = user_cqi_values.find(ue_id);
+    return (it != user_cqi_values.end()) ? static_cast<int>(it->second) : 0;
+}
+
+double LTENetwork::get_olla_offset(int ue_id) const {
+    auto it = user_olla_offsets.find(ue_id);
+    return (it != user_olla_offsets.end()) ? it->second : 0.0;
+}
+
+void LTENetwork::set_user_link_state(int ue_id, int cqi, double olla_offset, double tpc_offset) {
+    // Restores the adaptation state of a UE handed over from another network
+    user_cqi_values[ue_id] = cqi;
+    user_olla_offsets[ue_id] = std::max(-10.0, std::min(olla_offset, 10.0));
+    user_tpc_offsets[ue_id] = tpc_offset;
+}
+
+const LinkAbstraction& LTENetwork::get_link_abstraction() const {
+    return link_abstraction;
+}
@@ -6,6 +6,18 @@
 #include <memory>
 #include <map>
 #include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "link_abstraction.h"
+#include "antenna_pattern.h"
+#include "rlc_buffer.h"
+#include "handover_signaling.h"
+
+class CellSpatialIndex;
 
 enum class LTEState {
     IDLE,
@@ -36,6 +48,10 @@ struct CellInfo {
     std::string technology;     // "LTE", "3G", "WiFi"
     double latitude;
     double longitude;
+    bool sectorized;            // false: omni antenna at constant max gain
+    double azimuth;             // degrees clockwise from north (+y)
+    double downtilt;            // degrees below horizontal
+    double antenna_height;      // m
 };
 
 struct ResourceBlock {
@@ -48,7 +64,99 @@ struct ResourceBlock {
     uint64_t allocation_time;
 };
 
+struct ComponentCarrier {
+    int carrier_id;
+    double frequency_mhz;       // DL centre frequency
+    double bandwidth_mhz;       // 1.4, 3, 5, 10, 15 or 20 (LTE), up to 400 (NR)
+    int num_rbs;
+    int numerology;             // NR mu, SCS = 15 * 2^mu kHz; 0 for LTE
+};
+
+// Resource grid of one component carrier across all cells, laid out
+// contiguously as [cell_index * num_rbs + rb] so each carrier's scheduler
+// owns one independent block of memory
+struct CarrierResourceGrid {
+    ComponentCarrier carrier;
+    int num_cells;
+    std::vector<int32_t> rb_owner;      // ue_id or -1
+    std::vector<double> cell_activity;  // Fraction of RBs in use per cell last TTI
+    std::vector<char> external_activity; // 1: cell scheduled elsewhere, activity set from outside
+    std::vector<int32_t> user_first_rb; // Per user index, last TTI
+    std::vector<int32_t> user_num_rbs;  // 0 if not scheduled on this carrier
+    std::vector<int32_t> user_cqi;
+
+    // Interference as incremental sums: each UE's activity-weighted power
+    // from every cell, moved by the change whenever a cell's activity moves
+    std::vector<double> applied_activity;   // Per cell, the weights interference_mw holds
+    std::vector<double> interference_mw;    // Per user index, at 2 GHz, serving cell included
+
+    // Scheduler scratch, reused every TTI
+    std::vector<int> eligible_users;                                // User indices admitted this TTI
+    std::vector<std::vector<std::pair<double, int>>> cell_queues;   // (PF metric, user index) per cell
+    std::vector<double> user_sinr;
+    std::vector<std::pair<int, double>> activity_changes;           // (cell, change) since the last sums
+};
+
+// Persistent threads for the per-carrier schedulers. run() executes
+// task(i) for every i < count on the calling thread and the workers and
+// returns once all are done. Workers start on first use and stay parked
+// between TTIs; copies start without threads, so a copied (or fork()ed)
+// network starts its own.
+class CarrierWorkerPool {
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    const std::function<void(size_t)>* task;
+    size_t task_count;
+    std::atomic<size_t> next_task;
+    size_t finished_workers;
+    uint64_t generation;
+    bool stopping;
+
+    void worker_loop(uint64_t seen);
+    void run_tasks();
+    void stop();
+
+public:
+    CarrierWorkerPool();
+    CarrierWorkerPool(const CarrierWorkerPool& other);
+    CarrierWorkerPool& operator=(const CarrierWorkerPool& other);
+    ~CarrierWorkerPool();
+
+    void run(size_t count, const std::function<void(size_t)>& task);
+    size_t size() const;
+};
+
+// Uplink power control, TS 36.213 5.1.1: PUSCH power per TTI is
+// min(p_max, p0 + 10log10(M) + alpha * PL + f) with f the accumulated TPC
+struct UplinkPowerControl {
+    double p0_nominal_dbm;      // Target received power per RB
+    double alpha;               // Fractional path loss compensation
+    double p_max_dbm;           // UE maximum transmit power
+    bool closed_loop;           // Accumulate TPC commands towards target_sinr_db
+    double target_sinr_db;
+    double tpc_step_db;
+    double tpc_max_db;          // Limit on the accumulated correction
+    double noise_figure_db;     // eNB receiver
+    int max_users_per_tti;      // PUSCH grants per cell per TTI
+};
+
+// One UE's uplink transmission in a TTI. Exported per UE, and accepted
+// for UEs simulated elsewhere (partition halo ghosts), which then add
+// interference at every cell other than their own
+struct UplinkTransmission {
+    double x_position;
+    double y_position;
+    int serving_cell;
+    int first_rb;
+    int num_rbs;                // 0: not scheduled
+    double tx_power_dbm;
+};
+
 struct HandoverEvent {
+    int ue_id;
     int source_cell;
     int target_cell;
     HandoverType type;
@@ -72,6 +180,78 @@ struct UserEquipment {
     double current_throughput;
     double battery_level;
     std::vector<CellInfo> neighbor_cells;
+    int primary_carrier;        // Index into the carrier list; carries PDCCH
+    int max_component_carriers; // CA capability (<= 0 treated as 1)
+    double average_throughput;  // Mbps, PF scheduler's moving average
+};
+
+// Flat per-UE and per-cell state, laid out for zero-copy export to numpy.
+// Arrays are rewritten in place by refresh_state_arrays() while the UE and
+// cell counts are unchanged; a count change allocates a fresh block so that
+// views into the previous one stay valid (but stale).
+struct LTEStateArrays {
+    uint64_t version;
+    std::vector<int32_t> ue_ids;
+    std::vector<double> ue_positions;      // x0, y0, x1, y1, ... (m)
+    std::vector<int32_t> ue_serving_cell;
+    std::vector<double> ue_throughput;     // Mbps
+    std::vector<double> ue_sinr;           // dB, on the primary carrier
+    std::vector<int32_t> ue_state;         // LTEState
+    std::vector<int32_t> cell_ids;
+    std::vector<int32_t> cell_load;        // percent
+};
+
+// Immutable copy of the network's public state as of one published epoch
+struct LTENetworkSnapshot {
+    uint64_t epoch;
+    uint64_t step;
+    uint64_t history_generation;        // Changes whenever the history is cleared
+    size_t history_open_from;           // Entries below this index were final when copied
+    std::vector<CellInfo> cells;
+    std::vector<UserEquipment> users;
+    std::vector<HandoverEvent> handover_history;
+};
+
+// Epoch-based RCU for LTENetworkSnapshot. The stepping thread fills a spare
+// buffer and swaps it in as the current snapshot; readers announce the
+// epoch they entered in a reader slot, so a replaced snapshot is recycled
+// as the next write buffer only once no reader can still hold it. Neither
+// side takes a lock, and the writer never waits for readers. A single
+// writer is assumed. Copies start empty so that copied networks publish
+// their own epochs.
+class NetworkSnapshotRCU {
+private:
+    static const int max_readers = 64;
+    struct ReaderSlot {
+        std::atomic<uint64_t> epoch;    // 0 while free
+        char padding[56];               // One slot per cache line
+    };
+
+    mutable ReaderSlot reader_slots[max_readers];
+    std::atomic<LTENetworkSnapshot*> current;
+    std::atomic<uint64_t> epoch;
+
+    // Writer-only bookkeeping
+    std::vector<std::pair<uint64_t, LTENetworkSnapshot*>> retired;  // (retire epoch, snapshot)
+    std::vector<LTENetworkSnapshot*> spare;
+
+    void reclaim();
+    void release_all();
+
+public:
+    NetworkSnapshotRCU();
+    NetworkSnapshotRCU(const NetworkSnapshotRCU& other);
+    NetworkSnapshotRCU& operator=(const NetworkSnapshotRCU& other);
+    ~NetworkSnapshotRCU();
+
+    // Writer
+    LTENetworkSnapshot* acquire_write_buffer();
+    void publish(LTENetworkSnapshot* snapshot);
+
+    // Readers; the pointer stays valid until read_unlock(slot)
+    const LTENetworkSnapshot* read_lock(int& slot) const;
+    void read_unlock(int slot) const;
+    uint64_t get_epoch() const;
 };
 
 class LTENetwork {
@@ -93,12 +273,125 @@ private:
     std::map<int, std::vector<int>> user_rb_allocation;
     std::map<int, double> user_cqi_values;  // Channel Quality Indicator
     
+    // Link abstraction and outer-loop link adaptation
+    LinkAbstraction link_abstraction;
+    std::map<int, double> user_olla_offsets;  // dB subtracted from the SINR estimate
+    double olla_target_bler;
+    double olla_step_db;
+    double control_overhead;                  // Fraction of REs used by control/RS
+    std::vector<double> rb_sinr_scratch;      // Reused by calculate_rb_sinrs
+    int select_rb_cqi(int ue_id, const std::vector<double>& rb_sinrs);
+    
+    // Sector antenna pattern shared by all sectorized cells
+    AntennaPattern antenna_pattern;
+    
+    // Per-cell downlink activity (fraction of RBs in use), indexed like cells;
+    // cells with no allocation history count as fully loaded
+    std::vector<double> cell_activity;
+    std::vector<double> reported_cell_load;     // Overrides the scheduler's activity; -1: none
+    bool load_weighted_interference;
+    
+    // Linear RSRP at 2 GHz of every cell at each UE, [user_index * num_cells + cell],
+    // recomputed only for UEs that moved or changed and when a cell moves
+    std::vector<double> rx_power_mw;
+    std::vector<double> rx_position;              // x, y per user index
+    std::vector<int> rx_ue_ids;
+    std::vector<CellInfo> rx_cells;
+    std::vector<char> rx_changed;                 // Rows recomputed this TTI
+    
+    // Site index for measurements; with a radius set, UEs measure only the
+    // cells within it (plus their serving cell)
+    std::shared_ptr<const CellSpatialIndex> cell_site_index;
+    double measurement_radius;                    // m, 0 measures every cell
+    std::vector<int> measurement_candidates;
+    
+    // Component carriers and per-carrier resource grids
+    std::vector<ComponentCarrier> carriers;
+    std::vector<CarrierResourceGrid> carrier_grids;
+    std::vector<double> carrier_user_throughput;  // [carrier * num_users + user_index], Mbps
+    int pdcch_grants_per_carrier;                 // DL assignments per cell per scheduling carrier per TTI
+    bool parallel_carrier_scheduling;
+    CarrierWorkerPool carrier_workers;
+    std::vector<int> pdcch_budget;                // Scheduler scratch, reused every TTI
+    std::vector<std::vector<std::pair<double, int>>> pdcch_queues;  // (PF metric, user index) per budget
+    std::vector<double> scheduler_olla_offsets;
+    std::vector<char> csi_refresh;
+    std::vector<double> carrier_bler;             // [carrier * num_users + user_index]
+    std::vector<int> cell_carrier;                // Per cell index: its only carrier, or -1 for all
+    bool cell_on_carrier(size_t cell_index, size_t carrier_index) const;
+    
+    // NR mode: carriers are bandwidth parts, each step is one slot and
+    // per-UE SINR is only re-measured once per CSI report period
+    bool nr_mode;
+    int nr_numerology;
+    int csi_report_period;                        // Slots
+    std::vector<double> carrier_sinr_cache;       // [carrier * num_users + user_index], dB
+    std::vector<int> csi_serving_cell;            // Serving cell the cache was measured against
+    bool is_measurement_due() const;
+    
+    // Uplink, scheduled on the UPLINK half of the primary carrier's RBs
+    bool uplink_enabled;
+    UplinkPowerControl uplink_pc;
+    int uplink_rbs_per_cell;
+    std::vector<int32_t> uplink_rb_owner;         // [cell_index * uplink_rbs_per_cell + rb], ue_id or -1
+    std::vector<double> uplink_interference_mw;   // Same layout, received from other cells' UEs
+    std::vector<double> uplink_tx_power_dbm;      // Per user index, last TTI
+    std::vector<int> uplink_first_rb;
+    std::vector<double> uplink_sinr_db;
+    std::vector<int> uplink_num_rbs;
+    std::vector<double> uplink_user_throughput;   // Mbps
+    std::vector<double> uplink_average_throughput;
+    std::map<int, double> user_tpc_offsets;       // Accumulated closed-loop correction (dB)
+    std::vector<UplinkTransmission> external_uplink_transmissions;
+    
+    int find_cell_index(int cell_id) const;
+    bool carrier_grids_stale() const;
+    void set_cell_activity(size_t index, double activity);
+    void apply_reported_loads();
+    double calculate_sinr_at(double x, double y, int cell_id, double frequency_mhz,
+                             const std::vector<double>& activity) const;
+    void refresh_received_power();
+    void update_interference_sums(CarrierResourceGrid& grid);
+    double carrier_sinr(const CarrierResourceGrid& grid, size_t user_index, int cell_index) const;
+    bool interference_sums_current() const;
+    double primary_carrier_sinr(size_t user_index, bool sums_current) const;
+    size_t primary_carrier_index(const UserEquipment& user, int cell_index) const;
+    
     // Performance metrics
     std::vector<double> network_throughput_history;
     std::vector<double> handover_success_rate_history;
     std::vector<double> network_latency_history;
     std::vector<int> active_users_history;
     
+    // Exported state for the Python views
+    std::shared_ptr<LTEStateArrays> state_arrays;
+    
+    // Real-time degradation: 0 runs the full step, 1 skips KPI aggregation,
+    // 2 also updates idle UEs only every idle_update_stride steps
+    int step_degradation_level;
+    int idle_update_stride;
+    uint64_t step_count;
+    bool is_user_update_due(size_t index, const UserEquipment& user) const;
+    
+    // Read-side snapshots published every snapshot_interval steps
+    NetworkSnapshotRCU snapshot_rcu;
+    uint64_t handover_history_generation;
+    int snapshot_interval;
+    
+    // Timed X2/S1 handover signaling; off means instantaneous handovers
+    HandoverSignaling handover_signaling;
+    double signaling_clock_ms;
+    std::map<int, size_t> open_handover_entries;  // ue_id -> history index awaiting COMPLETE/FAIL
+    std::map<int, int> user_positions;            // ue_id -> index in users, rebuilt when stale
+    int find_user_index(int ue_id);
+    HandoverEvent start_signaled_handover(int ue_id, int target_cell);
+    void process_handover_signaling();
+    
+    // Downlink RLC/PDCP buffers drained by each step's allocation
+    RLCBufferPool downlink_buffers;
+    double downlink_tti_ms;
+    double buffer_clock_ms;
+    
     // Mobility model parameters
     bool mobility_enabled;
     double mobility_speed_min;
@@ -112,15 +405,24 @@ public:
     void initialize_network(int num_cells, int num_users);
     void add_cell(const CellInfo& cell);
     void add_user(const UserEquipment& user);
+    void add_user_ordered(const UserEquipment& user);
+    void remove_user(int ue_id);
+    void set_users(const std::vector<UserEquipment>& new_users);
+    void set_cells(const std::vector<CellInfo>& new_cells);
+    std::vector<int> add_sector_site(double x, double y, int num_sectors, double downtilt, double antenna_height);
+    void configure_sector(int cell_id, double azimuth, double downtilt, double antenna_height);
     
     // Cell management
     std::vector<CellInfo> get_cells() const;
     CellInfo get_cell_info(int cell_id) const;
     void update_cell_load(int cell_id, int load_percentage);
     void update_cell_interference(int cell_id, double interference);
+    void set_cell_spatial_index(std::shared_ptr<const CellSpatialIndex> index);
+    void set_measurement_radius(double radius_m);
     
     // User equipment management
     std::vector<UserEquipment> get_users() const;
+    const std::vector<UserEquipment>& get_users_ref() const;  // Stepping thread only
     UserEquipment get_user_info(int ue_id) const;
     void update_user_position(int ue_id, double x, double y);
     void update_user_state(int ue_id, LTEState state);
@@ -131,17 +433,42 @@ public:
     void update_resource_allocation();
     double calculate_user_throughput(int ue_id);
     
+    // Link adaptation
+    const std::vector<double>& calculate_rb_sinrs(int ue_id);
+    double calculate_effective_sinr(int ue_id, int cqi);
+    int select_user_cqi(int ue_id);
+    void report_harq_feedback(int ue_id, bool ack);
+    void set_link_adaptation_parameters(double target_bler, double step_db);
+    int get_user_cqi(int ue_id) const;
+    double get_olla_offset(int ue_id) const;
+    void set_user_link_state(int ue_id, int cqi, double olla_offset, double tpc_offset);
+    const LinkAbstraction& get_link_abstraction() const;
+    
     // Handover management
     bool should_trigger_handover(int ue_id);
     HandoverEvent initiate_handover(int ue_id, int target_cell);
     void execute_handover(int ue_id, int target_cell);
     void complete_handover(int ue_id);
     std::vector<HandoverEvent> get_handover_history() const;
+    int get_handover_count() const;
+    void configure_handover_signaling(const HandoverSignalingConfig& config);
+    HandoverSignalingConfig get_handover_signaling_config() const;
+    std::map<std::string, double> get_handover_signaling_statistics() const;
+    std::vector<double> get_handover_interruption_times() const;
     
     // Signal strength and quality
     double calculate_rsrp(int ue_id, int cell_id);
     double calculate_rsrq(int ue_id, int cell_id);
     double calculate_sinr(int ue_id, int cell_id);
+    double calculate_rsrp_at(double x, double y, const CellInfo& cell) const;
+    double calculate_sinr_at(double x, double y, int cell_id) const;
+    double calculate_rsrp_at(double x, double y, const CellInfo& cell, double frequency_mhz) const;
+    double calculate_sinr_at(double x, double y, int cell_id, double frequency_mhz) const;
+    double get_cell_activity(int cell_id) const;
+    std::vector<double> get_cell_activity_factors() const;
+    void set_load_weighted_interference(bool enabled);
+    void calculate_rsrp_batch(const double* x, const double* y, size_t count, const CellInfo& cell,
+                              double frequency_mhz, double* rsrp_out) const;
     std::vector<CellInfo> get_neighbor_cells(int ue_id);
     
     // Scheduling algorithms
@@ -150,6 +477,45 @@ public:
     void proportional_fair_scheduler();
     void max_ci_scheduler();
     
+    // Carrier aggregation
+    static int rbs_for_bandwidth(double bandwidth_mhz);
+    void configure_carriers(const std::vector<ComponentCarrier>& new_carriers);
+    std::vector<ComponentCarrier> get_carriers() const;
+    void build_carrier_grids();
+    void carrier_aggregation_scheduler();
+    void schedule_carrier(size_t carrier_index);
+    void append_allocated_rbs(UserEquipment& user, size_t carrier_index, size_t user_index);
+    void set_carrier_scheduling_parameters(int pdcch_grants, bool parallel);
+    void set_cell_carriers(const std::vector<int>& carrier_per_cell);
+    std::vector<int> get_cell_carriers() const;
+    std::vector<double> get_user_carrier_throughput(int ue_id) const;
+    double get_carrier_cell_activity(size_t carrier_index, int cell_id) const;
+    void set_external_cell_activity(size_t carrier_index, int cell_id, double activity);
+    
+    // NR numerology and bandwidth parts
+    static int nr_prbs_for_bandwidth(double bandwidth_mhz, int numerology);
+    void configure_nr(int numerology, double frequency_mhz, double bandwidth_mhz, int num_bandwidth_parts);
+    void set_active_bandwidth_part(int ue_id, int bandwidth_part);
+    void set_csi_report_period(int slots);
+    bool is_nr_mode() const;
+    int get_numerology() const;
+    double get_slot_duration_ms() const;
+    
+    // Uplink power control and scheduling
+    static UplinkPowerControl default_uplink_power_control();
+    void enable_uplink(bool enable);
+    void set_uplink_power_control(const UplinkPowerControl& config);
+    UplinkPowerControl get_uplink_power_control() const;
+    void uplink_scheduler();
+    double get_uplink_throughput(int ue_id) const;
+    double get_uplink_tx_power(int ue_id) const;
+    double get_uplink_sinr(int ue_id) const;
+    double get_tpc_offset(int ue_id) const;
+    bool get_uplink_transmission(int ue_id, UplinkTransmission& transmission) const;
+    void set_external_uplink_transmissions(const std::vector<UplinkTransmission>& transmissions);
+    std::vector<double> get_uplink_interference(int cell_id) const;
+    std::map<std::string, double> get_uplink_statistics() const;
+    
     // Mobility simulation
     void enable_mobility(bool enable);
     void set_mobility_model(const std::string& model);
@@ -178,12 +544,43 @@ public:
     
     // Simulation control
     void step_simulation();
+    void step_measurements();
+    void step_scheduling();
+    void set_step_degradation(int level, int idle_stride);
+    int get_step_degradation() const;
     void reset_network();
     void generate_network_events();
     
     // Statistics and reporting
     std::map<std::string, double> get_network_statistics() const;
     std::string generate_performance_report() const;
+    
+    // Flat state export
+    void refresh_state_arrays();
+    std::shared_ptr<const LTEStateArrays> get_state_arrays();
+    
+    // Consistent snapshots, safe to read while another thread steps
+    void publish_snapshot();
+    void set_snapshot_interval(int steps);      // 0 publishes only on request
+    int get_snapshot_interval() const;
+    LTENetworkSnapshot get_snapshot() const;
+    std::vector<CellInfo> get_cells_snapshot() const;
+    std::vector<UserEquipment> get_users_snapshot() const;
+    std::vector<HandoverEvent> get_handover_history_snapshot() const;
+    uint64_t get_snapshot_epoch() const;
+    
+    // Downlink buffers and the queuing delay they add to transport RTT
+    void configure_downlink_buffers(int max_ues, int capacity_per_ue,
+                                    double discard_timer_ms, double tti_ms);
+    bool downlink_buffers_enabled() const;
+    bool enqueue_downlink(int ue_id, uint32_t sdu_id, uint32_t bytes);
+    void drain_downlink_buffers();
+    double get_queuing_delay(int ue_id) const;
+    double get_head_of_line_delay(int ue_id) const;
+    uint64_t get_delivered_bytes(int ue_id) const;      // In the last TTI
+    int get_discarded_sdus(int ue_id) const;            // In the last TTI
+    uint64_t get_buffered_bytes(int ue_id) const;
+    std::map<std::string, double> get_buffer_statistics() const;
 };
 
 #endif // LTE_NETWORK_H 
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "lte_network.h"
+#include "cell_spatial_index.h"
 #include <cmath>
 #include <algorithm>
 #include <random>
@@ -10,6 +11,27 @@ LTENetwork::LTENetwork() {
     interference_threshold = 0.1;
     max_users_per_cell = 100;
     scheduling_algorithm = "Proportional Fair";
+    olla_target_bler = 0.1;
+    olla_step_db = 0.5;
+    control_overhead = 0.25;
+    pdcch_grants_per_carrier = 16;
+    parallel_carrier_scheduling = true;
+    load_weighted_interference = true;
+    measurement_radius = 0.0;
+    step_degradation_level = 0;
+    idle_update_stride = 4;
+    step_count = 0;
+    handover_history_generation = 1;
+    snapshot_interval = 1;
+    downlink_tti_ms = 1.0;
+    nr_mode = false;
+    nr_numerology = 0;
+    csi_report_period = 1;
+    uplink_enabled = false;
+    uplink_pc = default_uplink_power_control();
+    uplink_rbs_per_cell = 0;
+    buffer_clock_ms = 0.0;
+    signaling_clock_ms = 0.0;
     mobility_enabled = false;
     mobility_speed_min = 5.0;
     mobility_speed_max = 120.0;
@@ -20,6 +42,16 @@ void LTENetwork::initialize_network(int num_cells, int num_users) {
     cells.clear();
     users.clear();
     handover_history.clear();
+    user_cqi_values.clear();
+    user_olla_offsets.clear();
+    user_tpc_offsets.clear();
+    cell_activity.clear();
+    reported_cell_load.clear();
+    cell_carrier.clear();
+    cell_site_index.reset();
+    handover_history_generation++;
+    handover_signaling.reset();
+    open_handover_entries.clear();
     
     // Create cells
     for (int i = 0; i < num_cells; i++) {
@@ -32,6 +64,10 @@ void LTENetwork::initialize_network(int num_cells, int num_users) {
         cell.technology = "LTE";
         cell.latitude = (i / 3) * 1000.0;
         cell.longitude = (i % 3) * 1000.0;
+        cell.sectorized = false;
+        cell.azimuth = 0.0;
+        cell.downtilt = 6.0;
+        cell.antenna_height = 30.0;
         cells.push_back(cell);
     }
     
@@ -51,21 +87,16 @@ void LTENetwork::initialize_network(int num_cells, int num_users) {
         ue.state = LTEState::CONNECTED;
         ue.current_throughput = 1.0;
         ue.battery_level = 1.0;
+        ue.primary_carrier = 0;
+        ue.max_component_carriers = 5;
+        ue.average_throughput = 0.0;
         users.push_back(ue);
     }
-}
-
-double LTENetwork::calculate_rsrp(int ue_id, int cell_id) {
-    UserEquipment user = get_user_info(ue_id);
-    CellInfo cell = get_cell_info(cell_id);
-    
-    double distance = std::sqrt(std::pow(user.x_position - cell.longitude, 2) + 
-                               std::pow(user.y_position - cell.latitude, 2));
     
-    double path_loss = 128.1 + 37.6 * std::log10(std::max(distance / 1000.0, 0.001));
-    double rsrp = 46.0 - path_loss + 15.0;
+    build_carrier_grids();
     
-    return rsrp;
+    refresh_state_arrays();
+    publish_snapshot();
 }
 
 bool LTENetwork::should_trigger_handover(int ue_id) {
@@ -84,9 +115,13 @@ bool LTENetwork::should_trigger_handover(int ue_id) {
 }
 
 HandoverEvent LTENetwork::initiate_handover(int ue_id, int target_cell) {
+    if (handover_signaling.is_enabled()) {
+        return start_signaled_handover(ue_id, target_cell);
+    }
     UserEquipment user = get_user_info(ue_id);
     
     HandoverEvent handover;
+    handover.ue_id = ue_id;
     handover.source_cell = user.serving_cell;
     handover.target_cell = target_cell;
     handover.type = HandoverType::INTRA_LTE;
@@ -160,24 +195,101 @@ std::vector<HandoverEvent> LTENetwork::get_handover_history() const {
 }
 
 void LTENetwork::step_simulation() {
-    // Simplified simulation step
-    for (auto& user : users) {
-        if (should_trigger_handover(user.ue_id)) {
-            // Find best cell
-            int best_cell = 0;
-            double best_rsrp = -200.0;
+    step_measurements();
+    step_scheduling();
+}
+
+void LTENetwork::step_measurements() {
+    // Deliver handover signaling due this TTI
+    if (handover_signaling.is_enabled()) {
+        process_handover_signaling();
+    }
+    
+    // Simplified simulation step; NR slots measure once per millisecond
+    bool measure = is_measurement_due();
+    bool indexed = cell_site_index && measurement_radius > 0.0 && cell_site_index->size() == cells.size();
+    for (size_t i = 0; i < users.size(); i++) {
+        UserEquipment& user = users[i];
+        if (!measure || !is_user_update_due(i, user) || handover_signaling.is_pending(user.ue_id)) continue;
+        
+        // One measurement pass per UE: serving and best cell together, the
+        // same trigger as should_trigger_handover() without per-cell lookups
+        int best_cell = 0;
+        double best_rsrp = -200.0;
+        double serving_rsrp = -200.0;
+        if (indexed) {
+            int serving = find_cell_index(user.serving_cell);
+            if (serving >= 0) {
+                serving_rsrp = calculate_rsrp_at(user.x_position, user.y_position, cells[serving]);
+                best_rsrp = serving_rsrp;
+                best_cell = user.serving_cell;
+            }
+            measurement_candidates.clear();
+            cell_site_index->query_radius(user.x_position, user.y_position, measurement_radius,
+                                          measurement_candidates);
+            for (int candidate : measurement_candidates) {
+                if (candidate == serving) continue;
+                double rsrp = calculate_rsrp_at(user.x_position, user.y_position, cells[candidate]);
+                if (rsrp > best_rsrp) {
+                    best_rsrp = rsrp;
+                    best_cell = cells[candidate].cell_id;
+                }
+            }
+        } else {
             for (const auto& cell : cells) {
-                double rsrp = calculate_rsrp(user.ue_id, cell.cell_id);
+                double rsrp = calculate_rsrp_at(user.x_position, user.y_position, cell);
+                if (cell.cell_id == user.serving_cell) serving_rsrp = rsrp;
                 if (rsrp > best_rsrp) {
                     best_rsrp = rsrp;
                     best_cell = cell.cell_id;
                 }
             }
-            
-            if (best_cell != user.serving_cell) {
-                HandoverEvent handover = initiate_handover(user.ue_id, best_cell);
-                handover_history.push_back(handover);
+        }
+        
+        if (best_cell != user.serving_cell &&
+            best_rsrp > serving_rsrp + handover_margin + handover_hysteresis) {
+            HandoverEvent handover = initiate_handover(user.ue_id, best_cell);
+            handover_history.push_back(handover);
+            if (handover_signaling.is_pending(user.ue_id)) {
+                open_handover_entries[user.ue_id] = handover_history.size() - 1;
             }
         }
     }
-} 
\ No newline at end of file
+}
+
+void LTENetwork::step_scheduling() {
+    bool measure = is_measurement_due();
+    
+    // Proportional fair scheduling per carrier; a single-carrier network is
+    // the one-grid case, so every step produces CQI/BLER-based throughput
+    carrier_aggregation_scheduler();
+    
+    if (step_degradation_level < 1 && measure) {
+        refresh_state_arrays();
+    }
+    if (uplink_enabled) {
+        uplink_scheduler();
+    }
+    if (downlink_buffers.enabled()) {
+        drain_downlink_buffers();
+    }
+    step_count++;
+    if (snapshot_interval > 0 && step_count % snapshot_interval == 0) {
+        publish_snapshot();
+    }
+}
+
+void LTENetwork::set_step_degradation(int level, int idle_stride) {
+    step_degradation_level = std::min(std::max(level, 0), 2);
+    idle_update_stride = std::max(idle_stride, 1);
+}
+
+int LTENetwork::get_step_degradation() const {
+    return step_degradation_level;
+}
+
+bool LTENetwork::is_user_update_due(size_t index, const UserEquipment& user) const {
+    // Connected UEs are always updated; idle ones take turns when degraded
+    if (step_degradation_level < 2 || user.state == LTEState::CONNECTED) return true;
+    return (index + step_count) % idle_update_stride == 0;
+}
@@ -0,0 +1,105 @@
+#include "lte_network.h"
+#include <algorithm>
+
+namespace {
+
+struct NRBandwidthConfig {
+    double bandwidth_mhz;
+    int num_prbs;
+};
+
+// TS 38.101-1 Table 5.3.2-1 (FR1) and TS 38.101-2 Table 5.3.2-1 (FR2);
+// 60 kHz continues into the FR2 bandwidths above 100 MHz
+const NRBandwidthConfig scs15_prbs[] = {
+    {5, 25}, {10, 52}, {15, 79}, {20, 106}, {25, 133}, {30, 160}, {40, 216}, {50, 270}
+};
+const NRBandwidthConfig scs30_prbs[] = {
+    {5, 11}, {10, 24}, {15, 38}, {20, 51}, {25, 65}, {30, 78}, {40, 106}, {50, 133},
+    {60, 162}, {70, 189}, {80, 217}, {90, 245}, {100, 273}
+};
+const NRBandwidthConfig scs60_prbs[] = {
+    {10, 11}, {15, 18}, {20, 24}, {25, 31}, {30, 38}, {40, 51}, {50, 65}, {60, 79},
+    {70, 93}, {80, 107}, {90, 121}, {100, 135}, {200, 264}
+};
+const NRBandwidthConfig scs120_prbs[] = {
+    {50, 32}, {100, 66}, {200, 132}, {400, 264}
+};
+
+int lookup_prbs(const NRBandwidthConfig* table, size_t size, double bandwidth_mhz) {
+    // Largest configuration that fits in the requested bandwidth
+    int prbs = table[0].num_prbs;
+    for (size_t i = 0; i < size; i++) {
+        if (table[i].bandwidth_mhz <= bandwidth_mhz + 1e-9) prbs = table[i].num_prbs;
+    }
+    return prbs;
+}
+
+} // namespace
+
+int LTENetwork::nr_prbs_for_bandwidth(double bandwidth_mhz, int numerology) {
+    switch (numerology) {
+        case 0: return lookup_prbs(scs15_prbs, sizeof(scs15_prbs) / sizeof(scs15_prbs[0]), bandwidth_mhz);
+        case 1: return lookup_prbs(scs30_prbs, sizeof(scs30_prbs) / sizeof(scs30_prbs[0]), bandwidth_mhz);
+        case 2: return lookup_prbs(scs60_prbs, sizeof(scs60_prbs) / sizeof(scs60_prbs[0]), bandwidth_mhz);
+        default: return lookup_prbs(scs120_prbs, sizeof(scs120_prbs) / sizeof(scs120_prbs[0]), bandwidth_mhz);
+    }
+}
+
+void LTENetwork::configure_nr(int numerology, double frequency_mhz, double bandwidth_mhz, int num_bandwidth_parts) {
+    int mu = std::min(std::max(numerology, 0), 3);
+    int total_prbs = nr_prbs_for_bandwidth(bandwidth_mhz, mu);
+    int parts = std::min(std::max(num_bandwidth_parts, 1), std::min(4, total_prbs));
+    double prb_mhz = 0.18 * (1 << mu);
+
+    // Disjoint bandwidth parts splitting the carrier's PRBs; each one is a
+    // grid of its own and every UE is active on exactly one
+    carriers.clear();
+    int start_prb = 0;
+    for (int part = 0; part < parts; part++) {
+        ComponentCarrier bwp;
+        bwp.carrier_id = part;
+        bwp.numerology = mu;
+        bwp.num_rbs = total_prbs / parts + (part < total_prbs % parts ? 1 : 0);
+        bwp.bandwidth_mhz = bwp.num_rbs * prb_mhz;
+        bwp.frequency_mhz = frequency_mhz + (start_prb + bwp.num_rbs / 2.0 - total_prbs / 2.0) * prb_mhz;
+        carriers.push_back(bwp);
+        start_prb += bwp.num_rbs;
+    }
+
+    nr_mode = true;
+    nr_numerology = mu;
+    csi_report_period = 1 << mu;  // One CSI report per millisecond
+    downlink_tti_ms = get_slot_duration_ms();
+    build_carrier_grids();
+}
+
+void LTENetwork::set_active_bandwidth_part(int ue_id, int bandwidth_part) {
+    if (carriers.empty()) return;
+    for (auto& user : users) {
+        if (user.ue_id == ue_id) {
+            user.primary_carrier = std::abs(bandwidth_part) % static_cast<int>(carriers.size());
+            break;
+        }
+    }
+}
+
+void LTENetwork::set_csi_report_period(int slots) {
+    csi_report_period = std::max(slots, 1);
+}
+
+bool LTENetwork::is_nr_mode() const {
+    return nr_mode;
+}
+
+int LTENetwork::get_numerology() const {
+    return nr_numerology;
+}
+
+double LTENetwork::get_slot_duration_ms() const {
+    return 1.0 / (1 << nr_numerology);
+}
+
+bool LTENetwork::is_measurement_due() const {
+    // L3 measurements and handover decisions stay on the 1 ms LTE cadence
+    return !nr_mode || step_count % (1u << nr_numerology) == 0;
+}
@@ -0,0 +1,596 @@
+#include "lte_partitioned.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct SharedHeader {
+    pthread_barrier_t step_barrier;
+    std::atomic<int32_t> in_transit[3];     // Migrations still forwarding, per exchange round mod 3
+};
+
+// Single-producer/single-consumer ring; head and tail are free-running
+struct RingHeader {
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+};
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+HaloRecord make_ue_record(HaloRecordType type, const UserEquipment& ue, const LTENetwork& network) {
+    HaloRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.ue_id = ue.ue_id;
+    record.serving_cell = ue.serving_cell;
+    record.state = static_cast<int32_t>(ue.state);
+    record.x_position = ue.x_position;
+    record.y_position = ue.y_position;
+    record.velocity = ue.velocity;
+    record.direction = ue.direction;
+    record.current_throughput = ue.current_throughput;
+    record.average_throughput = ue.average_throughput;
+    record.battery_level = ue.battery_level;
+    record.primary_carrier = ue.primary_carrier;
+    record.max_component_carriers = ue.max_component_carriers;
+    record.cqi = network.get_user_cqi(ue.ue_id);
+    record.olla_offset = network.get_olla_offset(ue.ue_id);
+    record.tpc_offset = network.get_tpc_offset(ue.ue_id);
+
+    UplinkTransmission uplink;
+    if (network.get_uplink_transmission(ue.ue_id, uplink)) {
+        record.uplink_first_rb = uplink.first_rb;
+        record.uplink_num_rbs = uplink.num_rbs;
+        record.uplink_tx_power_dbm = uplink.tx_power_dbm;
+    }
+    return record;
+}
+
+UserEquipment ue_from_record(const HaloRecord& record) {
+    UserEquipment ue;
+    ue.ue_id = record.ue_id;
+    ue.x_position = record.x_position;
+    ue.y_position = record.y_position;
+    ue.velocity = record.velocity;
+    ue.direction = record.direction;
+    ue.serving_cell = record.serving_cell;
+    ue.state = static_cast<LTEState>(record.state);
+    ue.current_throughput = record.current_throughput;
+    ue.average_throughput = record.average_throughput;
+    ue.battery_level = record.battery_level;
+    ue.primary_carrier = record.primary_carrier;
+    ue.max_component_carriers = record.max_component_carriers;
+    return ue;
+}
+
+bool ring_push(RingHeader* ring, HaloRecord* records, uint32_t capacity, const HaloRecord& record) {
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint32_t head = ring->head.load(std::memory_order_acquire);
+    if (tail - head >= capacity) return false;
+    records[tail % capacity] = record;
+    ring->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool ring_pop(RingHeader* ring, HaloRecord* records, uint32_t capacity, HaloRecord& record) {
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    uint32_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head == tail) return false;
+    record = records[head % capacity];
+    ring->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+}  // namespace
+
+PartitionedLTESimulation::PartitionedLTESimulation(const PartitionConfig& cfg) {
+    config = cfg;
+    config.regions_x = std::max(config.regions_x, 1);
+    config.regions_y = std::max(config.regions_y, 1);
+    config.ring_capacity = std::max(config.ring_capacity, 16);
+    shared_base = nullptr;
+    shared_size = 0;
+    ring_headers_offset = 0;
+    ring_records_offset = 0;
+    step_throughput_offset = 0;
+    step_active_offset = 0;
+    region_kpis_offset = 0;
+    cell_activity_offset = 0;
+    num_carriers = 1;
+    final_users_offset = 0;
+    last_run_ok = false;
+    build_rings();
+}
+
+PartitionedLTESimulation::~PartitionedLTESimulation() {
+    unmap_shared_segment();
+}
+
+int PartitionedLTESimulation::num_regions() const {
+    return config.regions_x * config.regions_y;
+}
+
+int PartitionedLTESimulation::region_of_point(double x, double y) const {
+    double region_width = config.area_width / config.regions_x;
+    double region_height = config.area_height / config.regions_y;
+    int rx = static_cast<int>(std::floor(x / region_width));
+    int ry = static_cast<int>(std::floor(y / region_height));
+    rx = std::max(0, std::min(rx, config.regions_x - 1));
+    ry = std::max(0, std::min(ry, config.regions_y - 1));
+    return ry * config.regions_x + rx;
+}
+
+double PartitionedLTESimulation::distance_to_region(double x, double y, int region) const {
+    double region_width = config.area_width / config.regions_x;
+    double region_height = config.area_height / config.regions_y;
+    double x0 = (region % config.regions_x) * region_width;
+    double y0 = (region / config.regions_x) * region_height;
+    double dx = std::max({x0 - x, 0.0, x - (x0 + region_width)});
+    double dy = std::max({y0 - y, 0.0, y - (y0 + region_height)});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+std::vector<int> PartitionedLTESimulation::get_neighbours(int region) const {
+    std::vector<int> neighbours;
+    int rx = region % config.regions_x;
+    int ry = region / config.regions_x;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int nx = rx + dx;
+            int ny = ry + dy;
+            if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 ||
+                nx >= config.regions_x || ny >= config.regions_y) {
+                continue;
+            }
+            neighbours.push_back(ny * config.regions_x + nx);
+        }
+    }
+    return neighbours;
+}
+
+int PartitionedLTESimulation::next_hop(int src_region, int dst_region) const {
+    // Step one region towards the destination; UEs that jump further than a
+    // neighbour are forwarded hop by hop on subsequent steps
+    int sx = src_region % config.regions_x, sy = src_region / config.regions_x;
+    int dx = dst_region % config.regions_x, dy = dst_region / config.regions_x;
+    int nx = sx + (dx > sx) - (dx < sx);
+    int ny = sy + (dy > sy) - (dy < sy);
+    return ny * config.regions_x + nx;
+}
+
+void PartitionedLTESimulation::build_rings() {
+    int regions = num_regions();
+    ring_index.assign(static_cast<size_t>(regions) * regions, -1);
+    rings.clear();
+    for (int src = 0; src < regions; src++) {
+        for (int dst : get_neighbours(src)) {
+            ring_index[src * regions + dst] = static_cast<int>(rings.size());
+            rings.push_back({src, dst});
+        }
+    }
+}
+
+void PartitionedLTESimulation::set_network(const LTENetwork& network) {
+    template_network = network;
+    initial_users = network.get_users();
+
+    cell_id_to_region.clear();
+    cell_ids.clear();
+    for (const auto& cell : network.get_cells()) {
+        // Cells store x in longitude and y in latitude
+        cell_id_to_region[cell.cell_id] = region_of_point(cell.longitude, cell.latitude);
+        cell_ids.push_back(cell.cell_id);
+    }
+    num_carriers = std::max(static_cast<int>(network.get_carriers().size()), 1);
+
+    ue_slot.clear();
+    for (size_t i = 0; i < initial_users.size(); i++) {
+        ue_slot[initial_users[i].ue_id] = static_cast<int>(i);
+    }
+}
+
+int PartitionedLTESimulation::get_region_of_cell(int cell_id) const {
+    auto it = cell_id_to_region.find(cell_id);
+    return (it != cell_id_to_region.end()) ? it->second : 0;
+}
+
+bool PartitionedLTESimulation::map_shared_segment(int num_steps) {
+    int regions = num_regions();
+    size_t capacity = static_cast<size_t>(config.ring_capacity);
+
+    size_t offset = align_up(sizeof(SharedHeader), 64);
+    ring_headers_offset = offset;
+    offset = align_up(offset + rings.size() * sizeof(RingHeader), 64);
+    ring_records_offset = offset;
+    offset = align_up(offset + rings.size() * capacity * sizeof(HaloRecord), 64);
+    step_throughput_offset = offset;
+    offset = align_up(offset + static_cast<size_t>(num_steps) * regions * sizeof(double), 64);
+    step_active_offset = offset;
+    offset = align_up(offset + static_cast<size_t>(num_steps) * regions * sizeof(int32_t), 64);
+    region_kpis_offset = offset;
+    offset = align_up(offset + regions * sizeof(RegionKPIs), 64);
+    cell_activity_offset = offset;
+    offset = align_up(offset + static_cast<size_t>(num_carriers) * cell_ids.size() * sizeof(double), 64);
+    final_users_offset = offset;
+    offset = align_up(offset + initial_users.size() * sizeof(HaloRecord), 64);
+    shared_size = offset;
+
+    // Named segment, unlinked as soon as it is mapped; the workers inherit
+    // the mapping across fork()
+    static std::atomic<int> segment_counter(0);
+    std::string name = "/lte_partition_" + std::to_string(getpid()) + "_" +
+                       std::to_string(segment_counter.fetch_add(1));
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    shm_unlink(name.c_str());
+
+    if (ftruncate(fd, static_cast<off_t>(shared_size)) != 0) {
+        close(fd);
+        return false;
+    }
+    void* base = mmap(nullptr, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+
+    shared_base = base;
+    std::memset(shared_base, 0, shared_size);
+
+    char* bytes = static_cast<char*>(shared_base);
+    RingHeader* ring_headers = reinterpret_cast<RingHeader*>(bytes + ring_headers_offset);
+    for (size_t i = 0; i < rings.size(); i++) {
+        new (&ring_headers[i]) RingHeader();
+        ring_headers[i].head.store(0);
+        ring_headers[i].tail.store(0);
+    }
+
+    SharedHeader* header = static_cast<SharedHeader*>(shared_base);
+    for (int i = 0; i < 3; i++) {
+        new (&header->in_transit[i]) std::atomic<int32_t>(0);
+    }
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    int rc = pthread_barrier_init(&header->step_barrier, &attr, static_cast<unsigned>(regions));
+    pthread_barrierattr_destroy(&attr);
+    if (rc != 0) {
+        unmap_shared_segment();
+        return false;
+    }
+    return true;
+}
+
+void PartitionedLTESimulation::unmap_shared_segment() {
+    if (!shared_base) return;
+    pthread_barrier_destroy(&static_cast<SharedHeader*>(shared_base)->step_barrier);
+    munmap(shared_base, shared_size);
+    shared_base = nullptr;
+    shared_size = 0;
+}
+
+void PartitionedLTESimulation::run_worker(int region, int num_steps) {
+    int regions = num_regions();
+    uint32_t capacity = static_cast<uint32_t>(config.ring_capacity);
+    char* bytes = static_cast<char*>(shared_base);
+    SharedHeader* header = static_cast<SharedHeader*>(shared_base);
+    RingHeader* ring_headers = reinterpret_cast<RingHeader*>(bytes + ring_headers_offset);
+    HaloRecord* ring_records = reinterpret_cast<HaloRecord*>(bytes + ring_records_offset);
+    double* step_throughput = reinterpret_cast<double*>(bytes + step_throughput_offset);
+    int32_t* step_active = reinterpret_cast<int32_t*>(bytes + step_active_offset);
+    RegionKPIs& kpis = reinterpret_cast<RegionKPIs*>(bytes + region_kpis_offset)[region];
+    double* cell_activity = reinterpret_cast<double*>(bytes + cell_activity_offset);
+    HaloRecord* final_records = reinterpret_cast<HaloRecord*>(bytes + final_users_offset);
+    size_t num_cells = cell_ids.size();
+
+    auto push = [&](int dst, const HaloRecord& record) {
+        int ring = ring_index[region * regions + dst];
+        return ring_push(&ring_headers[ring], ring_records + static_cast<size_t>(ring) * capacity,
+                         capacity, record);
+    };
+
+    // The worker's network keeps every cell (interference needs them all)
+    // but only the UEs served by cells this region owns, in ue_id order
+    LTENetwork network = template_network;
+    network.set_snapshot_interval(0);  // Nothing reads a worker's snapshots
+    std::vector<UserEquipment> owned;
+    for (const auto& ue : initial_users) {
+        if (get_region_of_cell(ue.serving_cell) == region) {
+            owned.push_back(ue);
+        }
+    }
+    std::stable_sort(owned.begin(), owned.end(),
+                     [](const UserEquipment& a, const UserEquipment& b) { return a.ue_id < b.ue_id; });
+    network.set_users(owned);
+
+    // Cells owned elsewhere are never scheduled here; their activity comes
+    // from the owners' summaries
+    std::vector<char> owns_cell(num_cells, 0);
+    for (size_t i = 0; i < num_cells; i++) {
+        owns_cell[i] = get_region_of_cell(cell_ids[i]) == region;
+        if (owns_cell[i]) continue;
+        for (int c = 0; c < num_carriers; c++) {
+            network.set_external_cell_activity(c, cell_ids[i], network.get_carrier_cell_activity(c, cell_ids[i]));
+        }
+    }
+
+    std::vector<int> neighbours = get_neighbours(region);
+    std::map<int, HaloRecord> ghosts;
+    std::vector<UplinkTransmission> ghost_uplink;
+    std::vector<UserEquipment> users;
+    int handovers_before = network.get_handover_count();
+    uint64_t exchange_round = 0;
+    int max_rounds = std::max(config.regions_x, config.regions_y) + 1;
+
+    for (int step = 0; step < num_steps; step++) {
+        // Phase 1: measurements and handovers, then hand UEs now served by
+        // another region's cell over before anything is scheduled. UEs move
+        // one region per round; rounds repeat until no region is forwarding
+        network.step_measurements();
+        for (int round = 0; round < max_rounds; round++, exchange_round++) {
+            std::atomic<int32_t>& in_transit = header->in_transit[exchange_round % 3];
+            if (region == 0) {
+                // Last read two rounds ago, next written after this round's barriers
+                header->in_transit[(exchange_round + 1) % 3].store(0);
+            }
+
+            int pending = 0;
+            users = network.get_users();
+            for (const auto& ue : users) {
+                int owner = get_region_of_cell(ue.serving_cell);
+                if (owner == region) continue;
+                if (push(next_hop(region, owner), make_ue_record(HaloRecordType::MIGRATING_UE, ue, network))) {
+                    network.remove_user(ue.ue_id);
+                    kpis.migrations_out++;
+                } else {
+                    kpis.ring_overflows++;  // Retried next round
+                    pending++;
+                }
+            }
+
+            pthread_barrier_wait(&header->step_barrier);
+
+            for (int neighbour : neighbours) {
+                int ring = ring_index[neighbour * regions + region];
+                HaloRecord record;
+                while (ring_pop(&ring_headers[ring], ring_records + static_cast<size_t>(ring) * capacity,
+                                capacity, record)) {
+                    network.add_user_ordered(ue_from_record(record));
+                    network.set_user_link_state(record.ue_id, record.cqi, record.olla_offset, record.tpc_offset);
+                    kpis.migrations_in++;
+                    if (get_region_of_cell(record.serving_cell) != region) pending++;
+                }
+            }
+            if (pending > 0) in_transit.fetch_add(pending);
+
+            // Also keeps the next pushes from racing this drain
+            pthread_barrier_wait(&header->step_barrier);
+            if (in_transit.load() == 0) {
+                exchange_round++;
+                break;
+            }
+        }
+
+        // Phase 2: schedule, then publish KPIs, ghosts and cell activity
+        network.step_scheduling();
+        users = network.get_users();
+        double throughput = 0.0;
+        int active = 0;
+        for (const auto& ue : users) {
+            throughput += ue.current_throughput;
+            active += (ue.state == LTEState::CONNECTED) ? 1 : 0;
+        }
+        step_throughput[static_cast<size_t>(step) * regions + region] = throughput;
+        step_active[static_cast<size_t>(step) * regions + region] = active;
+
+        for (const auto& ue : users) {
+            if (get_region_of_cell(ue.serving_cell) != region) continue;  // In transit
+            for (int neighbour : neighbours) {
+                if (distance_to_region(ue.x_position, ue.y_position, neighbour) <= config.halo_width) {
+                    if (push(neighbour, make_ue_record(HaloRecordType::BORDER_UE, ue, network))) {
+                        kpis.border_records_sent++;
+                    } else {
+                        kpis.ring_overflows++;
+                    }
+                }
+            }
+        }
+
+        // Interferer summaries: this step's RB activity of every owned cell
+        // on every carrier, read by all regions, not only the neighbours
+        for (size_t i = 0; i < num_cells; i++) {
+            if (!owns_cell[i]) continue;
+            for (int c = 0; c < num_carriers; c++) {
+                cell_activity[c * num_cells + i] = network.get_carrier_cell_activity(c, cell_ids[i]);
+            }
+        }
+
+        pthread_barrier_wait(&header->step_barrier);
+
+        for (size_t i = 0; i < num_cells; i++) {
+            if (owns_cell[i]) continue;
+            for (int c = 0; c < num_carriers; c++) {
+                network.set_external_cell_activity(c, cell_ids[i], cell_activity[c * num_cells + i]);
+            }
+        }
+
+        ghosts.clear();
+        for (int neighbour : neighbours) {
+            int ring = ring_index[neighbour * regions + region];
+            HaloRecord record;
+            while (ring_pop(&ring_headers[ring], ring_records + static_cast<size_t>(ring) * capacity,
+                            capacity, record)) {
+                ghosts[record.ue_id] = record;
+            }
+        }
+        kpis.ghost_users = static_cast<int32_t>(ghosts.size());
+
+        // Border UEs of the neighbours interfere with this region's uplink
+        // in the next step, one TTI after they transmitted
+        ghost_uplink.clear();
+        for (const auto& entry : ghosts) {
+            const HaloRecord& ghost = entry.second;
+            if (ghost.uplink_num_rbs <= 0) continue;
+            UplinkTransmission transmission;
+            transmission.x_position = ghost.x_position;
+            transmission.y_position = ghost.y_position;
+            transmission.serving_cell = ghost.serving_cell;
+            transmission.first_rb = ghost.uplink_first_rb;
+            transmission.num_rbs = ghost.uplink_num_rbs;
+            transmission.tx_power_dbm = ghost.uplink_tx_power_dbm;
+            ghost_uplink.push_back(transmission);
+        }
+        network.set_external_uplink_transmissions(ghost_uplink);
+
+        // Keep the next step's writes from racing this step's reads
+        pthread_barrier_wait(&header->step_barrier);
+    }
+
+    double total_throughput = 0.0;
+    for (const auto& ue : network.get_users()) {
+        total_throughput += ue.current_throughput;
+        auto slot = ue_slot.find(ue.ue_id);
+        if (slot != ue_slot.end()) {
+            final_records[slot->second] = make_ue_record(HaloRecordType::MIGRATING_UE, ue, network);
+        }
+    }
+    kpis.total_throughput = total_throughput;
+    kpis.handovers = network.get_handover_count() - handovers_before;
+    kpis.owned_users = static_cast<int32_t>(network.get_users().size());
+    kpis.completed = 1;
+}
+
+bool PartitionedLTESimulation::run(int num_steps) {
+    last_run_ok = false;
+    if (num_steps <= 0) return false;
+
+    unmap_shared_segment();
+    if (!map_shared_segment(num_steps)) return false;
+
+    int regions = num_regions();
+    std::vector<pid_t> workers;
+    bool spawn_failed = false;
+
+    for (int region = 0; region < regions; region++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            int status = 0;
+            try {
+                run_worker(region, num_steps);
+            } catch (...) {
+                status = 1;
+            }
+            _exit(status);
+        }
+        if (pid < 0) {
+            spawn_failed = true;
+            break;
+        }
+        workers.push_back(pid);
+    }
+
+    // A missing or failed worker would leave the others blocked on the
+    // barrier, so tear the whole group down
+    bool ok = !spawn_failed;
+    if (spawn_failed) {
+        for (pid_t pid : workers) kill(pid, SIGKILL);
+    }
+
+    size_t remaining = workers.size();
+    while (remaining > 0) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) break;
+        if (std::find(workers.begin(), workers.end(), pid) == workers.end()) continue;
+        remaining--;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            if (ok) {
+                for (pid_t other : workers) kill(other, SIGKILL);
+            }
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        collect_results(num_steps);
+    }
+    unmap_shared_segment();
+    last_run_ok = ok;
+    return ok;
+}
+
+void PartitionedLTESimulation::collect_results(int num_steps) {
+    int regions = num_regions();
+    char* bytes = static_cast<char*>(shared_base);
+    const double* step_throughput = reinterpret_cast<const double*>(bytes + step_throughput_offset);
+    const int32_t* step_active = reinterpret_cast<const int32_t*>(bytes + step_active_offset);
+    const RegionKPIs* kpis = reinterpret_cast<const RegionKPIs*>(bytes + region_kpis_offset);
+    const HaloRecord* final_records = reinterpret_cast<const HaloRecord*>(bytes + final_users_offset);
+
+    throughput_history.assign(num_steps, 0.0);
+    active_users_history.assign(num_steps, 0);
+    for (int step = 0; step < num_steps; step++) {
+        for (int region = 0; region < regions; region++) {
+            throughput_history[step] += step_throughput[static_cast<size_t>(step) * regions + region];
+            active_users_history[step] += step_active[static_cast<size_t>(step) * regions + region];
+        }
+    }
+
+    region_kpis.assign(kpis, kpis + regions);
+
+    final_users.clear();
+    for (size_t i = 0; i < initial_users.size(); i++) {
+        final_users.push_back(ue_from_record(final_records[i]));
+    }
+}
+
+std::vector<double> PartitionedLTESimulation::get_throughput_history() const {
+    return throughput_history;
+}
+
+std::vector<int> PartitionedLTESimulation::get_active_users_history() const {
+    return active_users_history;
+}
+
+std::vector<RegionKPIs> PartitionedLTESimulation::get_region_kpis() const {
+    return region_kpis;
+}
+
+std::vector<UserEquipment> PartitionedLTESimulation::get_final_users() const {
+    return final_users;
+}
+
+std::map<std::string, double> PartitionedLTESimulation::get_statistics() const {
+    std::map<std::string, double> stats;
+    stats["regions"] = num_regions();
+    stats["last_run_ok"] = last_run_ok ? 1.0 : 0.0;
+
+    double handovers = 0.0, migrations = 0.0, overflows = 0.0, border_records = 0.0;
+    for (const auto& kpi : region_kpis) {
+        handovers += kpi.handovers;
+        migrations += kpi.migrations_out;
+        overflows += kpi.ring_overflows;
+        border_records += kpi.border_records_sent;
+    }
+    stats["handovers"] = handovers;
+    stats["migrations"] = migrations;
+    stats["ring_overflows"] = overflows;
+    stats["border_records_sent"] = border_records;
+
+    if (!throughput_history.empty()) {
+        double total = 0.0;
+        for (double value : throughput_history) total += value;
+        stats["average_network_throughput"] = total / throughput_history.size();
+        stats["final_network_throughput"] = throughput_history.back();
+    }
+    return stats;
+}
@@ -0,0 +1,143 @@
+#ifndef LTE_PARTITIONED_H
+#define LTE_PARTITIONED_H
+
+#include "lte_network.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+struct PartitionConfig {
+    int regions_x;
+    int regions_y;
+    double area_width;          // m, plane is [0, area_width) x [0, area_height)
+    double area_height;
+    double halo_width;          // m, border band published to neighbour regions
+    int ring_capacity;          // records per directed neighbour ring
+};
+
+enum class HaloRecordType : int32_t {
+    BORDER_UE,                  // Read-only ghost of a UE near the region edge
+    MIGRATING_UE                // Ownership transfer to the receiving region
+};
+
+// Fixed-size record exchanged through the shared-memory rings
+struct HaloRecord {
+    HaloRecordType type;
+    int32_t ue_id;
+    int32_t serving_cell;
+    int32_t state;
+    double x_position;
+    double y_position;
+    double velocity;
+    double direction;
+    double current_throughput;
+    double average_throughput;
+    double battery_level;
+    int32_t primary_carrier;
+    int32_t max_component_carriers;
+    int32_t cqi;                // Link adaptation state, kept across migration
+    double olla_offset;
+    double tpc_offset;
+    int32_t uplink_first_rb;    // Last uplink transmission, for ghost interference
+    int32_t uplink_num_rbs;
+    double uplink_tx_power_dbm;
+};
+
+struct RegionKPIs {
+    double total_throughput;
+    int64_t handovers;
+    int64_t migrations_out;
+    int64_t migrations_in;
+    int64_t border_records_sent;
+    int64_t ring_overflows;
+    int32_t owned_users;
+    int32_t ghost_users;
+    int32_t completed;
+};
+
+// Runs one LTENetwork per region in a forked worker process. Regions own
+// the cells inside them and the UEs those cells serve, so per-cell
+// scheduling never spans processes; a UE migrates when a handover moves it
+// to a cell owned by another region. Each step runs in two phases around
+// a process-shared barrier. After the measurements, neighbours exchange
+// migrating UEs through SPSC rings in one POSIX shared-memory segment, one
+// region per round until none is in transit, so they are scheduled by their
+// new owner in the same step. After scheduling,
+// neighbours exchange border-UE ghosts, and every region publishes the
+// per-carrier RB activity of its cells as interferer summaries in a shared
+// table that all regions apply to the cells they do not own. Ghosts add
+// their uplink transmissions to the receiving region's uplink interference,
+// one TTI late; migrating UEs carry their link adaptation state.
+// Per-step downlink KPIs are written to shared memory and summed by the
+// parent. They equal a single-process run over a UE list in ue_id order for
+// deterministic mobility (mobility disabled or the Highway model) and
+// instantaneous handovers.
+// Call run() from a single-threaded context: the workers are fork()ed.
+class PartitionedLTESimulation {
+private:
+    PartitionConfig config;
+    LTENetwork template_network;
+    std::vector<UserEquipment> initial_users;
+    std::map<int, int> cell_id_to_region;
+    std::vector<int> cell_ids;                      // Template order, indexes the activity table
+
+    // Directed neighbour rings, ring_index[src * R + dst] or -1
+    std::vector<int> ring_index;
+    std::vector<std::pair<int, int>> rings;
+
+    // Shared segment and the offsets of its sections
+    void* shared_base;
+    size_t shared_size;
+    size_t ring_headers_offset;
+    size_t ring_records_offset;
+    size_t step_throughput_offset;
+    size_t step_active_offset;
+    size_t region_kpis_offset;
+    size_t cell_activity_offset;                    // [carrier * num_cells + cell index]
+    int num_carriers;
+    size_t final_users_offset;
+    std::map<int, int> ue_slot;                     // ue_id -> final_users slot
+
+    // Aggregated results
+    std::vector<double> throughput_history;
+    std::vector<int> active_users_history;
+    std::vector<RegionKPIs> region_kpis;
+    std::vector<UserEquipment> final_users;
+    bool last_run_ok;
+
+    int num_regions() const;
+    int region_of_point(double x, double y) const;
+    int next_hop(int src_region, int dst_region) const;
+    double distance_to_region(double x, double y, int region) const;
+    std::vector<int> get_neighbours(int region) const;
+    void build_rings();
+    bool map_shared_segment(int num_steps);
+    void unmap_shared_segment();
+    void run_worker(int region, int num_steps);
+    void collect_results(int num_steps);
+
+public:
+    PartitionedLTESimulation(const PartitionConfig& config);
+    ~PartitionedLTESimulation();
+
+    PartitionedLTESimulation(const PartitionedLTESimulation&) = delete;
+    PartitionedLTESimulation& operator=(const PartitionedLTESimulation&) = delete;
+
+    // Setup: cells, UEs and network parameters are taken from the template
+    void set_network(const LTENetwork& network);
+    int get_region_of_cell(int cell_id) const;
+
+    // Execution
+    bool run(int num_steps);
+
+    // Results
+    std::vector<double> get_throughput_history() const;
+    std::vector<int> get_active_users_history() const;
+    std::vector<RegionKPIs> get_region_kpis() const;
+    std::vector<UserEquipment> get_final_users() const;
+    std::map<std::string, double> get_statistics() const;
+};
+
+#endif // LTE_PARTITIONED_H
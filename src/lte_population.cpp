@@ -0,0 +1,158 @@
+#include "lte_network.h"
+#include <algorithm>
+
+void LTENetwork::add_cell(const CellInfo& cell) {
+    cells.push_back(cell);
+}
+
+void LTENetwork::add_user(const UserEquipment& user) {
+    users.push_back(user);
+}
+
+void LTENetwork::add_user_ordered(const UserEquipment& user) {
+    // Keeps a list ordered by ue_id ordered; per-index channel state shifts
+    auto position = std::upper_bound(users.begin(), users.end(), user.ue_id,
+                                     [](int ue_id, const UserEquipment& other) { return ue_id < other.ue_id; });
+    users.insert(position, user);
+    csi_serving_cell.clear();
+    uplink_average_throughput.clear();
+}
+
+void LTENetwork::remove_user(int ue_id) {
+    users.erase(std::remove_if(users.begin(), users.end(),
+                               [ue_id](const UserEquipment& user) { return user.ue_id == ue_id; }),
+                users.end());
+    csi_serving_cell.clear();
+    uplink_average_throughput.clear();
+    user_cqi_values.erase(ue_id);
+    user_olla_offsets.erase(ue_id);
+    user_tpc_offsets.erase(ue_id);
+    downlink_buffers.detach(ue_id);
+}
+
+int LTENetwork::find_user_index(int ue_id) {
+    // Checked against the list on every lookup, so any change to users
+    // costs one rebuild rather than a scan per lookup
+    auto it = user_positions.find(ue_id);
+    if (it != user_positions.end() && it->second < static_cast<int>(users.size()) &&
+        users[it->second].ue_id == ue_id) {
+        return it->second;
+    }
+    user_positions.clear();
+    for (size_t i = 0; i < users.size(); i++) {
+        user_positions[users[i].ue_id] = static_cast<int>(i);
+    }
+    it = user_positions.find(ue_id);
+    return it != user_positions.end() ? it->second : -1;
+}
+
+void LTENetwork::set_users(const std::vector<UserEquipment>& new_users) {
+    users = new_users;
+    user_cqi_values.clear();
+    user_olla_offsets.clear();
+    user_tpc_offsets.clear();
+}
+
+void LTENetwork::set_cells(const std::vector<CellInfo>& new_cells) {
+    // Per-cell state is indexed by position and cannot survive a new layout
+    cells = new_cells;
+    cell_activity.assign(cells.size(), 1.0);
+    reported_cell_load.clear();
+    cell_carrier.clear();
+    cell_site_index.reset();
+    handover_signaling.reset();
+    open_handover_entries.clear();  // Their procedures are gone; the entries stay open
+    build_carrier_grids();
+}
+
+void LTENetwork::set_cell_spatial_index(std::shared_ptr<const CellSpatialIndex> index) {
+    // Indices refer to positions in the current cell list
+    cell_site_index = index;
+}
+
+void LTENetwork::set_measurement_radius(double radius_m) {
+    measurement_radius = std::max(radius_m, 0.0);
+}
+
+void LTENetwork::update_cell_load(int cell_id, int load_percentage) {
+    // A reported load replaces the scheduler's activity for this cell on
+    // all its carriers until a negative load hands it back
+    int index = find_cell_index(cell_id);
+    if (index < 0) return;
+    reported_cell_load.resize(cells.size(), -1.0);
+    if (load_percentage < 0) {
+        reported_cell_load[index] = -1.0;
+        return;
+    }
+    reported_cell_load[index] = std::min(load_percentage / 100.0, 1.0);
+    set_cell_activity(index, reported_cell_load[index]);
+    cells[index].load_percentage = load_percentage;
+    apply_reported_loads();
+}
+
+void LTENetwork::update_cell_interference(int cell_id, double interference) {
+    for (auto& cell : cells) {
+        if (cell.cell_id == cell_id) {
+            cell.interference_level = interference;
+            break;
+        }
+    }
+}
+
+std::vector<int> LTENetwork::add_sector_site(double x, double y, int num_sectors,
+                                             double downtilt, double antenna_height) {
+    std::vector<int> cell_ids;
+    int next_id = 0;
+    for (const auto& cell : cells) {
+        next_id = std::max(next_id, cell.cell_id + 1);
+    }
+
+    // Sectors evenly spaced in azimuth, the first pointing north
+    num_sectors = std::max(num_sectors, 1);
+    for (int sector = 0; sector < num_sectors; sector++) {
+        CellInfo cell;
+        cell.cell_id = next_id + sector;
+        cell.signal_strength = -70.0;
+        cell.signal_quality = -10.0;
+        cell.interference_level = 0.05;
+        cell.load_percentage = 0;
+        cell.technology = "LTE";
+        cell.latitude = y;
+        cell.longitude = x;
+        cell.sectorized = num_sectors > 1;
+        cell.azimuth = sector * 360.0 / num_sectors;
+        cell.downtilt = downtilt;
+        cell.antenna_height = antenna_height;
+        cells.push_back(cell);
+        cell_ids.push_back(cell.cell_id);
+    }
+    return cell_ids;
+}
+
+void LTENetwork::configure_sector(int cell_id, double azimuth, double downtilt, double antenna_height) {
+    for (auto& cell : cells) {
+        if (cell.cell_id == cell_id) {
+            cell.sectorized = true;
+            cell.azimuth = azimuth;
+            cell.downtilt = downtilt;
+            cell.antenna_height = antenna_height;
+            break;
+        }
+    }
+}
+
+std::vector<CellInfo> LTENetwork::get_cells() const {
+    return cells;
+}
+
+std::vector<UserEquipment> LTENetwork::get_users() const {
+    return users;
+}
+
+const std::vector<UserEquipment>& LTENetwork::get_users_ref() const {
+    return users;
+}
+
+int LTENetwork::get_handover_count() const {
+    return static_cast<int>(handover_history.size());
+}
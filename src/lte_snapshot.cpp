@@ -0,0 +1,203 @@
+#include "lte_network.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+NetworkSnapshotRCU::NetworkSnapshotRCU() {
+    for (auto& slot : reader_slots) {
+        slot.epoch = 0;
+    }
+    current = nullptr;
+    epoch = 0;
+}
+
+NetworkSnapshotRCU::NetworkSnapshotRCU(const NetworkSnapshotRCU&) : NetworkSnapshotRCU() {
+}
+
+NetworkSnapshotRCU& NetworkSnapshotRCU::operator=(const NetworkSnapshotRCU&) {
+    // The assigned-to network keeps its own epochs; its next step publishes
+    return *this;
+}
+
+NetworkSnapshotRCU::~NetworkSnapshotRCU() {
+    release_all();
+}
+
+void NetworkSnapshotRCU::release_all() {
+    delete current.exchange(nullptr);
+    for (auto& entry : retired) {
+        delete entry.second;
+    }
+    for (auto* snapshot : spare) {
+        delete snapshot;
+    }
+    retired.clear();
+    spare.clear();
+}
+
+void NetworkSnapshotRCU::reclaim() {
+    // Oldest epoch any reader may have entered with
+    uint64_t oldest_reader = UINT64_MAX;
+    for (const auto& slot : reader_slots) {
+        uint64_t reader_epoch = slot.epoch.load();
+        if (reader_epoch != 0) {
+            oldest_reader = std::min(oldest_reader, reader_epoch);
+        }
+    }
+
+    // A snapshot retired at epoch E was unlinked before E was published, so
+    // readers that entered at E or later cannot hold it
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); i++) {
+        if (retired[i].first <= oldest_reader) {
+            spare.push_back(retired[i].second);
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+    retired.resize(kept);
+
+    // Double buffering needs one spare; anything beyond two is freed
+    while (spare.size() > 2) {
+        delete spare.back();
+        spare.pop_back();
+    }
+}
+
+LTENetworkSnapshot* NetworkSnapshotRCU::acquire_write_buffer() {
+    reclaim();
+    if (spare.empty()) {
+        LTENetworkSnapshot* snapshot = new LTENetworkSnapshot();
+        snapshot->epoch = 0;
+        snapshot->step = 0;
+        snapshot->history_generation = 0;
+        snapshot->history_open_from = 0;
+        return snapshot;
+    }
+    LTENetworkSnapshot* snapshot = spare.back();
+    spare.pop_back();
+    return snapshot;
+}
+
+void NetworkSnapshotRCU::publish(LTENetworkSnapshot* snapshot) {
+    uint64_t next_epoch = epoch.load() + 1;
+    snapshot->epoch = next_epoch;
+    LTENetworkSnapshot* previous = current.exchange(snapshot);
+    epoch.store(next_epoch);
+    if (previous) {
+        retired.push_back(std::make_pair(next_epoch, previous));
+    }
+}
+
+const LTENetworkSnapshot* NetworkSnapshotRCU::read_lock(int& slot) const {
+    // Start the slot search at a per-thread offset to keep readers apart
+    int start = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % max_readers);
+    for (;;) {
+        uint64_t entered = std::max<uint64_t>(epoch.load(), 1);
+        for (int k = 0; k < max_readers; k++) {
+            int candidate = (start + k) % max_readers;
+            uint64_t expected = 0;
+            if (reader_slots[candidate].epoch.compare_exchange_strong(expected, entered)) {
+                slot = candidate;
+                return current.load();
+            }
+        }
+        std::this_thread::yield();  // Every slot busy
+    }
+}
+
+void NetworkSnapshotRCU::read_unlock(int slot) const {
+    reader_slots[slot].epoch.store(0, std::memory_order_release);
+}
+
+uint64_t NetworkSnapshotRCU::get_epoch() const {
+    return epoch.load();
+}
+
+void LTENetwork::publish_snapshot() {
+    LTENetworkSnapshot* snapshot = snapshot_rcu.acquire_write_buffer();
+    snapshot->step = step_count;
+    snapshot->cells = cells;
+    snapshot->users = users;
+
+    // The history only grows between resets and an entry never changes
+    // once closed, so a recycled buffer re-copies from the first entry that
+    // was still open when it was last filled
+    size_t open_from = handover_history.size();
+    for (const auto& entry : open_handover_entries) {
+        open_from = std::min(open_from, entry.second);
+    }
+    std::vector<HandoverEvent>& history = snapshot->handover_history;
+    if (snapshot->history_generation != handover_history_generation ||
+        history.size() > handover_history.size()) {
+        history = handover_history;
+        snapshot->history_generation = handover_history_generation;
+    } else {
+        size_t from = std::min(snapshot->history_open_from, history.size());
+        history.resize(from);
+        history.insert(history.end(), handover_history.begin() + from, handover_history.end());
+    }
+    snapshot->history_open_from = open_from;
+
+    snapshot_rcu.publish(snapshot);
+}
+
+void LTENetwork::set_snapshot_interval(int steps) {
+    snapshot_interval = std::max(steps, 0);
+}
+
+int LTENetwork::get_snapshot_interval() const {
+    return snapshot_interval;
+}
+
+LTENetworkSnapshot LTENetwork::get_snapshot() const {
+    LTENetworkSnapshot result;
+    result.epoch = 0;
+    result.step = 0;
+    result.history_generation = 0;
+    result.history_open_from = 0;
+    int slot;
+    const LTENetworkSnapshot* snapshot = snapshot_rcu.read_lock(slot);
+    if (snapshot) {
+        result = *snapshot;
+    }
+    snapshot_rcu.read_unlock(slot);
+    return result;
+}
+
+std::vector<CellInfo> LTENetwork::get_cells_snapshot() const {
+    std::vector<CellInfo> result;
+    int slot;
+    const LTENetworkSnapshot* snapshot = snapshot_rcu.read_lock(slot);
+    if (snapshot) {
+        result = snapshot->cells;
+    }
+    snapshot_rcu.read_unlock(slot);
+    return result;
+}
+
+std::vector<UserEquipment> LTENetwork::get_users_snapshot() const {
+    std::vector<UserEquipment> result;
+    int slot;
+    const LTENetworkSnapshot* snapshot = snapshot_rcu.read_lock(slot);
+    if (snapshot) {
+        result = snapshot->users;
+    }
+    snapshot_rcu.read_unlock(slot);
+    return result;
+}
+
+std::vector<HandoverEvent> LTENetwork::get_handover_history_snapshot() const {
+    std::vector<HandoverEvent> result;
+    int slot;
+    const LTENetworkSnapshot* snapshot = snapshot_rcu.read_lock(slot);
+    if (snapshot) {
+        result = snapshot->handover_history;
+    }
+    snapshot_rcu.read_unlock(slot);
+    return result;
+}
+
+uint64_t LTENetwork::get_snapshot_epoch() const {
+    return snapshot_rcu.get_epoch();
+}
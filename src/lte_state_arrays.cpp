@@ -0,0 +1,52 @@
+#include "lte_network.h"
+
+void LTENetwork::refresh_state_arrays() {
+    size_t num_users = users.size();
+    size_t num_cells = cells.size();
+
+    // Reuse the current block while the shape is unchanged so live views see
+    // the update; otherwise start a new block and leave the old one to its
+    // remaining views
+    if (!state_arrays || state_arrays->ue_ids.size() != num_users ||
+        state_arrays->cell_ids.size() != num_cells) {
+        uint64_t version = state_arrays ? state_arrays->version : 0;
+        state_arrays = std::make_shared<LTEStateArrays>();
+        state_arrays->version = version;
+        state_arrays->ue_ids.resize(num_users);
+        state_arrays->ue_positions.resize(num_users * 2);
+        state_arrays->ue_serving_cell.resize(num_users);
+        state_arrays->ue_throughput.resize(num_users);
+        state_arrays->ue_sinr.resize(num_users);
+        state_arrays->ue_state.resize(num_users);
+        state_arrays->cell_ids.resize(num_cells);
+        state_arrays->cell_load.resize(num_cells);
+    }
+
+    // SINR on each UE's primary carrier, as the scheduler last measured it
+    LTEStateArrays& state = *state_arrays;
+    bool sums_current = interference_sums_current();
+    for (size_t i = 0; i < num_users; i++) {
+        const UserEquipment& user = users[i];
+        state.ue_ids[i] = user.ue_id;
+        state.ue_positions[2 * i] = user.x_position;
+        state.ue_positions[2 * i + 1] = user.y_position;
+        state.ue_serving_cell[i] = user.serving_cell;
+        state.ue_throughput[i] = user.current_throughput;
+        state.ue_sinr[i] = primary_carrier_sinr(i, sums_current);
+        state.ue_state[i] = static_cast<int32_t>(user.state);
+    }
+
+    for (size_t i = 0; i < num_cells; i++) {
+        state.cell_ids[i] = cells[i].cell_id;
+        state.cell_load[i] = cells[i].load_percentage;
+    }
+
+    state.version++;
+}
+
+std::shared_ptr<const LTEStateArrays> LTENetwork::get_state_arrays() {
+    if (!state_arrays) {
+        refresh_state_arrays();
+    }
+    return state_arrays;
+}
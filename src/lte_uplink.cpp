@@ -0,0 +1,306 @@
+#include "lte_network.h"
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+UplinkPowerControl LTENetwork::default_uplink_power_control() {
+    UplinkPowerControl config;
+    config.p0_nominal_dbm = -90.0;
+    config.alpha = 0.8;
+    config.p_max_dbm = 23.0;
+    config.closed_loop = true;
+    config.target_sinr_db = 10.0;
+    config.tpc_step_db = 1.0;
+    config.tpc_max_db = 10.0;
+    config.noise_figure_db = 5.0;
+    config.max_users_per_tti = 8;
+    return config;
+}
+
+void LTENetwork::enable_uplink(bool enable) {
+    uplink_enabled = enable;
+}
+
+void LTENetwork::set_uplink_power_control(const UplinkPowerControl& config) {
+    uplink_pc = config;
+    uplink_pc.alpha = std::min(std::max(config.alpha, 0.0), 1.0);
+    uplink_pc.tpc_max_db = std::max(config.tpc_max_db, 0.0);
+    uplink_pc.max_users_per_tti = std::max(config.max_users_per_tti, 1);
+}
+
+UplinkPowerControl LTENetwork::get_uplink_power_control() const {
+    return uplink_pc;
+}
+
+void LTENetwork::uplink_scheduler() {
+    // FDD uplink on the primary carrier: its upper half of RBs, the ones
+    // the legacy resource block list marks as UPLINK
+    const ComponentCarrier& primary = carriers[0];
+    int num_rbs = primary.num_rbs - primary.num_rbs / 2;
+    int num_cells = static_cast<int>(cells.size());
+    size_t num_users = users.size();
+    if (num_rbs <= 0 || num_cells == 0) return;
+
+    uplink_rbs_per_cell = num_rbs;
+    uplink_rb_owner.assign(static_cast<size_t>(num_cells) * num_rbs, -1);
+    uplink_interference_mw.assign(static_cast<size_t>(num_cells) * num_rbs, 0.0);
+    uplink_tx_power_dbm.assign(num_users, 0.0);
+    uplink_first_rb.assign(num_users, 0);
+    uplink_sinr_db.assign(num_users, 0.0);
+    uplink_num_rbs.assign(num_users, 0);
+    uplink_user_throughput.assign(num_users, 0.0);
+    if (uplink_average_throughput.size() != num_users) {
+        uplink_average_throughput.assign(num_users, 0.0);
+    }
+
+    // Thermal noise per RB (180 kHz in LTE, 12 x SCS in NR) at the receiver
+    double slots_per_ms = static_cast<double>(1 << primary.numerology);
+    double noise_rb_dbm = -174.0 + 10.0 * std::log10(180e3 * slots_per_ms) + uplink_pc.noise_figure_db;
+    double noise_rb_mw = std::pow(10.0, noise_rb_dbm / 10.0);
+
+    // Path loss to the serving cell as the UE estimates it from the DL
+    // reference signal; PF metric on the SINR that fractional power control
+    // would deliver at the serving cell
+    std::vector<std::vector<std::pair<double, int>>> cell_queues(num_cells);
+    std::vector<double> path_loss(num_users, 0.0);
+    std::vector<int> serving_index(num_users, -1);
+    for (size_t u = 0; u < num_users; u++) {
+        const UserEquipment& user = users[u];
+        if (user.state != LTEState::CONNECTED) continue;
+        int index = find_cell_index(user.serving_cell);
+        if (index < 0) continue;
+
+        path_loss[u] = 46.0 - calculate_rsrp_at(user.x_position, user.y_position, cells[index],
+                                                primary.frequency_mhz);
+        serving_index[u] = index;
+        double tpc = get_tpc_offset(user.ue_id);
+        double expected_snr = uplink_pc.p0_nominal_dbm - (1.0 - uplink_pc.alpha) * path_loss[u] + tpc - noise_rb_dbm;
+        int cqi = link_abstraction.select_cqi(expected_snr);
+        if (cqi == 0) continue;
+        double metric = link_abstraction.get_spectral_efficiency(cqi) /
+                        std::max(uplink_average_throughput[u], 0.1);
+        cell_queues[index].push_back({metric, static_cast<int>(u)});
+    }
+
+    // Contiguous (SC-FDMA) allocations: the best PF metrics share the
+    // cell's RBs, each shrunk to what the UE's power headroom can carry
+    std::vector<int> scheduled;
+    std::vector<int>& first_rb = uplink_first_rb;
+    std::vector<double> rb_power_mw(num_users, 0.0);
+    for (int cell = 0; cell < num_cells; cell++) {
+        auto& queue = cell_queues[cell];
+        if (queue.empty()) continue;
+        std::sort(queue.begin(), queue.end(), std::greater<std::pair<double, int>>());
+        int granted = std::min(static_cast<int>(queue.size()), std::min(uplink_pc.max_users_per_tti, num_rbs));
+
+        int next_rb = 0;
+        int32_t* owners = &uplink_rb_owner[static_cast<size_t>(cell) * num_rbs];
+        for (int rank = 0; rank < granted; rank++) {
+            int u = queue[rank].second;
+            double open_loop = uplink_pc.p0_nominal_dbm + uplink_pc.alpha * path_loss[u] +
+                               get_tpc_offset(users[u].ue_id);
+            int share = (num_rbs - next_rb) / (granted - rank);
+            double headroom_rbs = std::pow(10.0, (uplink_pc.p_max_dbm - open_loop) / 10.0);
+            int rbs = std::max(static_cast<int>(std::min(static_cast<double>(share), headroom_rbs)), 1);
+
+            double tx_power = std::min(uplink_pc.p_max_dbm, open_loop + 10.0 * std::log10(static_cast<double>(rbs)));
+            for (int rb = 0; rb < rbs; rb++) {
+                owners[next_rb + rb] = users[u].ue_id;
+            }
+            first_rb[u] = next_rb;
+            uplink_num_rbs[u] = rbs;
+            uplink_tx_power_dbm[u] = tx_power;
+            rb_power_mw[u] = std::pow(10.0, tx_power / 10.0) / rbs;
+            scheduled.push_back(u);
+            next_rb += rbs;
+        }
+    }
+    if (scheduled.empty()) return;
+
+    // Scatter-add every scheduled UE's received power into the cells it
+    // interferes with. Allocations are contiguous, so each UE adds one
+    // +/- pair to a per-cell difference array and a prefix sum per cell
+    // yields the per-RB interference; path gains come one batch per cell.
+    // External transmissions follow the local UEs and only interfere
+    size_t count = scheduled.size();
+    size_t total = count + external_uplink_transmissions.size();
+    std::vector<double> xs(total), ys(total), gain_db(total), power_mw(total);
+    std::vector<int> entry_cell(total), entry_first_rb(total), entry_rbs(total);
+    for (size_t s = 0; s < count; s++) {
+        int u = scheduled[s];
+        xs[s] = users[u].x_position;
+        ys[s] = users[u].y_position;
+        power_mw[s] = rb_power_mw[u];
+        entry_cell[s] = serving_index[u];
+        entry_first_rb[s] = first_rb[u];
+        entry_rbs[s] = uplink_num_rbs[u];
+    }
+    for (size_t e = 0; e < external_uplink_transmissions.size(); e++) {
+        const UplinkTransmission& external = external_uplink_transmissions[e];
+        size_t s = count + e;
+        int start = std::min(std::max(external.first_rb, 0), num_rbs);
+        xs[s] = external.x_position;
+        ys[s] = external.y_position;
+        entry_cell[s] = find_cell_index(external.serving_cell);
+        entry_first_rb[s] = start;
+        entry_rbs[s] = std::min(std::max(external.num_rbs, 0), num_rbs - start);
+        power_mw[s] = entry_rbs[s] > 0 ? std::pow(10.0, external.tx_power_dbm / 10.0) / entry_rbs[s] : 0.0;
+    }
+
+    std::vector<double> signal_mw(count, 0.0);
+    std::vector<double> difference(num_rbs + 1);
+    for (int cell = 0; cell < num_cells; cell++) {
+        calculate_rsrp_batch(xs.data(), ys.data(), total, cells[cell], primary.frequency_mhz, gain_db.data());
+        std::fill(difference.begin(), difference.end(), 0.0);
+        for (size_t s = 0; s < total; s++) {
+            double received = power_mw[s] * std::pow(10.0, (gain_db[s] - 46.0) / 10.0);
+            if (entry_cell[s] == cell) {
+                if (s < count) signal_mw[s] = received;
+                continue;
+            }
+            difference[entry_first_rb[s]] += received;
+            difference[entry_first_rb[s] + entry_rbs[s]] -= received;
+        }
+
+        double running = 0.0;
+        double* interference = &uplink_interference_mw[static_cast<size_t>(cell) * num_rbs];
+        for (int rb = 0; rb < num_rbs; rb++) {
+            running += difference[rb];
+            interference[rb] = std::max(running, 0.0);
+        }
+    }
+
+    // Per-RB SINR at the serving cell, EESM to one link quality, then the
+    // closed loop steers the accumulated TPC towards the target SINR
+    double data_res_per_rb = 144.0;  // 12 subcarriers x 12 symbols, 2 carry DMRS
+    std::vector<double> rb_sinr(num_rbs);
+    for (size_t s = 0; s < count; s++) {
+        int u = scheduled[s];
+        int rbs = uplink_num_rbs[u];
+        const double* interference = &uplink_interference_mw[static_cast<size_t>(serving_index[u]) * num_rbs + first_rb[u]];
+        double mean_sinr_linear = 0.0;
+        for (int rb = 0; rb < rbs; rb++) {
+            double sinr = signal_mw[s] / (interference[rb] + noise_rb_mw);
+            rb_sinr[rb] = 10.0 * std::log10(sinr);
+            mean_sinr_linear += sinr / rbs;
+        }
+
+        int cqi = std::max(link_abstraction.select_cqi(10.0 * std::log10(mean_sinr_linear)), 1);
+        double effective_sinr = link_abstraction.effective_sinr_eesm(rb_sinr.data(), rbs,
+                                                                      link_abstraction.get_eesm_beta(cqi));
+        cqi = link_abstraction.select_cqi(effective_sinr);
+        uplink_sinr_db[u] = effective_sinr;
+        if (cqi > 0) {
+            double bler = link_abstraction.lookup_bler(effective_sinr, cqi);
+            double bits_per_tti = link_abstraction.get_spectral_efficiency(cqi) * data_res_per_rb * rbs;
+            uplink_user_throughput[u] = bits_per_tti * slots_per_ms * (1.0 - bler) / 1000.0;
+        }
+
+        if (uplink_pc.closed_loop) {
+            // Up commands are not accumulated once the UE is at maximum power
+            double& tpc = user_tpc_offsets[users[u].ue_id];
+            double error = uplink_pc.target_sinr_db - effective_sinr;
+            if (error > uplink_pc.tpc_step_db && uplink_tx_power_dbm[u] < uplink_pc.p_max_dbm) {
+                tpc += uplink_pc.tpc_step_db;
+            } else if (error < -uplink_pc.tpc_step_db) {
+                tpc -= uplink_pc.tpc_step_db;
+            }
+            tpc = std::min(std::max(tpc, -uplink_pc.tpc_max_db), uplink_pc.tpc_max_db);
+        }
+    }
+
+    for (size_t u = 0; u < num_users; u++) {
+        uplink_average_throughput[u] = 0.9 * uplink_average_throughput[u] + 0.1 * uplink_user_throughput[u];
+    }
+}
+
+double LTENetwork::get_uplink_throughput(int ue_id) const {
+    for (size_t u = 0; u < users.size() && u < uplink_user_throughput.size(); u++) {
+        if (users[u].ue_id == ue_id) return uplink_user_throughput[u];
+    }
+    return 0.0;
+}
+
+double LTENetwork::get_uplink_tx_power(int ue_id) const {
+    for (size_t u = 0; u < users.size() && u < uplink_tx_power_dbm.size(); u++) {
+        if (users[u].ue_id == ue_id && uplink_num_rbs[u] > 0) return uplink_tx_power_dbm[u];
+    }
+    return -200.0;  // Not scheduled
+}
+
+bool LTENetwork::get_uplink_transmission(int ue_id, UplinkTransmission& transmission) const {
+    for (size_t u = 0; u < users.size() && u < uplink_num_rbs.size(); u++) {
+        if (users[u].ue_id != ue_id) continue;
+        transmission.x_position = users[u].x_position;
+        transmission.y_position = users[u].y_position;
+        transmission.serving_cell = users[u].serving_cell;
+        transmission.first_rb = uplink_first_rb[u];
+        transmission.num_rbs = uplink_num_rbs[u];
+        transmission.tx_power_dbm = uplink_tx_power_dbm[u];
+        return uplink_num_rbs[u] > 0;
+    }
+    return false;
+}
+
+void LTENetwork::set_external_uplink_transmissions(const std::vector<UplinkTransmission>& transmissions) {
+    external_uplink_transmissions = transmissions;
+}
+
+double LTENetwork::get_uplink_sinr(int ue_id) const {
+    for (size_t u = 0; u < users.size() && u < uplink_sinr_db.size(); u++) {
+        if (users[u].ue_id == ue_id) return uplink_sinr_db[u];
+    }
+    return 0.0;
+}
+
+double LTENetwork::get_tpc_offset(int ue_id) const {
+    auto it = user_tpc_offsets.find(ue_id);
+    return it == user_tpc_offsets.end() ? 0.0 : it->second;
+}
+
+std::vector<double> LTENetwork::get_uplink_interference(int cell_id) const {
+    std::vector<double> per_rb;
+    int index = find_cell_index(cell_id);
+    if (index < 0 || uplink_interference_mw.size() < static_cast<size_t>(index + 1) * uplink_rbs_per_cell) {
+        return per_rb;
+    }
+
+    per_rb.resize(uplink_rbs_per_cell);
+    for (int rb = 0; rb < uplink_rbs_per_cell; rb++) {
+        double interference = uplink_interference_mw[static_cast<size_t>(index) * uplink_rbs_per_cell + rb];
+        per_rb[rb] = interference > 0.0 ? 10.0 * std::log10(interference) : -200.0;  // dBm
+    }
+    return per_rb;
+}
+
+std::map<std::string, double> LTENetwork::get_uplink_statistics() const {
+    std::map<std::string, double> stats;
+    int scheduled = 0, power_limited = 0;
+    double total_throughput = 0.0, power_sum = 0.0, sinr_sum = 0.0;
+    for (size_t u = 0; u < uplink_num_rbs.size(); u++) {
+        if (uplink_num_rbs[u] == 0) continue;
+        scheduled++;
+        total_throughput += uplink_user_throughput[u];
+        power_sum += uplink_tx_power_dbm[u];
+        sinr_sum += uplink_sinr_db[u];
+        if (uplink_tx_power_dbm[u] >= uplink_pc.p_max_dbm) power_limited++;
+    }
+
+    // Interference over thermal, averaged over all uplink RBs in linear terms
+    double rb_hz = carriers.empty() ? 180e3 : 180e3 * (1 << carriers[0].numerology);
+    double noise_rb_mw = std::pow(10.0, (-174.0 + 10.0 * std::log10(rb_hz) + uplink_pc.noise_figure_db) / 10.0);
+    double iot_sum = 0.0;
+    for (double interference : uplink_interference_mw) {
+        iot_sum += (interference + noise_rb_mw) / noise_rb_mw;
+    }
+
+    stats["scheduled_users"] = scheduled;
+    stats["uplink_throughput"] = total_throughput;
+    stats["mean_tx_power_dbm"] = scheduled > 0 ? power_sum / scheduled : 0.0;
+    stats["mean_sinr_db"] = scheduled > 0 ? sinr_sum / scheduled : 0.0;
+    stats["power_limited_fraction"] = scheduled > 0 ? static_cast<double>(power_limited) / scheduled : 0.0;
+    stats["mean_iot_db"] = uplink_interference_mw.empty() ? 0.0 :
+                           10.0 * std::log10(iot_sum / uplink_interference_mw.size());
+    stats["rbs_per_cell"] = uplink_rbs_per_cell;
+    return stats;
+}
@@ -0,0 +1,121 @@
+#include "metric_registry.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+const char* builtin_names[METRIC_BUILTIN_COUNT] = {
+    "signal_strength", "interference", "congestion", "congestion_level", "utilization", "delay",
+    "error_rate", "correction_strength", "mobility_speed", "battery_level", "latency",
+    "energy_consumption", "traffic_load", "power_save_mode", "reduce_transmission_power", "trigger_rsrp"
+};
+
+struct RegistryTable {
+    std::mutex mutex;
+    std::unordered_map<std::string, int> ids;
+    std::string names[MetricRegistry::MAX_METRICS];
+    std::atomic<int> count;
+
+    RegistryTable() {
+        for (int id = 0; id < METRIC_BUILTIN_COUNT; id++) {
+            names[id] = builtin_names[id];
+            ids[names[id]] = id;
+        }
+        count.store(METRIC_BUILTIN_COUNT);
+    }
+};
+
+RegistryTable& table() {
+    static RegistryTable registry;
+    return registry;
+}
+
+int popcount64(uint64_t bits) {
+    int count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+}
+
+} // namespace
+
+int MetricRegistry::intern(const std::string& name) {
+    RegistryTable& registry = table();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    if (it != registry.ids.end()) return it->second;
+
+    int id = registry.count.load(std::memory_order_relaxed);
+    if (id >= MAX_METRICS) return -1;
+    registry.names[id] = name;
+    registry.ids[name] = id;
+    // Publishes the name before the ID becomes visible through size()
+    registry.count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+int MetricRegistry::find(const std::string& name) {
+    RegistryTable& registry = table();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    return it != registry.ids.end() ? it->second : -1;
+}
+
+const std::string& MetricRegistry::name(int id) {
+    static const std::string unknown;
+    RegistryTable& registry = table();
+    if (id < 0 || id >= registry.count.load(std::memory_order_acquire)) return unknown;
+    return registry.names[id];
+}
+
+int MetricRegistry::size() {
+    return table().count.load(std::memory_order_acquire);
+}
+
+MetricSet::MetricSet() {
+    present = 0;
+    for (int id = 0; id < MetricRegistry::MAX_METRICS; id++) {
+        values[id] = 0.0;
+    }
+}
+
+size_t MetricSet::size() const {
+    return popcount64(present);
+}
+
+bool MetricSet::has(const std::string& name) const {
+    return has(MetricRegistry::find(name));
+}
+
+double MetricSet::get(const std::string& name, double fallback) const {
+    return get(MetricRegistry::find(name), fallback);
+}
+
+bool MetricSet::set(const std::string& name, double value) {
+    int id = MetricRegistry::intern(name);
+    if (id < 0) return false;
+    set(id, value);
+    return true;
+}
+
+std::map<std::string, double> MetricSet::to_map() const {
+    std::map<std::string, double> metrics;
+    for (int id = 0; id < MetricRegistry::MAX_METRICS; id++) {
+        if (has(id)) metrics[MetricRegistry::name(id)] = values[id];
+    }
+    return metrics;
+}
+
+MetricSet MetricSet::from_map(const std::map<std::string, double>& metrics,
+                              std::vector<std::string>* dropped) {
+    MetricSet set;
+    for (const auto& metric : metrics) {
+        if (!set.set(metric.first, metric.second) && dropped) {
+            dropped->push_back(metric.first);
+        }
+    }
+    return set;
+}
@@ -0,0 +1,84 @@
+#ifndef METRIC_REGISTRY_H
+#define METRIC_REGISTRY_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Metrics the cross-layer optimizer reads and writes, pre-interned in this
+// order so C++ code can index slots without a lookup
+enum MetricId {
+    METRIC_SIGNAL_STRENGTH,
+    METRIC_INTERFERENCE,
+    METRIC_CONGESTION,
+    METRIC_CONGESTION_LEVEL,
+    METRIC_UTILIZATION,
+    METRIC_DELAY,
+    METRIC_ERROR_RATE,
+    METRIC_CORRECTION_STRENGTH,
+    METRIC_MOBILITY_SPEED,
+    METRIC_BATTERY_LEVEL,
+    METRIC_LATENCY,
+    METRIC_ENERGY_CONSUMPTION,
+    METRIC_TRAFFIC_LOAD,
+    METRIC_POWER_SAVE_MODE,
+    METRIC_REDUCE_TRANSMISSION_POWER,
+    METRIC_TRIGGER_RSRP,
+    METRIC_BUILTIN_COUNT
+};
+
+// Process-wide table interning metric names to small integer IDs. Names
+// are never removed, so an ID stays valid for the life of the process.
+class MetricRegistry {
+public:
+    static const int MAX_METRICS = 64;  // One presence bit per slot
+
+    // ID for name, registering it if new; -1 once the table is full
+    static int intern(const std::string& name);
+    // ID for a registered name, -1 otherwise
+    static int find(const std::string& name);
+    static const std::string& name(int id);
+    static int size();
+};
+
+// Fixed-slot metric values with presence bits. Copying and updating never
+// allocate; the string-keyed members exist for Python and configuration.
+class MetricSet {
+private:
+    uint64_t present;
+    double values[MetricRegistry::MAX_METRICS];
+
+public:
+    MetricSet();
+
+    bool has(int id) const {
+        return id >= 0 && id < MetricRegistry::MAX_METRICS && (present >> id) & 1u;
+    }
+    double get(int id, double fallback) const {
+        return has(id) ? values[id] : fallback;
+    }
+    void set(int id, double value) {
+        if (id < 0 || id >= MetricRegistry::MAX_METRICS) return;
+        values[id] = value;
+        present |= uint64_t(1) << id;
+    }
+    void erase(int id) {
+        if (id >= 0 && id < MetricRegistry::MAX_METRICS) present &= ~(uint64_t(1) << id);
+    }
+    void clear() { present = 0; }
+    bool empty() const { return present == 0; }
+    uint64_t presence() const { return present; }
+    size_t size() const;
+
+    // String-keyed adapter; set returns false if the registry is full, and
+    // from_map lists the names it had to leave out in dropped
+    bool has(const std::string& name) const;
+    double get(const std::string& name, double fallback) const;
+    bool set(const std::string& name, double value);
+    std::map<std::string, double> to_map() const;
+    static MetricSet from_map(const std::map<std::string, double>& metrics,
+                              std::vector<std::string>* dropped = nullptr);
+};
+
+#endif // METRIC_REGISTRY_H
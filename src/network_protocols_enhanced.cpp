@@ -2,6 +2,7 @@
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
 #include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
 #include <string>
 #include <vector>
 #include <memory>
@@ -11,13 +12,129 @@ namespace py = pybind11;
 // Include all protocol implementations
 #include "tcp_tahoe.h"
 #include "tcp_tahoe_enhanced.cpp"
+#include "metric_registry.h"
+#include "metric_registry.cpp"
+#include "hdr_histogram.h"
+#include "hdr_histogram.cpp"
 #include "cross_layer_protocol.h"
 #include "cross_layer_protocol.cpp"
+#include "cross_layer_bus.h"
+#include "cross_layer_bus.cpp"
+#include "transport_flow_table.h"
+#include "transport_flow_table.cpp"
+#include "policy_engine.h"
+#include "policy_engine.cpp"
+#include "policy_tuner.h"
+#include "policy_tuner.cpp"
 #include "lte_network.h"
 #include "lte_network_core.cpp"
+#include "lte_channel_model.cpp"
+#include "link_abstraction.h"
+#include "link_abstraction.cpp"
+#include "antenna_pattern.h"
+#include "antenna_pattern.cpp"
+#include "lte_link_adaptation.cpp"
+#include "lte_state_arrays.cpp"
+#include "lte_population.cpp"
+#include "lte_snapshot.cpp"
+#include "lte_carrier_aggregation.cpp"
+#include "lte_uplink.cpp"
+#include "lte_nr.cpp"
+#include "lte_partitioned.h"
+#include "lte_partitioned.cpp"
+#include "rach_simulator.h"
+#include "rach_simulator.cpp"
+#include "cell_spatial_index.h"
+#include "cell_spatial_index.cpp"
+#include "coverage_map.h"
+#include "coverage_map.cpp"
+#include "cell_importer.h"
+#include "cell_importer.cpp"
+#include "realtime_runner.h"
+#include "realtime_runner.cpp"
+#include "rlc_buffer.h"
+#include "rlc_buffer.cpp"
+#include "lte_buffers.cpp"
+#include "handover_signaling.h"
+#include "handover_signaling.cpp"
 #include "validation_framework.h"
 #include "network_logger.h"
 
+// Read-only numpy view sharing memory with a shared block (LTEStateArrays,
+// CoverageMap); the capsule holds a reference so the block outlives the
+// owner's next resize
+template <typename T, typename Block>
+static py::array make_state_view(const std::shared_ptr<const Block>& state,
+                                 const std::vector<T>& data, std::vector<py::ssize_t> shape) {
+    py::capsule owner(new std::shared_ptr<const Block>(state), [](void* p) {
+        delete static_cast<std::shared_ptr<const Block>*>(p);
+    });
+    py::array_t<T> view(shape, data.data(), owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+// Python dict -> MetricSet; names that no longer fit the registry raise
+static MetricSet metric_set_from_dict(const std::map<std::string, double>& metrics) {
+    std::vector<std::string> dropped;
+    MetricSet set = MetricSet::from_map(metrics, &dropped);
+    if (!dropped.empty()) {
+        std::string names;
+        for (const std::string& name : dropped) names += (names.empty() ? "" : ", ") + name;
+        throw py::value_error("Metric registry full (" + std::to_string(MetricRegistry::MAX_METRICS) +
+                              " names); dropped: " + names);
+    }
+    return set;
+}
+
+// Live views: updated in place by each step while the UE/cell counts hold
+static py::dict lte_state_view(LTENetwork& network) {
+    std::shared_ptr<const LTEStateArrays> state = network.get_state_arrays();
+    py::ssize_t num_users = static_cast<py::ssize_t>(state->ue_ids.size());
+    py::ssize_t num_cells = static_cast<py::ssize_t>(state->cell_ids.size());
+
+    py::dict view;
+    view["version"] = state->version;
+    view["ue_ids"] = make_state_view(state, state->ue_ids, {num_users});
+    view["positions"] = make_state_view(state, state->ue_positions, {num_users, 2});
+    view["serving_cell"] = make_state_view(state, state->ue_serving_cell, {num_users});
+    view["throughput"] = make_state_view(state, state->ue_throughput, {num_users});
+    view["sinr"] = make_state_view(state, state->ue_sinr, {num_users});
+    view["state"] = make_state_view(state, state->ue_state, {num_users});
+    view["cell_ids"] = make_state_view(state, state->cell_ids, {num_cells});
+    view["cell_load"] = make_state_view(state, state->cell_load, {num_cells});
+    return view;
+}
+
+// Coverage rasters as (height, width) arrays, row 0 at y_min
+static py::dict coverage_map_arrays(CoverageMapGenerator& generator, const LTENetwork& network,
+                                    const CoverageMapConfig& config) {
+    std::shared_ptr<const CoverageMap> map;
+    {
+        py::gil_scoped_release release;
+        map = generator.generate(network, config);
+    }
+    std::vector<py::ssize_t> shape = {map->height, map->width};
+
+    py::dict arrays;
+    arrays["rsrp"] = make_state_view(map, map->rsrp_dbm, shape);
+    arrays["sinr"] = make_state_view(map, map->sinr_db, shape);
+    arrays["best_server"] = make_state_view(map, map->best_server, shape);
+    arrays["tiles_computed"] = map->tiles_computed;
+    arrays["tiles_cached"] = map->tiles_cached;
+    return arrays;
+}
+
+// Snapshot: owned, writeable copies frozen at the current version
+static py::dict lte_state_snapshot(LTENetwork& network) {
+    py::dict snapshot;
+    for (auto item : lte_state_view(network)) {
+        py::object value = py::reinterpret_borrow<py::object>(item.second);
+        snapshot[item.first] = py::isinstance<py::array>(value) ? value.attr("copy")() : value;
+    }
+    return snapshot;
+}
+
 PYBIND11_MODULE(network_protocols_enhanced, m) {
     m.doc() = "Enhanced Network Protocol Simulator with TCP variants, Cross-layer optimization, LTE, Validation, and Logging";
     
@@ -62,6 +179,11 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .value("LTE_TO_3G", HandoverType::LTE_TO_3G)
         .value("LTE_TO_WIFI", HandoverType::LTE_TO_WIFI);
     
+    py::enum_<ModulationScheme>(m, "ModulationScheme")
+        .value("QPSK", ModulationScheme::QPSK)
+        .value("QAM16", ModulationScheme::QAM16)
+        .value("QAM64", ModulationScheme::QAM64);
+    
     py::enum_<ValidationLevel>(m, "ValidationLevel")
         .value("BASIC", ValidationLevel::BASIC)
         .value("STANDARD", ValidationLevel::STANDARD)
@@ -120,6 +242,9 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def("get_current_throughput", &TCPTahoe::get_current_throughput)
         .def("get_packet_loss_rate", &TCPTahoe::get_packet_loss_rate)
         .def("get_network_utilization", &TCPTahoe::get_network_utilization)
+        .def("get_current_rtt", &TCPTahoe::get_current_rtt)
+        .def("get_algorithm_switch_count", &TCPTahoe::get_algorithm_switch_count)
+        .def("update_rtt", &TCPTahoe::update_rtt)
         .def("set_algorithm", &TCPTahoe::set_algorithm)
         .def("reset", &TCPTahoe::reset);
     
@@ -128,7 +253,11 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def(py::init<>())
         .def_readwrite("layer", &LayerInfo::layer)
         .def_readwrite("status", &LayerInfo::status)
-        .def_readwrite("metrics", &LayerInfo::metrics)
+        .def_property("metrics",
+            [](const LayerInfo& info) { return info.metrics.to_map(); },
+            [](LayerInfo& info, const std::map<std::string, double>& metrics) {
+                info.metrics = metric_set_from_dict(metrics);
+            })
         .def_readwrite("timestamp", &LayerInfo::timestamp);
     
     py::class_<CrossLayerMessage>(m, "CrossLayerMessage")
@@ -136,7 +265,11 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def_readwrite("source", &CrossLayerMessage::source)
         .def_readwrite("destination", &CrossLayerMessage::destination)
         .def_readwrite("event", &CrossLayerMessage::event)
-        .def_readwrite("parameters", &CrossLayerMessage::parameters)
+        .def_property("parameters",
+            [](const CrossLayerMessage& message) { return message.parameters.to_map(); },
+            [](CrossLayerMessage& message, const std::map<std::string, double>& parameters) {
+                message.parameters = metric_set_from_dict(parameters);
+            })
         .def_readwrite("timestamp", &CrossLayerMessage::timestamp)
         .def_readwrite("message", &CrossLayerMessage::message);
     
@@ -149,7 +282,11 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def_readwrite("load_percentage", &CellInfo::load_percentage)
         .def_readwrite("technology", &CellInfo::technology)
         .def_readwrite("latitude", &CellInfo::latitude)
-        .def_readwrite("longitude", &CellInfo::longitude);
+        .def_readwrite("longitude", &CellInfo::longitude)
+        .def_readwrite("sectorized", &CellInfo::sectorized)
+        .def_readwrite("azimuth", &CellInfo::azimuth)
+        .def_readwrite("downtilt", &CellInfo::downtilt)
+        .def_readwrite("antenna_height", &CellInfo::antenna_height);
     
     py::class_<UserEquipment>(m, "UserEquipment")
         .def(py::init<>())
@@ -161,10 +298,188 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def_readwrite("serving_cell", &UserEquipment::serving_cell)
         .def_readwrite("state", &UserEquipment::state)
         .def_readwrite("current_throughput", &UserEquipment::current_throughput)
-        .def_readwrite("battery_level", &UserEquipment::battery_level);
+        .def_readwrite("average_throughput", &UserEquipment::average_throughput)
+        .def_readwrite("battery_level", &UserEquipment::battery_level)
+        .def_readwrite("primary_carrier", &UserEquipment::primary_carrier)
+        .def_readwrite("max_component_carriers", &UserEquipment::max_component_carriers);
+    
+    py::class_<ComponentCarrier>(m, "ComponentCarrier")
+        .def(py::init<>())
+        .def_readwrite("carrier_id", &ComponentCarrier::carrier_id)
+        .def_readwrite("frequency_mhz", &ComponentCarrier::frequency_mhz)
+        .def_readwrite("bandwidth_mhz", &ComponentCarrier::bandwidth_mhz)
+        .def_readwrite("num_rbs", &ComponentCarrier::num_rbs)
+        .def_readwrite("numerology", &ComponentCarrier::numerology);
+    
+    py::class_<HandoverSignalingConfig>(m, "HandoverSignalingConfig")
+        .def(py::init(&HandoverSignaling::default_config))
+        .def_readwrite("enabled", &HandoverSignalingConfig::enabled)
+        .def_readwrite("x2_latency_ms", &HandoverSignalingConfig::x2_latency_ms)
+        .def_readwrite("s1_latency_ms", &HandoverSignalingConfig::s1_latency_ms)
+        .def_readwrite("air_latency_ms", &HandoverSignalingConfig::air_latency_ms)
+        .def_readwrite("rach_ms", &HandoverSignalingConfig::rach_ms)
+        .def_readwrite("enb_processing_ms", &HandoverSignalingConfig::enb_processing_ms)
+        .def_readwrite("mme_processing_ms", &HandoverSignalingConfig::mme_processing_ms)
+        .def_readwrite("preparation_timeout_ms", &HandoverSignalingConfig::preparation_timeout_ms);
+    
+    py::class_<TransportFlowConfig>(m, "TransportFlowConfig")
+        .def(py::init(&TransportFlowTable::default_config))
+        .def_readwrite("base_rtt_ms", &TransportFlowConfig::base_rtt_ms)
+        .def_readwrite("mss_bytes", &TransportFlowConfig::mss_bytes)
+        .def_readwrite("initial_cwnd", &TransportFlowConfig::initial_cwnd)
+        .def_readwrite("buffer_bdp_factor", &TransportFlowConfig::buffer_bdp_factor)
+        .def_readwrite("min_buffer_bytes", &TransportFlowConfig::min_buffer_bytes)
+        .def_readwrite("rto_ms", &TransportFlowConfig::rto_ms)
+        .def_readwrite("reset_on_handover", &TransportFlowConfig::reset_on_handover);
+    
+    py::class_<TransportFlowTotals>(m, "TransportFlowTotals")
+        .def_readonly("flows", &TransportFlowTotals::flows)
+        .def_readonly("paused_flows", &TransportFlowTotals::paused_flows)
+        .def_readonly("goodput_mbps", &TransportFlowTotals::goodput_mbps)
+        .def_readonly("bottleneck_mbps", &TransportFlowTotals::bottleneck_mbps)
+        .def_readonly("queued_bytes", &TransportFlowTotals::queued_bytes)
+        .def_readonly("bytes_delivered", &TransportFlowTotals::bytes_delivered)
+        .def_readonly("mean_rtt_ms", &TransportFlowTotals::mean_rtt_ms)
+        .def_readonly("mean_cwnd", &TransportFlowTotals::mean_cwnd)
+        .def_readonly("mean_sinr_db", &TransportFlowTotals::mean_sinr_db)
+        .def_readonly("mean_utilization", &TransportFlowTotals::mean_utilization);
+    
+    py::class_<TransportFlowTable>(m, "TransportFlowTable")
+        .def("size", &TransportFlowTable::size)
+        .def("get_config", &TransportFlowTable::get_config)
+        .def("get_ue_ids", &TransportFlowTable::get_ue_ids)
+        .def("get_cwnd", &TransportFlowTable::get_cwnd)
+        .def("get_rtt", &TransportFlowTable::get_rtt)
+        .def("get_goodput", &TransportFlowTable::get_goodput)
+        .def("get_queue_bytes", &TransportFlowTable::get_queue_bytes)
+        .def("get_paused", &TransportFlowTable::get_paused)
+        .def("get_interruption_times", &TransportFlowTable::get_interruption_times)
+        .def("get_totals", &TransportFlowTable::get_totals, py::return_value_policy::reference_internal)
+        .def("get_statistics", &TransportFlowTable::get_statistics);
+    
+    py::class_<PolicyEngine>(m, "PolicyEngine")
+        .def(py::init<>())
+        .def("load_string", &PolicyEngine::load_string)
+        .def("load_file", &PolicyEngine::load_file)
+        .def("reload_if_changed", &PolicyEngine::reload_if_changed)
+        .def("clear", &PolicyEngine::clear)
+        .def("is_loaded", &PolicyEngine::is_loaded)
+        .def("get_last_error", &PolicyEngine::get_last_error)
+        .def("get_source_path", &PolicyEngine::get_source_path)
+        .def("get_rule_count", &PolicyEngine::get_rule_count)
+        .def("get_rule_names", &PolicyEngine::get_rule_names)
+        .def("get_action_names", &PolicyEngine::get_action_names)
+        // Metric name -> 1-D array (one value per row) or number (all rows);
+        // returns action name -> array, plus "rule" (first match, -1 none)
+        .def("evaluate", [](PolicyEngine& engine, py::dict metrics) {
+            typedef py::array_t<double, py::array::c_style | py::array::forcecast> Column;
+            std::vector<std::pair<int, Column>> columns;
+            std::vector<std::pair<int, double>> scalars;
+            py::ssize_t rows = -1;
+            for (auto item : metrics) {
+                // Names no rule reads are ignored rather than interned
+                int metric = MetricRegistry::find(py::cast<std::string>(item.first));
+                if (metric < 0) continue;
+                py::object value = py::reinterpret_borrow<py::object>(item.second);
+                if (py::isinstance<py::float_>(value) || py::isinstance<py::int_>(value)) {
+                    scalars.push_back(std::make_pair(metric, py::cast<double>(value)));
+                    continue;
+                }
+                Column column = Column::ensure(value);
+                if (!column || column.ndim() != 1) throw py::value_error("Policy inputs must be 1-D arrays or numbers");
+                if (rows >= 0 && column.shape(0) != rows) throw py::value_error("Policy input arrays differ in length");
+                rows = column.shape(0);
+                columns.push_back(std::make_pair(metric, column));
+            }
+            PolicyInputs inputs(rows < 0 ? 1 : static_cast<size_t>(rows));
+            for (const auto& scalar : scalars) inputs.set_scalar(scalar.first, scalar.second);
+            for (const auto& column : columns) inputs.set_column(column.first, column.second.data());
+            {
+                py::gil_scoped_release release;
+                engine.evaluate(inputs);
+            }
+            py::dict actions;
+            for (const std::string& name : engine.get_action_names()) {
+                std::vector<double> values = engine.get_action(name);
+                actions[py::str(name)] = py::array_t<double>(values.size(), values.data());
+            }
+            const std::vector<int32_t>& rules = engine.get_matched_rules();
+            actions["rule"] = py::array_t<int32_t>(rules.size(), rules.data());
+            return actions;
+        })
+        .def("get_statistics", &PolicyEngine::get_statistics);
+    
+    py::class_<OptimizationThresholds>(m, "OptimizationThresholds")
+        .def(py::init(&CrossLayerOptimizer::default_thresholds))
+        .def_readwrite("poor_signal_dbm", &OptimizationThresholds::poor_signal_dbm)
+        .def_readwrite("good_signal_dbm", &OptimizationThresholds::good_signal_dbm)
+        .def_readwrite("good_interference", &OptimizationThresholds::good_interference)
+        .def_readwrite("high_congestion", &OptimizationThresholds::high_congestion)
+        .def_readwrite("congestion_response", &OptimizationThresholds::congestion_response)
+        .def_readwrite("high_loss_rate", &OptimizationThresholds::high_loss_rate)
+        .def_readwrite("low_loss_rate", &OptimizationThresholds::low_loss_rate)
+        .def_readwrite("low_throughput_mbps", &OptimizationThresholds::low_throughput_mbps)
+        .def_readwrite("high_error_rate", &OptimizationThresholds::high_error_rate)
+        .def_readwrite("robust_error_rate", &OptimizationThresholds::robust_error_rate)
+        .def_readwrite("high_mobility_kmh", &OptimizationThresholds::high_mobility_kmh)
+        .def_readwrite("low_mobility_kmh", &OptimizationThresholds::low_mobility_kmh)
+        .def_readwrite("low_battery", &OptimizationThresholds::low_battery);
+    
+    py::class_<PolicyCandidate>(m, "PolicyCandidate")
+        .def(py::init(&PolicyTuner::default_candidate))
+        .def_readwrite("thresholds", &PolicyCandidate::thresholds)
+        .def("set_parameter", [](PolicyCandidate& candidate, const std::string& name, double value) {
+            return PolicyTuner::set_parameter(candidate, name, value);
+        });
+    
+    py::class_<PolicyScore>(m, "PolicyScore")
+        .def_readonly("candidate", &PolicyScore::candidate)
+        .def_readonly("throughput_mbps", &PolicyScore::throughput_mbps)
+        .def_readonly("latency_ms", &PolicyScore::latency_ms)
+        .def_readonly("energy_mj", &PolicyScore::energy_mj)
+        .def_readonly("throughput_stddev", &PolicyScore::throughput_stddev)
+        .def_readonly("score", &PolicyScore::score)
+        .def_readonly("pareto_optimal", &PolicyScore::pareto_optimal);
+    
+    py::class_<PolicySearchConfig>(m, "PolicySearchConfig")
+        .def(py::init(&PolicyTuner::default_config))
+        .def_readwrite("num_seeds", &PolicySearchConfig::num_seeds)
+        .def_readwrite("steps", &PolicySearchConfig::steps)
+        .def_readwrite("optimize_interval", &PolicySearchConfig::optimize_interval)
+        .def_readwrite("num_threads", &PolicySearchConfig::num_threads)
+        .def_readwrite("base_seed", &PolicySearchConfig::base_seed)
+        .def_readwrite("weight_throughput", &PolicySearchConfig::weight_throughput)
+        .def_readwrite("weight_latency", &PolicySearchConfig::weight_latency)
+        .def_readwrite("weight_energy", &PolicySearchConfig::weight_energy);
+    
+    py::class_<PolicyTuner>(m, "PolicyTuner")
+        .def(py::init<>())
+        .def(py::init<const PolicySearchConfig&>())
+        .def("set_config", &PolicyTuner::set_config)
+        .def("get_config", &PolicyTuner::get_config)
+        .def_static("parameter_names", &PolicyTuner::parameter_names)
+        .def("evaluate", &PolicyTuner::evaluate, py::call_guard<py::gil_scoped_release>())
+        .def("grid_search", &PolicyTuner::grid_search, py::call_guard<py::gil_scoped_release>())
+        .def("random_search", &PolicyTuner::random_search, py::call_guard<py::gil_scoped_release>())
+        .def("get_last_error", &PolicyTuner::get_last_error)
+        .def_static("pareto_front", &PolicyTuner::pareto_front)
+        .def("apply", &PolicyTuner::apply);
+    
+    py::class_<UplinkPowerControl>(m, "UplinkPowerControl")
+        .def(py::init(&LTENetwork::default_uplink_power_control))
+        .def_readwrite("p0_nominal_dbm", &UplinkPowerControl::p0_nominal_dbm)
+        .def_readwrite("alpha", &UplinkPowerControl::alpha)
+        .def_readwrite("p_max_dbm", &UplinkPowerControl::p_max_dbm)
+        .def_readwrite("closed_loop", &UplinkPowerControl::closed_loop)
+        .def_readwrite("target_sinr_db", &UplinkPowerControl::target_sinr_db)
+        .def_readwrite("tpc_step_db", &UplinkPowerControl::tpc_step_db)
+        .def_readwrite("tpc_max_db", &UplinkPowerControl::tpc_max_db)
+        .def_readwrite("noise_figure_db", &UplinkPowerControl::noise_figure_db)
+        .def_readwrite("max_users_per_tti", &UplinkPowerControl::max_users_per_tti);
     
     py::class_<HandoverEvent>(m, "HandoverEvent")
         .def(py::init<>())
+        .def_readwrite("ue_id", &HandoverEvent::ue_id)
         .def_readwrite("source_cell", &HandoverEvent::source_cell)
         .def_readwrite("target_cell", &HandoverEvent::target_cell)
         .def_readwrite("type", &HandoverEvent::type)
@@ -175,6 +490,22 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def_readwrite("success", &HandoverEvent::success)
         .def_readwrite("failure_reason", &HandoverEvent::failure_reason);
     
+    py::class_<LTENetworkSnapshot>(m, "LTENetworkSnapshot")
+        .def_readonly("epoch", &LTENetworkSnapshot::epoch)
+        .def_readonly("step", &LTENetworkSnapshot::step)
+        .def_readonly("cells", &LTENetworkSnapshot::cells)
+        .def_readonly("users", &LTENetworkSnapshot::users)
+        .def_readonly("handover_history", &LTENetworkSnapshot::handover_history);
+    
+    py::class_<CQIEntry>(m, "CQIEntry")
+        .def(py::init<>())
+        .def_readwrite("cqi", &CQIEntry::cqi)
+        .def_readwrite("modulation", &CQIEntry::modulation)
+        .def_readwrite("code_rate_x1024", &CQIEntry::code_rate_x1024)
+        .def_readwrite("spectral_efficiency", &CQIEntry::spectral_efficiency)
+        .def_readwrite("sinr_threshold_db", &CQIEntry::sinr_threshold_db)
+        .def_readwrite("eesm_beta", &CQIEntry::eesm_beta);
+    
     py::class_<LogEntry>(m, "LogEntry")
         .def(py::init<>())
         .def_readwrite("timestamp", &LogEntry::timestamp)
@@ -193,14 +524,44 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
     // Cross Layer Optimizer binding
     py::class_<CrossLayerOptimizer>(m, "CrossLayerOptimizer")
         .def(py::init<>())
+        .def("register_layer", [](CrossLayerOptimizer& optimizer, LayerType layer, std::shared_ptr<LTENetwork> network) {
+            optimizer.register_layer(layer, network);
+        })
         .def("register_layer", &CrossLayerOptimizer::register_layer)
         .def("update_layer_state", &CrossLayerOptimizer::update_layer_state)
         .def("get_layer_state", &CrossLayerOptimizer::get_layer_state)
         .def("send_cross_layer_message", &CrossLayerOptimizer::send_cross_layer_message)
         .def("register_event_handler", &CrossLayerOptimizer::register_event_handler)
+        .def("subscribe", [](CrossLayerOptimizer& optimizer, CrossLayerEvent event, LayerType destination,
+                             std::function<void(const CrossLayerMessage&)> handler) {
+            return optimizer.subscribe(event, destination,
+                CrossLayerHandler([handler](const CrossLayerMessage& message, const CrossLayerPayload&) {
+                    handler(message);
+                }));
+        })
+        .def("unsubscribe", &CrossLayerOptimizer::unsubscribe)
+        .def("get_subscriber_count", &CrossLayerOptimizer::get_subscriber_count)
         .def("get_message_history", &CrossLayerOptimizer::get_message_history)
+        .def("set_batched_dispatch", &CrossLayerOptimizer::set_batched_dispatch)
+        .def("dispatch_pending_messages", &CrossLayerOptimizer::dispatch_pending_messages)
+        .def("set_dispatch_limits", &CrossLayerOptimizer::set_dispatch_limits)
+        .def("set_message_history_capacity", &CrossLayerOptimizer::set_message_history_capacity)
+        .def("get_pending_message_count", &CrossLayerOptimizer::get_pending_message_count)
+        .def("get_dispatch_statistics", &CrossLayerOptimizer::get_dispatch_statistics)
+        .def("set_instrumentation_enabled", &CrossLayerOptimizer::set_instrumentation_enabled)
+        .def("reset_instrumentation", &CrossLayerOptimizer::reset_instrumentation)
+        .def("get_instrumentation_statistics", &CrossLayerOptimizer::get_instrumentation_statistics)
+        .def("advance_simulation_clock", &CrossLayerOptimizer::advance_simulation_clock)
+        .def("get_simulation_clock_ms", &CrossLayerOptimizer::get_simulation_clock_ms)
+        .def("post_message", &CrossLayerOptimizer::post_message)
+        .def("drain_message_bus", &CrossLayerOptimizer::drain_message_bus, py::arg("max_messages") = 0)
+        .def("set_message_bus_capacity", &CrossLayerOptimizer::set_message_bus_capacity)
+        .def("get_message_bus_statistics", &CrossLayerOptimizer::get_message_bus_statistics)
         .def("enable_adaptive_optimization", &CrossLayerOptimizer::enable_adaptive_optimization)
         .def("set_optimization_weights", &CrossLayerOptimizer::set_optimization_weights)
+        .def("get_optimization_weights", &CrossLayerOptimizer::get_optimization_weights)
+        .def("set_thresholds", &CrossLayerOptimizer::set_thresholds)
+        .def("get_thresholds", &CrossLayerOptimizer::get_thresholds)
         .def("optimize_network_performance", &CrossLayerOptimizer::optimize_network_performance)
         .def("adapt_to_network_conditions", &CrossLayerOptimizer::adapt_to_network_conditions)
         .def("get_current_throughput", &CrossLayerOptimizer::get_current_throughput)
@@ -209,28 +570,344 @@ PYBIND11_MODULE(network_protocols_enhanced, m) {
         .def("get_current_packet_loss_rate", &CrossLayerOptimizer::get_current_packet_loss_rate)
         .def("get_throughput_history", &CrossLayerOptimizer::get_throughput_history)
         .def("get_latency_history", &CrossLayerOptimizer::get_latency_history)
+        .def("set_simulation_seed", &CrossLayerOptimizer::set_simulation_seed,
+             py::arg("seed"), py::arg("stream") = 0)
+        .def("get_simulation_seed", &CrossLayerOptimizer::get_simulation_seed)
+        .def("enable_cosimulation", &CrossLayerOptimizer::enable_cosimulation)
+        .def("disable_cosimulation", &CrossLayerOptimizer::disable_cosimulation)
+        .def("is_cosimulation_enabled", &CrossLayerOptimizer::is_cosimulation_enabled)
+        .def("step_cosimulation", &CrossLayerOptimizer::step_cosimulation)
+        .def("get_flow_table", &CrossLayerOptimizer::get_flow_table, py::return_value_policy::reference_internal)
+        .def("get_cosimulation_statistics", &CrossLayerOptimizer::get_cosimulation_statistics)
+        .def("load_policy", &CrossLayerOptimizer::load_policy)
+        .def("load_policy_file", &CrossLayerOptimizer::load_policy_file)
+        .def("clear_policy", &CrossLayerOptimizer::clear_policy)
+        .def("set_policy_reload_interval", &CrossLayerOptimizer::set_policy_reload_interval)
+        .def("get_policy_engine", &CrossLayerOptimizer::get_policy_engine, py::return_value_policy::reference_internal)
         .def("simulate_mobility", &CrossLayerOptimizer::simulate_mobility)
         .def("simulate_interference", &CrossLayerOptimizer::simulate_interference)
         .def("simulate_traffic_variation", &CrossLayerOptimizer::simulate_traffic_variation)
         .def("reset", &CrossLayerOptimizer::reset)
         .def("clear_history", &CrossLayerOptimizer::clear_history);
     
+    // Link abstraction binding
+    py::class_<LinkAbstraction>(m, "LinkAbstraction")
+        .def(py::init<double, double, double>(),
+             py::arg("min_sinr_db") = -15.0, py::arg("max_sinr_db") = 35.0, py::arg("step_db") = 0.1)
+        .def("get_cqi_table", &LinkAbstraction::get_cqi_table)
+        .def("get_max_cqi", &LinkAbstraction::get_max_cqi)
+        .def("effective_sinr_eesm", static_cast<double (LinkAbstraction::*)(const std::vector<double>&, int) const>(
+             &LinkAbstraction::effective_sinr_eesm))
+        .def("select_cqi", &LinkAbstraction::select_cqi)
+        .def("cqi_to_mcs", &LinkAbstraction::cqi_to_mcs)
+        .def("mcs_to_cqi", &LinkAbstraction::mcs_to_cqi)
+        .def("get_spectral_efficiency", &LinkAbstraction::get_spectral_efficiency)
+        .def("lookup_bler", &LinkAbstraction::lookup_bler);
+    
+    // Sector antenna pattern binding
+    py::class_<AntennaPattern>(m, "AntennaPattern")
+        .def(py::init<double, double, double, double, double>(),
+             py::arg("max_gain_dbi") = 15.0, py::arg("horizontal_beamwidth") = 70.0,
+             py::arg("vertical_beamwidth") = 10.0, py::arg("max_attenuation") = 25.0,
+             py::arg("vertical_side_lobe") = 20.0)
+        .def("pattern_gain", &AntennaPattern::pattern_gain)
+        .def("lookup_gain", &AntennaPattern::lookup_gain)
+        .def("gain_towards", &AntennaPattern::gain_towards)
+        .def("set_ue_height", &AntennaPattern::set_ue_height)
+        .def_static("fast_atan2_deg", &AntennaPattern::fast_atan2_deg);
+    
     // LTE Network binding
-    py::class_<LTENetwork>(m, "LTENetwork")
+    py::class_<LTENetwork, std::shared_ptr<LTENetwork>>(m, "LTENetwork")
         .def(py::init<>())
         .def("initialize_network", &LTENetwork::initialize_network)
+        .def("add_cell", [](LTENetwork& network, const CellInfo& cell) {
+            network.add_cell(cell);
+            network.publish_snapshot();
+        })
+        .def("add_user", [](LTENetwork& network, const UserEquipment& user) {
+            network.add_user(user);
+            network.publish_snapshot();
+        })
+        .def("remove_user", [](LTENetwork& network, int ue_id) {
+            network.remove_user(ue_id);
+            network.publish_snapshot();
+        })
+        .def("add_sector_site", [](LTENetwork& network, double x, double y, int num_sectors,
+                                   double downtilt, double antenna_height) {
+            std::vector<int> cell_ids = network.add_sector_site(x, y, num_sectors, downtilt, antenna_height);
+            network.publish_snapshot();
+            return cell_ids;
+        })
+        .def("configure_sector", [](LTENetwork& network, int cell_id, double azimuth,
+                                    double downtilt, double antenna_height) {
+            network.configure_sector(cell_id, azimuth, downtilt, antenna_height);
+            network.publish_snapshot();
+        })
+        .def("set_cells", [](LTENetwork& network, const std::vector<CellInfo>& cells) {
+            network.set_cells(cells);
+            network.publish_snapshot();
+        })
+        .def("import_cells", [](LTENetwork& network, const CellImportResult& result) {
+            CellSiteImporter::apply(result, network);
+            network.publish_snapshot();
+        })
+        .def("set_measurement_radius", &LTENetwork::set_measurement_radius)
+        .def("get_cells", &LTENetwork::get_cells_snapshot)
+        .def("get_users", &LTENetwork::get_users_snapshot)
+        .def("update_cell_load", [](LTENetwork& network, int cell_id, int load_percentage) {
+            network.update_cell_load(cell_id, load_percentage);
+            network.publish_snapshot();
+        })
+        .def("update_cell_interference", [](LTENetwork& network, int cell_id, double interference) {
+            network.update_cell_interference(cell_id, interference);
+            network.publish_snapshot();
+        })
         .def("get_user_info", &LTENetwork::get_user_info)
         .def("get_cell_info", &LTENetwork::get_cell_info)
-        .def("update_user_position", &LTENetwork::update_user_position)
+        .def("update_user_position", [](LTENetwork& network, int ue_id, double x, double y) {
+            network.update_user_position(ue_id, x, y);
+            network.publish_snapshot();
+        })
         .def("calculate_rsrp", &LTENetwork::calculate_rsrp)
+        .def("calculate_rsrq", &LTENetwork::calculate_rsrq)
+        .def("calculate_sinr", &LTENetwork::calculate_sinr)
+        .def("get_cell_activity", &LTENetwork::get_cell_activity)
+        .def("get_cell_activity_factors", &LTENetwork::get_cell_activity_factors)
+        .def("set_load_weighted_interference", &LTENetwork::set_load_weighted_interference)
         .def("should_trigger_handover", &LTENetwork::should_trigger_handover)
         .def("initiate_handover", &LTENetwork::initiate_handover)
         .def("set_handover_parameters", &LTENetwork::set_handover_parameters)
         .def("get_network_throughput", &LTENetwork::get_network_throughput)
         .def("get_active_users_count", &LTENetwork::get_active_users_count)
-        .def("get_handover_history", &LTENetwork::get_handover_history)
+        .def("get_handover_history", &LTENetwork::get_handover_history_snapshot)
+        .def("get_snapshot", &LTENetwork::get_snapshot)
+        .def("get_snapshot_epoch", &LTENetwork::get_snapshot_epoch)
+        .def("publish_snapshot", &LTENetwork::publish_snapshot)
+        .def("set_snapshot_interval", &LTENetwork::set_snapshot_interval)
+        .def("get_snapshot_interval", &LTENetwork::get_snapshot_interval)
+        .def("select_user_cqi", &LTENetwork::select_user_cqi)
+        .def("calculate_user_throughput", &LTENetwork::calculate_user_throughput)
+        .def("report_harq_feedback", &LTENetwork::report_harq_feedback)
+        .def("set_link_adaptation_parameters", &LTENetwork::set_link_adaptation_parameters)
+        .def("get_user_cqi", &LTENetwork::get_user_cqi)
+        .def("get_olla_offset", &LTENetwork::get_olla_offset)
+        .def("refresh_state_arrays", &LTENetwork::refresh_state_arrays)
+        .def("get_state_view", &lte_state_view)
+        .def("get_state_snapshot", &lte_state_snapshot)
+        .def("configure_carriers", &LTENetwork::configure_carriers)
+        .def("get_carriers", &LTENetwork::get_carriers)
+        .def("carrier_aggregation_scheduler", &LTENetwork::carrier_aggregation_scheduler)
+        .def("set_carrier_scheduling_parameters", &LTENetwork::set_carrier_scheduling_parameters)
+        .def("set_cell_carriers", &LTENetwork::set_cell_carriers)
+        .def("get_cell_carriers", &LTENetwork::get_cell_carriers)
+        .def("get_user_carrier_throughput", &LTENetwork::get_user_carrier_throughput)
+        .def("get_carrier_cell_activity", &LTENetwork::get_carrier_cell_activity)
+        .def("set_external_cell_activity", &LTENetwork::set_external_cell_activity)
+        .def_static("rbs_for_bandwidth", &LTENetwork::rbs_for_bandwidth)
+        .def_static("nr_prbs_for_bandwidth", &LTENetwork::nr_prbs_for_bandwidth)
+        .def("configure_nr", &LTENetwork::configure_nr)
+        .def("set_active_bandwidth_part", &LTENetwork::set_active_bandwidth_part)
+        .def("set_csi_report_period", &LTENetwork::set_csi_report_period)
+        .def("is_nr_mode", &LTENetwork::is_nr_mode)
+        .def("get_numerology", &LTENetwork::get_numerology)
+        .def("get_slot_duration_ms", &LTENetwork::get_slot_duration_ms)
+        .def("configure_handover_signaling", &LTENetwork::configure_handover_signaling)
+        .def("get_handover_signaling_config", &LTENetwork::get_handover_signaling_config)
+        .def("get_handover_signaling_statistics", &LTENetwork::get_handover_signaling_statistics)
+        .def("get_handover_interruption_times", &LTENetwork::get_handover_interruption_times)
+        .def("enable_uplink", &LTENetwork::enable_uplink)
+        .def("set_uplink_power_control", &LTENetwork::set_uplink_power_control)
+        .def("get_uplink_power_control", &LTENetwork::get_uplink_power_control)
+        .def("uplink_scheduler", &LTENetwork::uplink_scheduler)
+        .def("get_uplink_throughput", &LTENetwork::get_uplink_throughput)
+        .def("get_uplink_tx_power", &LTENetwork::get_uplink_tx_power)
+        .def("get_uplink_sinr", &LTENetwork::get_uplink_sinr)
+        .def("get_tpc_offset", &LTENetwork::get_tpc_offset)
+        .def("get_uplink_interference", &LTENetwork::get_uplink_interference)
+        .def("get_uplink_statistics", &LTENetwork::get_uplink_statistics)
+        .def("set_step_degradation", &LTENetwork::set_step_degradation)
+        .def("get_step_degradation", &LTENetwork::get_step_degradation)
+        .def("configure_downlink_buffers", &LTENetwork::configure_downlink_buffers)
+        .def("enqueue_downlink", &LTENetwork::enqueue_downlink)
+        .def("get_queuing_delay", &LTENetwork::get_queuing_delay)
+        .def("get_head_of_line_delay", &LTENetwork::get_head_of_line_delay)
+        .def("get_delivered_bytes", &LTENetwork::get_delivered_bytes)
+        .def("get_discarded_sdus", &LTENetwork::get_discarded_sdus)
+        .def("get_buffered_bytes", &LTENetwork::get_buffered_bytes)
+        .def("get_buffer_statistics", &LTENetwork::get_buffer_statistics)
+        .def("step_measurements", &LTENetwork::step_measurements)
+        .def("step_scheduling", &LTENetwork::step_scheduling)
         .def("step_simulation", &LTENetwork::step_simulation);
     
+    // Partitioned multi-process LTE simulation
+    py::class_<PartitionConfig>(m, "PartitionConfig")
+        .def(py::init<>())
+        .def_readwrite("regions_x", &PartitionConfig::regions_x)
+        .def_readwrite("regions_y", &PartitionConfig::regions_y)
+        .def_readwrite("area_width", &PartitionConfig::area_width)
+        .def_readwrite("area_height", &PartitionConfig::area_height)
+        .def_readwrite("halo_width", &PartitionConfig::halo_width)
+        .def_readwrite("ring_capacity", &PartitionConfig::ring_capacity);
+    
+    py::class_<RegionKPIs>(m, "RegionKPIs")
+        .def(py::init<>())
+        .def_readwrite("total_throughput", &RegionKPIs::total_throughput)
+        .def_readwrite("handovers", &RegionKPIs::handovers)
+        .def_readwrite("migrations_out", &RegionKPIs::migrations_out)
+        .def_readwrite("migrations_in", &RegionKPIs::migrations_in)
+        .def_readwrite("border_records_sent", &RegionKPIs::border_records_sent)
+        .def_readwrite("ring_overflows", &RegionKPIs::ring_overflows)
+        .def_readwrite("owned_users", &RegionKPIs::owned_users)
+        .def_readwrite("ghost_users", &RegionKPIs::ghost_users);
+    
+    py::class_<PartitionedLTESimulation>(m, "PartitionedLTESimulation")
+        .def(py::init<const PartitionConfig&>())
+        .def("set_network", &PartitionedLTESimulation::set_network)
+        .def("get_region_of_cell", &PartitionedLTESimulation::get_region_of_cell)
+        .def("run", &PartitionedLTESimulation::run, py::call_guard<py::gil_scoped_release>())
+        .def("get_throughput_history", &PartitionedLTESimulation::get_throughput_history)
+        .def("get_active_users_history", &PartitionedLTESimulation::get_active_users_history)
+        .def("get_region_kpis", &PartitionedLTESimulation::get_region_kpis)
+        .def("get_final_users", &PartitionedLTESimulation::get_final_users)
+        .def("get_statistics", &PartitionedLTESimulation::get_statistics);
+    
+    // Random access (RACH) contention engine
+    py::enum_<RACHArrivalModel>(m, "RACHArrivalModel")
+        .value("UNIFORM", RACHArrivalModel::UNIFORM)
+        .value("BETA", RACHArrivalModel::BETA);
+    
+    py::enum_<RACHDeviceState>(m, "RACHDeviceState")
+        .value("PENDING", RACHDeviceState::PENDING)
+        .value("ACCESSING", RACHDeviceState::ACCESSING)
+        .value("CONNECTED", RACHDeviceState::CONNECTED)
+        .value("FAILED", RACHDeviceState::FAILED);
+    
+    py::class_<RACHConfig>(m, "RACHConfig")
+        .def(py::init(&RACHSimulator::default_config))
+        .def_readwrite("num_preambles", &RACHConfig::num_preambles)
+        .def_readwrite("rach_period_ms", &RACHConfig::rach_period_ms)
+        .def_readwrite("rar_delay_ms", &RACHConfig::rar_delay_ms)
+        .def_readwrite("rar_window_ms", &RACHConfig::rar_window_ms)
+        .def_readwrite("max_rar_grants", &RACHConfig::max_rar_grants)
+        .def_readwrite("msg3_delay_ms", &RACHConfig::msg3_delay_ms)
+        .def_readwrite("msg4_delay_ms", &RACHConfig::msg4_delay_ms)
+        .def_readwrite("contention_resolution_ms", &RACHConfig::contention_resolution_ms)
+        .def_readwrite("backoff_indicator_ms", &RACHConfig::backoff_indicator_ms)
+        .def_readwrite("max_preamble_transmissions", &RACHConfig::max_preamble_transmissions)
+        .def_readwrite("acb_barring_factor", &RACHConfig::acb_barring_factor)
+        .def_readwrite("acb_barring_time_ms", &RACHConfig::acb_barring_time_ms)
+        .def_readwrite("arrival_model", &RACHConfig::arrival_model)
+        .def_readwrite("activation_period_ms", &RACHConfig::activation_period_ms)
+        .def_readwrite("seed", &RACHConfig::seed);
+    
+    py::class_<RACHSimulator>(m, "RACHSimulator")
+        .def(py::init<const RACHConfig&>())
+        .def("attach_devices", &RACHSimulator::attach_devices)
+        .def("set_device_cells", &RACHSimulator::set_device_cells)
+        .def("run", &RACHSimulator::run, py::call_guard<py::gil_scoped_release>())
+        .def("get_device_state", &RACHSimulator::get_device_state)
+        .def("get_device_state_counts", &RACHSimulator::get_device_state_counts)
+        .def("get_access_delay_histogram", &RACHSimulator::get_access_delay_histogram)
+        .def("get_preamble_transmission_distribution", &RACHSimulator::get_preamble_transmission_distribution)
+        .def("get_opportunity_attempts", &RACHSimulator::get_opportunity_attempts)
+        .def("get_opportunity_successes", &RACHSimulator::get_opportunity_successes)
+        .def("get_opportunity_collisions", &RACHSimulator::get_opportunity_collisions)
+        .def("get_statistics", &RACHSimulator::get_statistics)
+        .def("get_num_devices", &RACHSimulator::get_num_devices);
+    
+    // Coverage/SINR heatmaps
+    py::class_<CoverageMapConfig>(m, "CoverageMapConfig")
+        .def(py::init(&CoverageMapGenerator::default_config))
+        .def_readwrite("x_min", &CoverageMapConfig::x_min)
+        .def_readwrite("y_min", &CoverageMapConfig::y_min)
+        .def_readwrite("x_max", &CoverageMapConfig::x_max)
+        .def_readwrite("y_max", &CoverageMapConfig::y_max)
+        .def_readwrite("width", &CoverageMapConfig::width)
+        .def_readwrite("height", &CoverageMapConfig::height)
+        .def_readwrite("tile_size", &CoverageMapConfig::tile_size)
+        .def_readwrite("num_threads", &CoverageMapConfig::num_threads)
+        .def_readwrite("frequency_mhz", &CoverageMapConfig::frequency_mhz)
+        .def_readwrite("interference_radius", &CoverageMapConfig::interference_radius);
+    
+    py::class_<CoverageMapGenerator>(m, "CoverageMapGenerator")
+        .def(py::init<size_t>(), py::arg("cache_capacity") = 4096)
+        .def("generate", &coverage_map_arrays)
+        .def("clear_cache", &CoverageMapGenerator::clear_cache)
+        .def("get_cache_statistics", &CoverageMapGenerator::get_cache_statistics)
+        .def_static("network_signature", &CoverageMapGenerator::network_signature);
+    
+    // Bulk cell-site import
+    py::class_<CellImportConfig>(m, "CellImportConfig")
+        .def(py::init(&CellSiteImporter::default_config))
+        .def_readwrite("auto_origin", &CellImportConfig::auto_origin)
+        .def_readwrite("origin_latitude", &CellImportConfig::origin_latitude)
+        .def_readwrite("origin_longitude", &CellImportConfig::origin_longitude)
+        .def_readwrite("num_threads", &CellImportConfig::num_threads)
+        .def_readwrite("default_downtilt", &CellImportConfig::default_downtilt)
+        .def_readwrite("default_antenna_height", &CellImportConfig::default_antenna_height)
+        .def_readwrite("default_frequency_mhz", &CellImportConfig::default_frequency_mhz)
+        .def_readwrite("default_bandwidth_mhz", &CellImportConfig::default_bandwidth_mhz)
+        .def_readwrite("index_bucket_size", &CellImportConfig::index_bucket_size);
+    
+    py::class_<CellImportResult>(m, "CellImportResult")
+        .def_readonly("ok", &CellImportResult::ok)
+        .def_readonly("error", &CellImportResult::error)
+        .def_readonly("cells", &CellImportResult::cells)
+        .def_readonly("source_ids", &CellImportResult::source_ids)
+        .def_readonly("cell_carrier", &CellImportResult::cell_carrier)
+        .def_readonly("carriers", &CellImportResult::carriers)
+        .def_readonly("origin_latitude", &CellImportResult::origin_latitude)
+        .def_readonly("origin_longitude", &CellImportResult::origin_longitude)
+        .def_readonly("rows_read", &CellImportResult::rows_read)
+        .def_readonly("rows_skipped", &CellImportResult::rows_skipped)
+        .def_readonly("elapsed_ms", &CellImportResult::elapsed_ms)
+        .def("cells_in_radius", [](const CellImportResult& result, double x, double y, double radius) {
+            std::vector<int> found;
+            result.index.query_radius(x, y, radius, found);
+            return found;
+        });
+    
+    py::class_<CellSiteImporter>(m, "CellSiteImporter")
+        .def(py::init<>())
+        .def(py::init<const CellImportConfig&>())
+        .def("import_csv", &CellSiteImporter::import_csv, py::call_guard<py::gil_scoped_release>())
+        .def("import_geojson", &CellSiteImporter::import_geojson, py::call_guard<py::gil_scoped_release>())
+        .def("parse_csv", &CellSiteImporter::parse_csv)
+        .def("parse_geojson", &CellSiteImporter::parse_geojson)
+        .def_static("project", [](double latitude, double longitude, double origin_latitude, double origin_longitude) {
+            double x, y;
+            CellSiteImporter::project(latitude, longitude, origin_latitude, origin_longitude, x, y);
+            return py::make_tuple(x, y);
+        });
+    
+    // Real-time paced runner
+    py::class_<RealtimeSnapshot>(m, "RealtimeSnapshot")
+        .def(py::init<>())
+        .def_readonly("step", &RealtimeSnapshot::step)
+        .def_readonly("sim_time_s", &RealtimeSnapshot::sim_time_s)
+        .def_readonly("step_duration_ms", &RealtimeSnapshot::step_duration_ms)
+        .def_readonly("degradation_level", &RealtimeSnapshot::degradation_level)
+        .def_readonly("deadline_misses", &RealtimeSnapshot::deadline_misses)
+        .def_readonly("network_throughput", &RealtimeSnapshot::network_throughput)
+        .def_readonly("active_users", &RealtimeSnapshot::active_users)
+        .def_readonly("handover_count", &RealtimeSnapshot::handover_count)
+        .def_readonly("ue_ids", &RealtimeSnapshot::ue_ids)
+        .def_readonly("ue_positions", &RealtimeSnapshot::ue_positions)
+        .def_readonly("ue_serving_cell", &RealtimeSnapshot::ue_serving_cell)
+        .def_readonly("ue_throughput", &RealtimeSnapshot::ue_throughput);
+    
+    py::class_<RealtimeRunner>(m, "RealtimeRunner")
+        .def(py::init<LTENetwork&, double>(), py::arg("network"), py::arg("step_period_ms") = 10.0,
+             py::keep_alive<1, 2>())
+        .def("set_step_period", &RealtimeRunner::set_step_period)
+        .def("set_adaptation_parameters", &RealtimeRunner::set_adaptation_parameters)
+        .def("set_publish_interval", &RealtimeRunner::set_publish_interval)
+        .def("start", &RealtimeRunner::start)
+        .def("stop", &RealtimeRunner::stop, py::call_guard<py::gil_scoped_release>())
+        .def("is_running", &RealtimeRunner::is_running)
+        .def("get_latest_snapshot", &RealtimeRunner::get_latest_snapshot)
+        .def("get_statistics", &RealtimeRunner::get_statistics);
+    
     // Validation Framework (simplified interface)
     py::class_<ValidationFramework>(m, "ValidationFramework")
         .def(py::init<>())
@@ -0,0 +1,552 @@
+#include "policy_engine.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace {
+
+// Rows per block: the match mask and a block of each column stay in L1
+const size_t policy_block_rows = 1024;
+
+enum PolicyTokenType {
+    TOKEN_NAME,
+    TOKEN_NUMBER,
+    TOKEN_OPERATOR,     // < <= > >= == =
+    TOKEN_COLON,
+    TOKEN_COMMA,
+    TOKEN_ARROW,
+    TOKEN_END
+};
+
+struct PolicyToken {
+    PolicyTokenType type;
+    std::string text;
+    double number;
+};
+
+bool tokenize_policy_line(const std::string& line, std::vector<PolicyToken>& tokens, std::string& error) {
+    tokens.clear();
+    size_t i = 0;
+    while (i < line.size()) {
+        char c = line[i];
+        if (c == '#') break;
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+            continue;
+        }
+        PolicyToken token;
+        token.number = 0.0;
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = i;
+            while (i < line.size() && (std::isalnum(static_cast<unsigned char>(line[i])) || line[i] == '_')) i++;
+            token.type = TOKEN_NAME;
+            token.text = line.substr(start, i - start);
+        } else if (c == '-' && i + 1 < line.size() && line[i + 1] == '>') {
+            token.type = TOKEN_ARROW;
+            token.text = "->";
+            i += 2;
+        } else if (c == '<' || c == '>' || c == '=') {
+            size_t length = i + 1 < line.size() && line[i + 1] == '=' ? 2 : 1;
+            token.type = TOKEN_OPERATOR;
+            token.text = line.substr(i, length);
+            i += length;
+        } else if (c == ':' || c == ',') {
+            token.type = c == ':' ? TOKEN_COLON : TOKEN_COMMA;
+            token.text = std::string(1, c);
+            i++;
+        } else {
+            const char* begin = line.c_str() + i;
+            char* end = nullptr;
+            token.number = std::strtod(begin, &end);
+            if (end == begin) {
+                error = "unexpected '" + std::string(1, c) + "'";
+                return false;
+            }
+            token.type = TOKEN_NUMBER;
+            token.text = line.substr(i, end - begin);
+            i += end - begin;
+        }
+        tokens.push_back(token);
+    }
+    // Padded so the parser can look a few tokens ahead without bounds checks
+    PolicyToken end;
+    end.type = TOKEN_END;
+    end.number = 0.0;
+    tokens.insert(tokens.end(), 4, end);
+    return true;
+}
+
+bool policy_value(const PolicyToken& token, double& value) {
+    if (token.type == TOKEN_NUMBER) {
+        value = token.number;
+        return true;
+    }
+    if (token.type != TOKEN_NAME) return false;
+    // Congestion algorithms by CongestionAlgorithm value
+    static const char* names[] = {"TAHOE", "RENO", "CUBIC", "BBR"};
+    for (int i = 0; i < 4; i++) {
+        if (token.text == names[i]) {
+            value = i;
+            return true;
+        }
+    }
+    if (token.text == "inf") value = std::numeric_limits<double>::infinity();
+    else if (token.text == "true") value = 1.0;
+    else if (token.text == "false") value = 0.0;
+    else return false;
+    return true;
+}
+
+int policy_action_index(std::vector<std::string>& names, std::vector<double>& defaults, const std::string& name) {
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    names.push_back(name);
+    defaults.push_back(std::numeric_limits<double>::quiet_NaN());
+    return static_cast<int>(names.size() - 1);
+}
+
+// Branch-free select of value where mask is 1; a mispredicted branch per
+// row costs more than the whole blend
+inline double select_masked(uint8_t mask, double value, double current) {
+    uint64_t bits_value, bits_current;
+    std::memcpy(&bits_value, &value, sizeof(double));
+    std::memcpy(&bits_current, &current, sizeof(double));
+    uint64_t select = uint64_t(0) - mask;
+    uint64_t bits = (bits_value & select) | (bits_current & ~select);
+    double result;
+    std::memcpy(&result, &bits, sizeof(double));
+    return result;
+}
+
+bool read_policy_file(const std::string& path, std::string& text) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) return false;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+bool policy_file_stamp(const std::string& path, int64_t& mtime_ns, int64_t& size) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    size = static_cast<int64_t>(info.st_size);
+    return true;
+}
+
+} // namespace
+
+PolicyInputs::PolicyInputs(size_t rows) {
+    this->rows = rows;
+    for (int i = 0; i < MetricRegistry::MAX_METRICS; i++) {
+        columns[i] = nullptr;
+        scalars[i] = 0.0;
+    }
+    scalar_mask = 0;
+}
+
+void PolicyInputs::set_column(int metric, const double* values) {
+    if (metric < 0 || metric >= MetricRegistry::MAX_METRICS) return;
+    columns[metric] = values;
+}
+
+void PolicyInputs::set_scalar(int metric, double value) {
+    if (metric < 0 || metric >= MetricRegistry::MAX_METRICS) return;
+    scalars[metric] = value;
+    scalar_mask |= uint64_t(1) << metric;
+}
+
+PolicyEngine::PolicyEngine() {
+    loaded = false;
+    source_mtime_ns = -1;
+    source_size = -1;
+    result_rows = 0;
+    evaluations = 0;
+    rows_evaluated = 0;
+    reloads = 0;
+    reload_failures = 0;
+    missing_metrics = 0;
+    last_evaluate_us = 0.0;
+    total_evaluate_us = 0.0;
+}
+
+bool PolicyEngine::compile(const std::string& text, Table& table, std::string& error) {
+    table = Table();
+    std::vector<PolicyToken> tokens;
+    std::vector<std::string> new_metrics;   // Interned only once the policy compiles
+    std::istringstream lines(text);
+    std::string line;
+    int line_number = 0;
+    while (std::getline(lines, line)) {
+        line_number++;
+        std::string line_error;
+        std::ostringstream where;
+        where << "line " << line_number << ": ";
+        if (!tokenize_policy_line(line, tokens, line_error)) {
+            error = where.str() + line_error;
+            return false;
+        }
+        if (tokens[0].type == TOKEN_END) continue;
+        if (tokens[0].type != TOKEN_NAME) {
+            error = where.str() + "expected 'rule' or 'default'";
+            return false;
+        }
+
+        size_t t = 1;
+        if (tokens[0].text == "default") {
+            double value = 0.0;
+            if (tokens[1].type != TOKEN_NAME || tokens[2].text != "=" || !policy_value(tokens[3], value) ||
+                tokens[4].type != TOKEN_END) {
+                error = where.str() + "expected 'default <action> = <value>'";
+                return false;
+            }
+            int action = policy_action_index(table.action_names, table.action_defaults, tokens[1].text);
+            table.action_defaults[action] = value;
+            continue;
+        }
+        if (tokens[0].text != "rule") {
+            error = where.str() + "expected 'rule' or 'default', got '" + tokens[0].text + "'";
+            return false;
+        }
+
+        Rule rule;
+        if (tokens[t].type != TOKEN_NAME || tokens[t + 1].type != TOKEN_COLON) {
+            error = where.str() + "expected 'rule <name>:'";
+            return false;
+        }
+        rule.name = tokens[t].text;
+        t += 2;
+        rule.first_condition = table.conditions.size();
+        rule.first_assignment = table.assignments.size();
+        rule.satisfiable = true;
+
+        // Conditions, each narrowing its metric's interval within the rule
+        while (tokens[t].type != TOKEN_ARROW) {
+            if (tokens[t].type != TOKEN_NAME || tokens[t + 1].type != TOKEN_OPERATOR ||
+                tokens[t + 2].type != TOKEN_NUMBER) {
+                error = where.str() + "expected '<metric> <op> <number>' in rule '" + rule.name + "'";
+                return false;
+            }
+            // Unregistered names get provisional IDs past the registry
+            int metric = MetricRegistry::find(tokens[t].text);
+            if (metric < 0) {
+                size_t k = std::find(new_metrics.begin(), new_metrics.end(), tokens[t].text) - new_metrics.begin();
+                if (k == new_metrics.size()) new_metrics.push_back(tokens[t].text);
+                if (MetricRegistry::size() + new_metrics.size() > static_cast<size_t>(MetricRegistry::MAX_METRICS)) {
+                    error = where.str() + "metric registry full at '" + tokens[t].text + "'";
+                    return false;
+                }
+                metric = MetricRegistry::MAX_METRICS + static_cast<int>(k);
+            }
+            const std::string& op = tokens[t + 1].text;
+            double bound = tokens[t + 2].number;
+            double low = -std::numeric_limits<double>::infinity();
+            double high = std::numeric_limits<double>::infinity();
+            if (op == "<") high = std::nextafter(bound, low);
+            else if (op == "<=") high = bound;
+            else if (op == ">") low = std::nextafter(bound, high);
+            else if (op == ">=") low = bound;
+            else if (op == "==") low = high = bound;
+            else {
+                error = where.str() + "unknown operator '" + op + "'";
+                return false;
+            }
+
+            Condition* existing = nullptr;
+            for (size_t c = rule.first_condition; c < table.conditions.size(); c++) {
+                if (table.conditions[c].metric == metric) existing = &table.conditions[c];
+            }
+            if (existing) {
+                existing->low = std::max(existing->low, low);
+                existing->high = std::min(existing->high, high);
+            } else {
+                Condition condition;
+                condition.metric = metric;
+                condition.low = low;
+                condition.high = high;
+                table.conditions.push_back(condition);
+            }
+            t += 3;
+            if (tokens[t].type == TOKEN_NAME && tokens[t].text == "and") {
+                t++;
+            } else if (tokens[t].type != TOKEN_ARROW) {
+                error = where.str() + "expected 'and' or '->' in rule '" + rule.name + "'";
+                return false;
+            }
+        }
+        t++;
+        rule.condition_count = table.conditions.size() - rule.first_condition;
+        for (size_t c = rule.first_condition; c < table.conditions.size(); c++) {
+            if (table.conditions[c].low > table.conditions[c].high) rule.satisfiable = false;
+        }
+
+        // Actions
+        while (true) {
+            double value = 0.0;
+            if (tokens[t].type != TOKEN_NAME || tokens[t + 1].text != "=" || !policy_value(tokens[t + 2], value)) {
+                error = where.str() + "expected '<action> = <value>' in rule '" + rule.name + "'";
+                return false;
+            }
+            Assignment assignment;
+            assignment.action = policy_action_index(table.action_names, table.action_defaults, tokens[t].text);
+            assignment.value = value;
+            table.assignments.push_back(assignment);
+            t += 3;
+            if (tokens[t].type == TOKEN_END) break;
+            if (tokens[t].type != TOKEN_COMMA) {
+                error = where.str() + "expected ',' between actions in rule '" + rule.name + "'";
+                return false;
+            }
+            t++;
+        }
+        rule.assignment_count = table.assignments.size() - rule.first_assignment;
+        table.rules.push_back(rule);
+    }
+
+    std::vector<int> new_ids(new_metrics.size());
+    for (size_t k = 0; k < new_metrics.size(); k++) {
+        new_ids[k] = MetricRegistry::intern(new_metrics[k]);
+        if (new_ids[k] < 0) {
+            error = "metric registry full at '" + new_metrics[k] + "'";
+            return false;
+        }
+    }
+    for (auto& condition : table.conditions) {
+        if (condition.metric >= MetricRegistry::MAX_METRICS) {
+            condition.metric = new_ids[condition.metric - MetricRegistry::MAX_METRICS];
+        }
+    }
+    return true;
+}
+
+bool PolicyEngine::install(const std::string& text) {
+    Table compiled;
+    std::string error;
+    if (!compile(text, compiled, error)) {
+        last_error = error;
+        return false;
+    }
+    table.rules.swap(compiled.rules);
+    table.conditions.swap(compiled.conditions);
+    table.assignments.swap(compiled.assignments);
+    table.action_names.swap(compiled.action_names);
+    table.action_defaults.swap(compiled.action_defaults);
+    rule_matches.assign(table.rules.size(), 0);
+    result_rows = 0;
+    loaded = true;
+    last_error.clear();
+    return true;
+}
+
+bool PolicyEngine::load_string(const std::string& text) {
+    if (!install(text)) return false;
+    source_path.clear();
+    source_mtime_ns = -1;
+    source_size = -1;
+    return true;
+}
+
+bool PolicyEngine::load_file(const std::string& path) {
+    int64_t mtime_ns = 0, size = 0;
+    std::string text;
+    if (!policy_file_stamp(path, mtime_ns, size) || !read_policy_file(path, text)) {
+        last_error = "Cannot read policy file: " + path;
+        return false;
+    }
+    if (!install(text)) return false;
+    source_path = path;
+    source_mtime_ns = mtime_ns;
+    source_size = size;
+    return true;
+}
+
+bool PolicyEngine::reload_if_changed() {
+    if (source_path.empty()) return false;
+    int64_t mtime_ns = 0, size = 0;
+    if (!policy_file_stamp(source_path, mtime_ns, size)) return false;
+    if (mtime_ns == source_mtime_ns && size == source_size) return false;
+
+    // A failed compile is not retried until the file changes again
+    source_mtime_ns = mtime_ns;
+    source_size = size;
+    std::string text;
+    if (!read_policy_file(source_path, text) || !install(text)) {
+        if (last_error.empty()) last_error = "Cannot read policy file: " + source_path;
+        reload_failures++;
+        return false;
+    }
+    reloads++;
+    return true;
+}
+
+void PolicyEngine::clear() {
+    table = Table();
+    loaded = false;
+    source_path.clear();
+    source_mtime_ns = -1;
+    source_size = -1;
+    result_rows = 0;
+    action_values.clear();
+    matched_rule.clear();
+    rule_matches.clear();
+}
+
+bool PolicyEngine::is_loaded() const {
+    return loaded;
+}
+
+std::string PolicyEngine::get_last_error() const {
+    return last_error;
+}
+
+std::string PolicyEngine::get_source_path() const {
+    return source_path;
+}
+
+size_t PolicyEngine::get_rule_count() const {
+    return table.rules.size();
+}
+
+std::vector<std::string> PolicyEngine::get_rule_names() const {
+    std::vector<std::string> names;
+    for (const auto& rule : table.rules) names.push_back(rule.name);
+    return names;
+}
+
+std::vector<std::string> PolicyEngine::get_action_names() const {
+    return table.action_names;
+}
+
+int PolicyEngine::find_action(const std::string& name) const {
+    for (size_t i = 0; i < table.action_names.size(); i++) {
+        if (table.action_names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void PolicyEngine::evaluate(const PolicyInputs& inputs) {
+    auto start = std::chrono::steady_clock::now();
+    size_t rows = inputs.rows;
+    size_t actions = table.action_names.size();
+    result_rows = rows;
+    action_values.resize(actions * rows);
+    for (size_t a = 0; a < actions; a++) {
+        std::fill(action_values.begin() + a * rows, action_values.begin() + (a + 1) * rows, table.action_defaults[a]);
+    }
+    matched_rule.assign(rows, -1);
+    match.resize(policy_block_rows);
+
+    // Rules whose inputs are missing or whose shared scalars fail match no row
+    std::vector<uint8_t> active(table.rules.size(), 0);
+    missing_metrics = 0;
+    for (size_t r = 0; r < table.rules.size(); r++) {
+        const Rule& rule = table.rules[r];
+        bool possible = rule.satisfiable;
+        for (size_t c = rule.first_condition; c < rule.first_condition + rule.condition_count; c++) {
+            const Condition& condition = table.conditions[c];
+            if (inputs.columns[condition.metric]) continue;
+            if ((inputs.scalar_mask >> condition.metric) & 1u) {
+                double value = inputs.scalars[condition.metric];
+                possible = possible && value >= condition.low && value <= condition.high;
+            } else {
+                possible = false;
+                missing_metrics++;
+            }
+        }
+        active[r] = possible;
+    }
+
+    // Rules run last to first so that, per action, the earliest match is the
+    // last write; every pass is a branch-free loop over a block of rows
+    for (size_t begin = 0; begin < rows; begin += policy_block_rows) {
+        size_t count = std::min(policy_block_rows, rows - begin);
+        uint8_t* mask = match.data();
+        int32_t* rule_out = matched_rule.data() + begin;
+        for (size_t r = table.rules.size(); r-- > 0;) {
+            if (!active[r]) continue;
+            const Rule& rule = table.rules[r];
+            std::fill(mask, mask + count, uint8_t(1));
+            for (size_t c = rule.first_condition; c < rule.first_condition + rule.condition_count; c++) {
+                const Condition& condition = table.conditions[c];
+                const double* values = inputs.columns[condition.metric];
+                if (!values) continue;
+                values += begin;
+                const double low = condition.low, high = condition.high;
+                for (size_t i = 0; i < count; i++) {
+                    mask[i] &= static_cast<uint8_t>((values[i] >= low) & (values[i] <= high));
+                }
+            }
+
+            size_t hits = 0;
+            for (size_t i = 0; i < count; i++) hits += mask[i];
+            if (hits == 0) continue;
+            rule_matches[r] += hits;
+
+            const int32_t id = static_cast<int32_t>(r);
+            for (size_t i = 0; i < count; i++) {
+                int32_t select = -static_cast<int32_t>(mask[i]);
+                rule_out[i] = (id & select) | (rule_out[i] & ~select);
+            }
+            for (size_t s = rule.first_assignment; s < rule.first_assignment + rule.assignment_count; s++) {
+                const Assignment& assignment = table.assignments[s];
+                double* out = action_values.data() + assignment.action * rows + begin;
+                const double value = assignment.value;
+                for (size_t i = 0; i < count; i++) {
+                    out[i] = select_masked(mask[i], value, out[i]);
+                }
+            }
+        }
+    }
+
+    evaluations++;
+    rows_evaluated += rows;
+    last_evaluate_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    total_evaluate_us += last_evaluate_us;
+}
+
+size_t PolicyEngine::get_result_rows() const {
+    return result_rows;
+}
+
+const double* PolicyEngine::get_action_values(int action) const {
+    if (action < 0 || static_cast<size_t>(action) >= table.action_names.size() || result_rows == 0) return nullptr;
+    return action_values.data() + action * result_rows;
+}
+
+std::vector<double> PolicyEngine::get_action(const std::string& name) const {
+    const double* values = get_action_values(find_action(name));
+    if (!values) return std::vector<double>();
+    return std::vector<double>(values, values + result_rows);
+}
+
+const std::vector<int32_t>& PolicyEngine::get_matched_rules() const {
+    return matched_rule;
+}
+
+std::map<std::string, double> PolicyEngine::get_statistics() const {
+    std::map<std::string, double> stats;
+    stats["loaded"] = loaded ? 1.0 : 0.0;
+    stats["rules"] = table.rules.size();
+    stats["conditions"] = table.conditions.size();
+    stats["actions"] = table.action_names.size();
+    stats["evaluations"] = evaluations;
+    stats["rows_evaluated"] = rows_evaluated;
+    stats["last_evaluate_us"] = last_evaluate_us;
+    stats["mean_evaluate_us"] = evaluations ? total_evaluate_us / evaluations : 0.0;
+    stats["reloads"] = reloads;
+    stats["reload_failures"] = reload_failures;
+    stats["missing_metrics"] = missing_metrics;
+    for (size_t r = 0; r < table.rules.size(); r++) {
+        stats["matches_" + table.rules[r].name] = rule_matches[r];
+    }
+    return stats;
+}
@@ -0,0 +1,120 @@
+#ifndef POLICY_ENGINE_H
+#define POLICY_ENGINE_H
+
+#include "metric_registry.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+
+// Inputs for one evaluation, by MetricId: an array with one value per row,
+// or one value shared by every row. Arrays are borrowed, not copied.
+struct PolicyInputs {
+    size_t rows;
+    const double* columns[MetricRegistry::MAX_METRICS];
+    double scalars[MetricRegistry::MAX_METRICS];
+    uint64_t scalar_mask;
+
+    explicit PolicyInputs(size_t rows = 0);
+    void set_column(int metric, const double* values);
+    void set_scalar(int metric, double value);
+};
+
+// Declarative cross-layer policy compiled into a flat decision table and
+// evaluated column-wise over many rows (flows, UEs) at once. One rule per
+// line, conditions on metrics and numeric action assignments:
+//
+//   # comment
+//   default max_cwnd = inf
+//   rule poor_signal: sinr_db < 0 and mobility_speed >= 50 -> max_cwnd = 20, tcp_algorithm = TAHOE
+//   rule deep_queue: queue_bytes > 200000 -> max_cwnd = 40
+//
+// Metrics are MetricRegistry names. Conditions on the same metric merge
+// into one interval. For each action the first matching rule in file order
+// wins; rows no rule assigns keep the action's default (NaN unless given).
+// Action values are numbers, inf, true/false or TAHOE/RENO/CUBIC/BBR.
+class PolicyEngine {
+private:
+    struct Condition {
+        int metric;
+        double low;                     // low <= value <= high
+        double high;
+    };
+    struct Assignment {
+        int action;
+        double value;
+    };
+    struct Rule {
+        std::string name;
+        size_t first_condition;
+        size_t condition_count;
+        size_t first_assignment;
+        size_t assignment_count;
+        bool satisfiable;
+    };
+    struct Table {
+        std::vector<Rule> rules;
+        std::vector<Condition> conditions;
+        std::vector<Assignment> assignments;
+        std::vector<std::string> action_names;
+        std::vector<double> action_defaults;
+    };
+
+    Table table;
+    bool loaded;
+    std::string last_error;
+
+    // Hot reload source
+    std::string source_path;
+    int64_t source_mtime_ns;
+    int64_t source_size;
+
+    // Results of the last evaluate, [action][row]
+    size_t result_rows;
+    std::vector<double> action_values;
+    std::vector<int32_t> matched_rule;      // First rule matching each row, -1 for none
+    std::vector<uint64_t> rule_matches;     // Rows matched per rule, over all evaluations
+    std::vector<uint8_t> match;             // One block of rows
+
+    uint64_t evaluations;
+    uint64_t rows_evaluated;
+    uint64_t reloads;
+    uint64_t reload_failures;
+    size_t missing_metrics;                 // Conditions without an input, last evaluate
+    double last_evaluate_us;
+    double total_evaluate_us;
+
+    static bool compile(const std::string& text, Table& table, std::string& error);
+    bool install(const std::string& text);
+
+public:
+    PolicyEngine();
+
+    // Compile and swap in a policy; on error the current one stays active
+    // and get_last_error() names the line
+    bool load_string(const std::string& text);
+    bool load_file(const std::string& path);
+    // Recompiles the loaded file if its modification time or size changed;
+    // true only when a new policy was installed
+    bool reload_if_changed();
+    void clear();
+    bool is_loaded() const;
+    std::string get_last_error() const;
+    std::string get_source_path() const;
+
+    size_t get_rule_count() const;
+    std::vector<std::string> get_rule_names() const;
+    std::vector<std::string> get_action_names() const;
+    int find_action(const std::string& name) const;
+
+    // Conditions on a metric with no input never match
+    void evaluate(const PolicyInputs& inputs);
+    size_t get_result_rows() const;
+    // Valid until the next evaluate; null for an unknown action
+    const double* get_action_values(int action) const;
+    std::vector<double> get_action(const std::string& name) const;
+    const std::vector<int32_t>& get_matched_rules() const;
+    std::map<std::string, double> get_statistics() const;
+};
+
+#endif // POLICY_ENGINE_H
@@ -0,0 +1,319 @@
+#include "policy_tuner.h"
+#include "tcp_tahoe.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+
+namespace {
+
+struct ThresholdField {
+    const char* name;
+    double OptimizationThresholds::*field;
+};
+
+const ThresholdField threshold_fields[] = {
+    {"poor_signal_dbm", &OptimizationThresholds::poor_signal_dbm},
+    {"good_signal_dbm", &OptimizationThresholds::good_signal_dbm},
+    {"good_interference", &OptimizationThresholds::good_interference},
+    {"high_congestion", &OptimizationThresholds::high_congestion},
+    {"congestion_response", &OptimizationThresholds::congestion_response},
+    {"high_loss_rate", &OptimizationThresholds::high_loss_rate},
+    {"low_loss_rate", &OptimizationThresholds::low_loss_rate},
+    {"low_throughput_mbps", &OptimizationThresholds::low_throughput_mbps},
+    {"high_error_rate", &OptimizationThresholds::high_error_rate},
+    {"robust_error_rate", &OptimizationThresholds::robust_error_rate},
+    {"high_mobility_kmh", &OptimizationThresholds::high_mobility_kmh},
+    {"low_mobility_kmh", &OptimizationThresholds::low_mobility_kmh},
+    {"low_battery", &OptimizationThresholds::low_battery}
+};
+
+// Scenario link: 10 MHz, 60% of Shannon, thermal noise -104 dBm
+const double link_bandwidth_mhz = 10.0;
+const double link_efficiency = 0.6;
+const double noise_dbm = -104.0;
+const int base_rtt_ms = 40;
+
+} // namespace
+
+PolicyTuner::PolicyTuner() {
+    config = default_config();
+}
+
+PolicyTuner::PolicyTuner(const PolicySearchConfig& config) {
+    set_config(config);
+}
+
+PolicySearchConfig PolicyTuner::default_config() {
+    PolicySearchConfig config;
+    config.num_seeds = 8;
+    config.steps = 500;
+    config.optimize_interval = 50;
+    config.num_threads = 0;
+    config.base_seed = 1;
+    config.weight_throughput = 0.4;
+    config.weight_latency = 0.3;
+    config.weight_energy = 0.3;
+    return config;
+}
+
+PolicyCandidate PolicyTuner::default_candidate() {
+    PolicyCandidate candidate;
+    candidate.thresholds = CrossLayerOptimizer::default_thresholds();
+    return candidate;
+}
+
+void PolicyTuner::set_config(const PolicySearchConfig& config) {
+    this->config = config;
+    this->config.num_seeds = std::max(config.num_seeds, 1);
+    this->config.steps = std::max(config.steps, 1);
+    this->config.optimize_interval = std::max(config.optimize_interval, 1);
+}
+
+PolicySearchConfig PolicyTuner::get_config() const {
+    return config;
+}
+
+bool PolicyTuner::set_parameter(PolicyCandidate& candidate, const std::string& name, double value) {
+    for (const auto& field : threshold_fields) {
+        if (name == field.name) {
+            candidate.thresholds.*field.field = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> PolicyTuner::parameter_names() {
+    std::vector<std::string> names;
+    for (const auto& field : threshold_fields) {
+        names.push_back(field.name);
+    }
+    return names;
+}
+
+PolicyScore PolicyTuner::evaluate_seed(const PolicyCandidate& candidate, uint64_t stream) const {
+    CrossLayerOptimizer optimizer;
+    optimizer.set_simulation_seed(config.base_seed, stream);
+    optimizer.set_thresholds(candidate.thresholds);
+    optimizer.set_optimization_weights(config.weight_throughput, config.weight_latency, config.weight_energy);
+    std::shared_ptr<TCPTahoe> tcp = std::make_shared<TCPTahoe>(CongestionAlgorithm::RENO);
+    optimizer.register_layer(LayerType::TRANSPORT, tcp);
+
+    // Link losses draw from a stream of their own, after the optimizer's
+    std::seed_seq link_seed{static_cast<uint32_t>(config.base_seed), static_cast<uint32_t>(stream), 3u};
+    std::mt19937_64 link_rng(link_seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    double delivered_sum = 0.0, latency_sum = 0.0, energy_sum = 0.0;
+    double loss_estimate = 0.0;
+    for (int step = 0; step < config.steps; step++) {
+        optimizer.simulate_mobility();
+        optimizer.simulate_interference();
+        optimizer.simulate_traffic_variation();
+
+        LayerInfo physical = optimizer.get_layer_state(LayerType::PHYSICAL);
+        LayerInfo network = optimizer.get_layer_state(LayerType::NETWORK);
+        double signal = physical.metrics.get(METRIC_SIGNAL_STRENGTH, -80.0);
+        double interference = physical.metrics.get(METRIC_INTERFERENCE, 0.1);
+        double error_rate = physical.metrics.get(METRIC_ERROR_RATE, 0.01);
+        double traffic_load = network.metrics.get(METRIC_TRAFFIC_LOAD, 0.5);
+
+        // Capacity left by background traffic on an interference-limited link
+        double sinr = std::pow(10.0, (signal - noise_dbm) / 10.0) / (1.0 + 100.0 * interference);
+        double capacity = link_bandwidth_mhz * link_efficiency * std::log2(1.0 + sinr) * (1.0 - 0.5 * traffic_load);
+        capacity = std::max(capacity, 0.1);
+
+        // One round of the window: excess over capacity queues, and a
+        // queue beyond one BDP overflows
+        double offered = tcp->get_current_throughput();
+        double queue_delay = offered > capacity ? (offered / capacity - 1.0) * base_rtt_ms : 0.0;
+        bool loss = uniform(link_rng) < error_rate || queue_delay > base_rtt_ms;
+        if (loss) {
+            for (int dup = 0; dup < 3; dup++) tcp->duplicate_ack();
+        } else {
+            tcp->send_packet();
+        }
+        tcp->update_rtt(base_rtt_ms, static_cast<int>(std::min(queue_delay, double(base_rtt_ms))));
+        loss_estimate = 0.9 * loss_estimate + 0.1 * (loss ? 1.0 : 0.0);
+        tcp->set_network_conditions(loss_estimate, std::min(offered / capacity, 1.0), tcp->get_current_rtt());
+
+        if ((step + 1) % config.optimize_interval == 0) {
+            optimizer.optimize_network_performance();
+        }
+
+        // Radio energy: bits sent, at a cost rising with path loss
+        double delivered = std::min(offered, capacity);
+        double sent_mbits = offered * base_rtt_ms / 1000.0;
+        double cost_per_mbit = 0.5 * std::pow(10.0, (-70.0 - signal) / 20.0);
+        delivered_sum += delivered;
+        latency_sum += base_rtt_ms + std::min(queue_delay, double(base_rtt_ms));
+        energy_sum += 1.0 + sent_mbits * cost_per_mbit;
+    }
+
+    PolicyScore score;
+    score.candidate = candidate;
+    score.throughput_mbps = delivered_sum / config.steps;
+    score.latency_ms = latency_sum / config.steps;
+    score.energy_mj = energy_sum / config.steps;
+    score.throughput_stddev = 0.0;
+    score.score = 0.0;
+    score.pareto_optimal = false;
+    return score;
+}
+
+std::vector<PolicyScore> PolicyTuner::evaluate(const std::vector<PolicyCandidate>& candidates) const {
+    size_t seeds = static_cast<size_t>(config.num_seeds);
+    size_t tasks = candidates.size() * seeds;
+    std::vector<PolicyScore> runs(tasks);
+
+    // Workers pull (candidate, seed) tasks from a shared counter
+    std::atomic<size_t> next_task(0);
+    auto worker = [&]() {
+        for (size_t task = next_task++; task < tasks; task = next_task++) {
+            runs[task] = evaluate_seed(candidates[task / seeds], task % seeds);
+        }
+    };
+    int threads = config.num_threads > 0 ? config.num_threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = static_cast<int>(std::min<size_t>(std::max(threads, 1), std::max<size_t>(tasks, 1)));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    std::vector<PolicyScore> scores;
+    for (size_t c = 0; c < candidates.size(); c++) {
+        PolicyScore score = runs[c * seeds];
+        double throughput = 0.0, latency = 0.0, energy = 0.0, squares = 0.0;
+        for (size_t s = 0; s < seeds; s++) {
+            const PolicyScore& run = runs[c * seeds + s];
+            throughput += run.throughput_mbps;
+            latency += run.latency_ms;
+            energy += run.energy_mj;
+            squares += run.throughput_mbps * run.throughput_mbps;
+        }
+        score.throughput_mbps = throughput / seeds;
+        score.latency_ms = latency / seeds;
+        score.energy_mj = energy / seeds;
+        score.throughput_stddev = std::sqrt(std::max(squares / seeds - score.throughput_mbps * score.throughput_mbps, 0.0));
+        scores.push_back(score);
+    }
+
+    // Objectives normalised to [0, 1] over this set before weighting
+    if (!scores.empty()) {
+        double t_min = scores[0].throughput_mbps, t_max = t_min;
+        double l_min = scores[0].latency_ms, l_max = l_min;
+        double e_min = scores[0].energy_mj, e_max = e_min;
+        for (const auto& score : scores) {
+            t_min = std::min(t_min, score.throughput_mbps); t_max = std::max(t_max, score.throughput_mbps);
+            l_min = std::min(l_min, score.latency_ms); l_max = std::max(l_max, score.latency_ms);
+            e_min = std::min(e_min, score.energy_mj); e_max = std::max(e_max, score.energy_mj);
+        }
+        for (auto& score : scores) {
+            double t = t_max > t_min ? (score.throughput_mbps - t_min) / (t_max - t_min) : 1.0;
+            double l = l_max > l_min ? (l_max - score.latency_ms) / (l_max - l_min) : 1.0;
+            double e = e_max > e_min ? (e_max - score.energy_mj) / (e_max - e_min) : 1.0;
+            score.score = config.weight_throughput * t + config.weight_latency * l + config.weight_energy * e;
+        }
+    }
+
+    std::vector<PolicyScore> front = pareto_front(scores);
+    for (auto& score : scores) {
+        for (const auto& optimal : front) {
+            if (score.throughput_mbps == optimal.throughput_mbps && score.latency_ms == optimal.latency_ms &&
+                score.energy_mj == optimal.energy_mj) {
+                score.pareto_optimal = true;
+            }
+        }
+    }
+    return scores;
+}
+
+std::vector<PolicyScore> PolicyTuner::grid_search(const PolicyCandidate& base,
+                                                  const std::map<std::string, std::vector<double>>& grid) {
+    last_error.clear();
+    std::vector<PolicyCandidate> candidates(1, base);
+    for (const auto& axis : grid) {
+        PolicyCandidate probe = base;
+        if (!set_parameter(probe, axis.first, 0.0)) {
+            last_error = "Unknown policy parameter: " + axis.first;
+            return std::vector<PolicyScore>();
+        }
+        if (axis.second.empty()) continue;
+
+        std::vector<PolicyCandidate> expanded;
+        expanded.reserve(candidates.size() * axis.second.size());
+        for (const auto& candidate : candidates) {
+            for (double value : axis.second) {
+                PolicyCandidate next = candidate;
+                set_parameter(next, axis.first, value);
+                expanded.push_back(next);
+            }
+        }
+        candidates.swap(expanded);
+    }
+    return evaluate(candidates);
+}
+
+std::vector<PolicyScore> PolicyTuner::random_search(const PolicyCandidate& base,
+                                                    const std::map<std::string, std::pair<double, double>>& ranges,
+                                                    int num_samples) {
+    last_error.clear();
+    for (const auto& range : ranges) {
+        PolicyCandidate probe = base;
+        if (!set_parameter(probe, range.first, 0.0)) {
+            last_error = "Unknown policy parameter: " + range.first;
+            return std::vector<PolicyScore>();
+        }
+    }
+
+    std::seed_seq sample_seed{static_cast<uint32_t>(config.base_seed), static_cast<uint32_t>(config.base_seed >> 32), 4u};
+    std::mt19937_64 rng(sample_seed);
+    std::vector<PolicyCandidate> candidates;
+    for (int sample = 0; sample < num_samples; sample++) {
+        PolicyCandidate candidate = base;
+        for (const auto& range : ranges) {
+            std::uniform_real_distribution<double> value(std::min(range.second.first, range.second.second),
+                                                         std::max(range.second.first, range.second.second));
+            set_parameter(candidate, range.first, value(rng));
+        }
+        candidates.push_back(candidate);
+    }
+    return evaluate(candidates);
+}
+
+std::string PolicyTuner::get_last_error() const {
+    return last_error;
+}
+
+std::vector<PolicyScore> PolicyTuner::pareto_front(const std::vector<PolicyScore>& scores) {
+    std::vector<PolicyScore> front;
+    for (size_t i = 0; i < scores.size(); i++) {
+        const PolicyScore& a = scores[i];
+        bool dominated = false;
+        for (size_t j = 0; j < scores.size() && !dominated; j++) {
+            const PolicyScore& b = scores[j];
+            bool no_worse = b.throughput_mbps >= a.throughput_mbps && b.latency_ms <= a.latency_ms &&
+                            b.energy_mj <= a.energy_mj;
+            bool better = b.throughput_mbps > a.throughput_mbps || b.latency_ms < a.latency_ms ||
+                          b.energy_mj < a.energy_mj;
+            dominated = j != i && no_worse && better;
+        }
+        if (!dominated) {
+            front.push_back(a);
+            front.back().pareto_optimal = true;
+        }
+    }
+    std::sort(front.begin(), front.end(), [](const PolicyScore& a, const PolicyScore& b) {
+        return a.score > b.score;
+    });
+    return front;
+}
+
+void PolicyTuner::apply(const PolicyCandidate& candidate, CrossLayerOptimizer& optimizer) const {
+    optimizer.set_thresholds(candidate.thresholds);
+    optimizer.set_optimization_weights(config.weight_throughput, config.weight_latency, config.weight_energy);
+}
@@ -0,0 +1,79 @@
+#ifndef POLICY_TUNER_H
+#define POLICY_TUNER_H
+
+#include "cross_layer_protocol.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+
+// The optimizer's weights steer none of its rules, so a candidate is the
+// threshold vector; the weights instead rank the resulting front
+struct PolicyCandidate {
+    OptimizationThresholds thresholds;
+};
+
+struct PolicyScore {
+    PolicyCandidate candidate;
+    double throughput_mbps;         // Means over seeds
+    double latency_ms;
+    double energy_mj;               // Per step
+    double throughput_stddev;       // Across seeds
+    double score;                   // Weighted, objectives normalised over the evaluated set
+    bool pareto_optimal;
+};
+
+struct PolicySearchConfig {
+    int num_seeds;                  // Scenarios per candidate
+    int steps;                      // Rounds per scenario
+    int optimize_interval;          // Rounds between optimize_network_performance calls
+    int num_threads;                // 0: hardware concurrency
+    uint64_t base_seed;
+    double weight_throughput;       // Scalarisation into score, as set_optimization_weights
+    double weight_latency;
+    double weight_energy;
+};
+
+// Evaluates policies on a native synthetic scenario: a CrossLayerOptimizer
+// with its own TCPTahoe runs the mobility/interference/traffic simulation,
+// and a Shannon-capacity link built from that PHY state carries the TCP
+// window. Each (candidate, seed) pair is one independent task on a worker
+// thread, seeded as stream seed of base_seed.
+class PolicyTuner {
+private:
+    PolicySearchConfig config;
+    std::string last_error;
+
+    PolicyScore evaluate_seed(const PolicyCandidate& candidate, uint64_t stream) const;
+
+public:
+    PolicyTuner();
+    explicit PolicyTuner(const PolicySearchConfig& config);
+
+    static PolicySearchConfig default_config();
+    static PolicyCandidate default_candidate();
+    void set_config(const PolicySearchConfig& config);
+    PolicySearchConfig get_config() const;
+
+    // Parameter names are the OptimizationThresholds fields
+    static bool set_parameter(PolicyCandidate& candidate, const std::string& name, double value);
+    static std::vector<std::string> parameter_names();
+
+    std::vector<PolicyScore> evaluate(const std::vector<PolicyCandidate>& candidates) const;
+    // Cartesian product of the listed values applied to base; empty and
+    // get_last_error() set on an unknown parameter
+    std::vector<PolicyScore> grid_search(const PolicyCandidate& base,
+                                         const std::map<std::string, std::vector<double>>& grid);
+    // Uniform samples within [low, high] per parameter
+    std::vector<PolicyScore> random_search(const PolicyCandidate& base,
+                                           const std::map<std::string, std::pair<double, double>>& ranges,
+                                           int num_samples);
+    std::string get_last_error() const;
+
+    // Non-dominated scores: higher throughput, lower latency and energy
+    static std::vector<PolicyScore> pareto_front(const std::vector<PolicyScore>& scores);
+    // Thresholds of the candidate, weights of the search
+    void apply(const PolicyCandidate& candidate, CrossLayerOptimizer& optimizer) const;
+};
+
+#endif // POLICY_TUNER_H
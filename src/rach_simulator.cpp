@@ -0,0 +1,361 @@
+#include "rach_simulator.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+RACHSimulator::RACHSimulator(const RACHConfig& config) : config(config) {
+    this->config.num_preambles = std::max(this->config.num_preambles, 1);
+    this->config.rach_period_ms = std::max(this->config.rach_period_ms, 1);
+    this->config.max_rar_grants = std::max(this->config.max_rar_grants, 0);
+    this->config.max_preamble_transmissions = std::min(std::max(this->config.max_preamble_transmissions, 1), 200);
+    rng.seed(config.seed);
+
+    total_preambles_sent = 0;
+    total_collided_preambles = 0;
+    total_collided_devices = 0;
+    total_rar_shortages = 0;
+    total_barred_checks = 0;
+}
+
+RACHConfig RACHSimulator::default_config() {
+    // 3GPP TR 37.868 evaluation parameters
+    RACHConfig config;
+    config.num_preambles = 54;
+    config.rach_period_ms = 5;
+    config.rar_delay_ms = 3;
+    config.rar_window_ms = 5;
+    config.max_rar_grants = 12;
+    config.msg3_delay_ms = 6;
+    config.msg4_delay_ms = 5;
+    config.contention_resolution_ms = 48;
+    config.backoff_indicator_ms = 20;
+    config.max_preamble_transmissions = 10;
+    config.acb_barring_factor = 1.0;
+    config.acb_barring_time_ms = 4000.0;
+    config.arrival_model = RACHArrivalModel::BETA;
+    config.activation_period_ms = 10000;
+    config.seed = 1;
+    return config;
+}
+
+void RACHSimulator::set_state(size_t device, RACHDeviceState state) {
+    uint64_t& word = packed_states[device >> 5];
+    int shift = static_cast<int>(device & 31) * 2;
+    word = (word & ~(uint64_t(3) << shift)) | (uint64_t(state) << shift);
+}
+
+RACHDeviceState RACHSimulator::get_device_state(size_t device) const {
+    if (device >= arrival_ms.size()) return RACHDeviceState::PENDING;
+    int shift = static_cast<int>(device & 31) * 2;
+    return static_cast<RACHDeviceState>((packed_states[device >> 5] >> shift) & 3);
+}
+
+uint32_t RACHSimulator::sample_arrival() {
+    double period = std::max(config.activation_period_ms, 1);
+    if (config.arrival_model == RACHArrivalModel::BETA) {
+        // Beta(3, 4) as the ratio of gamma variates
+        std::gamma_distribution<double> gamma_a(3.0, 1.0);
+        std::gamma_distribution<double> gamma_b(4.0, 1.0);
+        double a = gamma_a(rng);
+        double b = gamma_b(rng);
+        return static_cast<uint32_t>(period * a / (a + b));
+    }
+    std::uniform_real_distribution<double> dis(0.0, period);
+    return static_cast<uint32_t>(dis(rng));
+}
+
+uint32_t RACHSimulator::sample_backoff() {
+    if (config.backoff_indicator_ms <= 0) return 0;
+    std::uniform_int_distribution<int> dis(0, config.backoff_indicator_ms);
+    return static_cast<uint32_t>(dis(rng));
+}
+
+uint32_t RACHSimulator::next_opportunity(uint32_t time_ms) const {
+    uint32_t period = static_cast<uint32_t>(config.rach_period_ms);
+    return (time_ms + period - 1) / period;
+}
+
+void RACHSimulator::attach_devices(const LTENetwork& network, int num_devices, double area_width, double area_height) {
+    std::vector<CellInfo> cells = network.get_cells();
+    std::uniform_real_distribution<double> x_dis(0.0, area_width);
+    std::uniform_real_distribution<double> y_dis(0.0, area_height);
+
+    std::vector<int> ids(std::max(num_devices, 0), cells.empty() ? 0 : cells[0].cell_id);
+    for (int i = 0; i < num_devices; i++) {
+        double x = x_dis(rng);
+        double y = y_dis(rng);
+        double best_rsrp = -1e9;
+        for (const auto& cell : cells) {
+            double rsrp = network.calculate_rsrp_at(x, y, cell);
+            if (rsrp > best_rsrp) {
+                best_rsrp = rsrp;
+                ids[i] = cell.cell_id;
+            }
+        }
+    }
+    set_device_cells(ids);
+}
+
+void RACHSimulator::set_device_cells(const std::vector<int>& device_cell_ids) {
+    size_t num_devices = device_cell_ids.size();
+
+    cell_ids.clear();
+    std::map<int, int> cell_index;
+    device_cell.resize(num_devices);
+    for (size_t i = 0; i < num_devices; i++) {
+        auto it = cell_index.find(device_cell_ids[i]);
+        if (it == cell_index.end()) {
+            it = cell_index.emplace(device_cell_ids[i], static_cast<int>(cell_ids.size())).first;
+            cell_ids.push_back(device_cell_ids[i]);
+        }
+        device_cell[i] = it->second;
+    }
+
+    arrival_ms.resize(num_devices);
+    for (size_t i = 0; i < num_devices; i++) {
+        arrival_ms[i] = sample_arrival();
+    }
+
+    packed_states.assign((num_devices + 31) / 32, 0);
+    completion_ms.assign(num_devices, 0);
+    preamble_transmissions.assign(num_devices, 0);
+}
+
+void RACHSimulator::run() {
+    size_t num_devices = arrival_ms.size();
+    size_t num_cells = std::max<size_t>(cell_ids.size(), 1);
+    int num_preambles = config.num_preambles;
+
+    std::fill(packed_states.begin(), packed_states.end(), 0);
+    std::fill(completion_ms.begin(), completion_ms.end(), 0);
+    std::fill(preamble_transmissions.begin(), preamble_transmissions.end(), 0);
+    opportunity_attempts.clear();
+    opportunity_successes.clear();
+    opportunity_collisions.clear();
+    total_preambles_sent = 0;
+    total_collided_preambles = 0;
+    total_collided_devices = 0;
+    total_rar_shortages = 0;
+    total_barred_checks = 0;
+
+    // Devices enter the calendar at their first opportunity, in arrival order
+    std::vector<uint32_t> arrival_order(num_devices);
+    std::iota(arrival_order.begin(), arrival_order.end(), 0);
+    std::sort(arrival_order.begin(), arrival_order.end(),
+              [this](uint32_t a, uint32_t b) { return arrival_ms[a] < arrival_ms[b]; });
+
+    // The ring must cover the longest wait between two opportunities
+    double barring_wait = (config.acb_barring_factor < 1.0) ? 1.3 * config.acb_barring_time_ms : 0.0;
+    int retry_wait = config.rar_delay_ms + std::max(config.rar_window_ms,
+                     config.msg3_delay_ms + config.contention_resolution_ms) + config.backoff_indicator_ms;
+    double max_wait = std::max(barring_wait, static_cast<double>(retry_wait));
+    size_t ring_size = static_cast<size_t>(max_wait / config.rach_period_ms) + 3;
+    std::vector<std::vector<uint32_t>> calendar(ring_size);
+
+    // Preamble histogram over (cell, preamble) and the RAR grants per cell
+    std::vector<uint32_t> histogram(num_cells * num_preambles, 0);
+    std::vector<uint8_t> granted(num_cells * num_preambles, 0);
+    std::vector<int> cell_grants(num_cells, 0);
+    std::vector<uint32_t> touched;
+    std::vector<std::pair<uint32_t, uint32_t>> transmitters;   // (device, slot)
+    std::vector<uint32_t> current;
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int> preamble_dis(0, num_preambles - 1);
+
+    auto schedule = [&](uint32_t device, uint32_t time_ms, uint32_t opportunity) {
+        uint32_t next = std::max(next_opportunity(time_ms), opportunity + 1);
+        calendar[next % ring_size].push_back(device);
+    };
+
+    size_t next_arrival = 0;
+    size_t outstanding = 0;
+    for (uint32_t opportunity = 0; next_arrival < num_devices || outstanding > 0; opportunity++) {
+        uint32_t now = opportunity * static_cast<uint32_t>(config.rach_period_ms);
+
+        current.clear();
+        current.swap(calendar[opportunity % ring_size]);
+        outstanding -= current.size();
+        while (next_arrival < num_devices && arrival_ms[arrival_order[next_arrival]] <= now) {
+            current.push_back(arrival_order[next_arrival++]);
+        }
+
+        // Access barring, then preamble choice into the histogram
+        transmitters.clear();
+        for (uint32_t device : current) {
+            if (get_device_state(device) == RACHDeviceState::PENDING) {
+                if (config.acb_barring_factor < 1.0 && uniform(rng) >= config.acb_barring_factor) {
+                    total_barred_checks++;
+                    schedule(device, now + static_cast<uint32_t>((0.7 + 0.6 * uniform(rng)) * config.acb_barring_time_ms),
+                             opportunity);
+                    outstanding++;
+                    continue;
+                }
+                set_state(device, RACHDeviceState::ACCESSING);
+            }
+
+            uint32_t slot = static_cast<uint32_t>(device_cell[device]) * num_preambles + preamble_dis(rng);
+            if (histogram[slot]++ == 0) {
+                touched.push_back(slot);
+            }
+            transmitters.push_back(std::make_pair(device, slot));
+        }
+
+        // Msg2: every detected preamble, collided or not, competes for the
+        // cell's RAR grants
+        int collisions = 0;
+        for (uint32_t slot : touched) {
+            int cell = slot / num_preambles;
+            if (cell_grants[cell] < config.max_rar_grants) {
+                granted[slot] = 1;
+                cell_grants[cell]++;
+            }
+            collisions += (histogram[slot] > 1) ? 1 : 0;
+        }
+
+        // Msg3/Msg4: only a granted singleton survives contention resolution
+        int successes = 0;
+        for (const auto& tx : transmitters) {
+            uint32_t device = tx.first;
+            uint32_t slot = tx.second;
+            preamble_transmissions[device]++;
+
+            uint32_t retry_ms;
+            if (!granted[slot]) {
+                total_rar_shortages++;
+                retry_ms = now + config.rar_delay_ms + config.rar_window_ms;
+            } else if (histogram[slot] == 1) {
+                set_state(device, RACHDeviceState::CONNECTED);
+                completion_ms[device] = now + config.rar_delay_ms + config.msg3_delay_ms + config.msg4_delay_ms;
+                successes++;
+                continue;
+            } else {
+                total_collided_devices++;
+                retry_ms = now + config.rar_delay_ms + config.msg3_delay_ms + config.contention_resolution_ms;
+            }
+
+            if (preamble_transmissions[device] >= config.max_preamble_transmissions) {
+                set_state(device, RACHDeviceState::FAILED);
+                completion_ms[device] = retry_ms;
+                continue;
+            }
+            schedule(device, retry_ms + sample_backoff(), opportunity);
+            outstanding++;
+        }
+
+        for (uint32_t slot : touched) {
+            histogram[slot] = 0;
+            granted[slot] = 0;
+        }
+        touched.clear();
+        std::fill(cell_grants.begin(), cell_grants.end(), 0);
+
+        total_preambles_sent += transmitters.size();
+        total_collided_preambles += collisions;
+        opportunity_attempts.push_back(static_cast<int>(transmitters.size()));
+        opportunity_successes.push_back(successes);
+        opportunity_collisions.push_back(collisions);
+    }
+
+}
+
+std::map<std::string, int> RACHSimulator::get_device_state_counts() const {
+    std::map<std::string, int> counts;
+    counts["pending"] = 0;
+    counts["accessing"] = 0;
+    counts["connected"] = 0;
+    counts["failed"] = 0;
+    static const char* names[4] = {"pending", "accessing", "connected", "failed"};
+    for (size_t i = 0; i < arrival_ms.size(); i++) {
+        counts[names[static_cast<int>(get_device_state(i))]]++;
+    }
+    return counts;
+}
+
+std::vector<int> RACHSimulator::get_access_delay_histogram(int bin_ms, int max_delay_ms) const {
+    bin_ms = std::max(bin_ms, 1);
+    std::vector<int> histogram(std::max(max_delay_ms, 0) / bin_ms + 1, 0);
+    for (size_t i = 0; i < arrival_ms.size(); i++) {
+        if (get_device_state(i) != RACHDeviceState::CONNECTED) continue;
+        size_t bin = (completion_ms[i] - arrival_ms[i]) / bin_ms;
+        histogram[std::min(bin, histogram.size() - 1)]++;     // Last bin holds the tail
+    }
+    return histogram;
+}
+
+std::vector<int> RACHSimulator::get_preamble_transmission_distribution() const {
+    // Index n holds the devices that connected after n preamble transmissions
+    std::vector<int> distribution(config.max_preamble_transmissions + 1, 0);
+    for (size_t i = 0; i < arrival_ms.size(); i++) {
+        if (get_device_state(i) == RACHDeviceState::CONNECTED) {
+            distribution[preamble_transmissions[i]]++;
+        }
+    }
+    return distribution;
+}
+
+std::vector<int> RACHSimulator::get_opportunity_attempts() const {
+    return opportunity_attempts;
+}
+
+std::vector<int> RACHSimulator::get_opportunity_successes() const {
+    return opportunity_successes;
+}
+
+std::vector<int> RACHSimulator::get_opportunity_collisions() const {
+    return opportunity_collisions;
+}
+
+std::map<std::string, double> RACHSimulator::get_statistics() const {
+    std::map<std::string, double> stats;
+    size_t num_devices = arrival_ms.size();
+
+    std::vector<uint32_t> delays;
+    double transmissions = 0.0;
+    int failed = 0;
+    for (size_t i = 0; i < num_devices; i++) {
+        RACHDeviceState state = get_device_state(i);
+        if (state == RACHDeviceState::CONNECTED) {
+            delays.push_back(completion_ms[i] - arrival_ms[i]);
+            transmissions += preamble_transmissions[i];
+        } else if (state == RACHDeviceState::FAILED) {
+            failed++;
+        }
+    }
+
+    stats["num_devices"] = num_devices;
+    stats["num_cells"] = cell_ids.size();
+    stats["connected_devices"] = delays.size();
+    stats["failed_devices"] = failed;
+    stats["success_probability"] = num_devices > 0 ? static_cast<double>(delays.size()) / num_devices : 0.0;
+    stats["rach_opportunities"] = opportunity_attempts.size();
+    stats["preambles_sent"] = total_preambles_sent;
+    stats["collided_preambles"] = total_collided_preambles;
+    stats["collision_probability"] = total_preambles_sent > 0 ?
+        static_cast<double>(total_collided_devices) / total_preambles_sent : 0.0;
+    stats["rar_shortages"] = total_rar_shortages;
+    stats["barred_checks"] = total_barred_checks;
+
+    if (!delays.empty()) {
+        double sum = 0.0;
+        for (uint32_t delay : delays) sum += delay;
+        stats["mean_access_delay_ms"] = sum / delays.size();
+        stats["mean_preamble_transmissions"] = transmissions / delays.size();
+
+        auto percentile = [&delays](double p) {
+            size_t k = static_cast<size_t>(p * (delays.size() - 1));
+            std::nth_element(delays.begin(), delays.begin() + k, delays.end());
+            return static_cast<double>(delays[k]);
+        };
+        stats["p50_access_delay_ms"] = percentile(0.50);
+        stats["p95_access_delay_ms"] = percentile(0.95);
+        stats["p99_access_delay_ms"] = percentile(0.99);
+        stats["max_access_delay_ms"] = *std::max_element(delays.begin(), delays.end());
+    }
+
+    return stats;
+}
+
+size_t RACHSimulator::get_num_devices() const {
+    return arrival_ms.size();
+}
@@ -0,0 +1,211 @@
+#include "realtime_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+RealtimeRunner::RealtimeRunner(LTENetwork& network, double step_period_ms) : network(network) {
+    this->step_period_ms = std::max(step_period_ms, 0.1);
+    degrade_threshold = 0.8;
+    recover_threshold = 0.5;
+    recover_steps = 50;
+    max_degradation_level = 2;
+    publish_interval_ms = 50.0;
+
+    running = false;
+    middle_state = 1;
+    back_index = 0;
+    front_index = 2;
+    for (auto& buffer : buffers) {
+        buffer.step = 0;
+        buffer.sim_time_s = 0.0;
+        buffer.step_duration_ms = 0.0;
+        buffer.degradation_level = 0;
+        buffer.deadline_misses = 0;
+        buffer.network_throughput = 0.0;
+        buffer.active_users = 0;
+        buffer.handover_count = 0;
+    }
+
+    steps = 0;
+    deadline_misses = 0;
+    dropped_slots = 0;
+    total_step_ns = 0;
+    max_step_ns = 0;
+    degraded_steps = 0;
+    current_level = 0;
+}
+
+RealtimeRunner::~RealtimeRunner() {
+    stop();
+}
+
+void RealtimeRunner::set_step_period(double period_ms) {
+    if (running) return;
+    step_period_ms = std::max(period_ms, 0.1);
+}
+
+void RealtimeRunner::set_adaptation_parameters(double degrade_threshold, double recover_threshold,
+                                               int recover_steps, int max_level) {
+    if (running) return;
+    this->degrade_threshold = degrade_threshold;
+    this->recover_threshold = std::min(recover_threshold, degrade_threshold);
+    this->recover_steps = std::max(recover_steps, 1);
+    max_degradation_level = std::min(std::max(max_level, 0), 2);
+}
+
+void RealtimeRunner::set_publish_interval(double interval_ms) {
+    if (running) return;
+    publish_interval_ms = std::max(interval_ms, 0.0);
+}
+
+void RealtimeRunner::start() {
+    if (running) return;
+    steps = 0;
+    deadline_misses = 0;
+    dropped_slots = 0;
+    total_step_ns = 0;
+    max_step_ns = 0;
+    degraded_steps = 0;
+    running = true;
+    worker = std::thread(&RealtimeRunner::run_loop, this);
+}
+
+void RealtimeRunner::stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    network.set_step_degradation(0, 1);
+    current_level = 0;
+}
+
+bool RealtimeRunner::is_running() const {
+    return running;
+}
+
+void RealtimeRunner::run_loop() {
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double, std::milli>(step_period_ms));
+    const auto degrade_budget = std::chrono::duration_cast<clock::duration>(period * degrade_threshold);
+    const auto recover_budget = std::chrono::duration_cast<clock::duration>(period * recover_threshold);
+
+    int level = 0;
+    int fast_steps = 0;
+    network.set_step_degradation(level, 4);
+
+    // Dashboards poll far slower than the step rate, so copy out on a cadence
+    int publish_steps = std::max(1, static_cast<int>(std::lround(publish_interval_ms / step_period_ms)));
+    int previous_interval = network.get_snapshot_interval();
+    network.set_snapshot_interval(publish_steps);
+    auto deadline = clock::now() + period;
+
+    while (running) {
+        auto step_start = clock::now();
+        network.step_simulation();
+        auto step_end = clock::now();
+        auto duration = step_end - step_start;
+
+        uint64_t step_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        uint64_t step = ++steps;
+        total_step_ns += step_ns;
+        if (step_ns > max_step_ns) max_step_ns = step_ns;
+        if (level > 0) degraded_steps++;
+        if (step_end > deadline) deadline_misses++;
+
+        if (step % publish_steps == 0) {
+            publish_snapshot(step, step_ns / 1e6);
+        }
+
+        // Shed work as soon as a step eats into the headroom, recover slowly
+        if (duration > degrade_budget) {
+            level = std::min(level + 1, max_degradation_level);
+            fast_steps = 0;
+        } else if (duration < recover_budget && level > 0) {
+            if (++fast_steps >= recover_steps) {
+                level--;
+                fast_steps = 0;
+            }
+        } else {
+            fast_steps = 0;
+        }
+        network.set_step_degradation(level, 4);
+        current_level = level;
+
+        // Fixed-rate deadlines; slots already lost are dropped, not replayed
+        auto now = clock::now();
+        if (now > deadline + period) {
+            auto behind = (now - deadline) / period;
+            dropped_slots += behind;
+            deadline += period * behind;
+        }
+        std::this_thread::sleep_until(deadline);
+        deadline += period;
+    }
+
+    // Leave the network's snapshot current for readers after the run
+    network.set_snapshot_interval(previous_interval);
+    network.publish_snapshot();
+}
+
+void RealtimeRunner::publish_snapshot(uint64_t step, double step_duration_ms) {
+    RealtimeSnapshot& snapshot = buffers[back_index];
+    snapshot.step = step;
+    snapshot.sim_time_s = step * step_period_ms / 1000.0;
+    snapshot.step_duration_ms = step_duration_ms;
+    snapshot.degradation_level = network.get_step_degradation();
+    snapshot.deadline_misses = deadline_misses;
+    snapshot.network_throughput = network.get_network_throughput();
+    snapshot.active_users = network.get_active_users_count();
+    snapshot.handover_count = network.get_handover_count();
+
+    // Buffers are reused, so the vectors keep their capacity between steps
+    const std::vector<UserEquipment>& users = network.get_users_ref();
+    snapshot.ue_ids.resize(users.size());
+    snapshot.ue_positions.resize(users.size() * 2);
+    snapshot.ue_serving_cell.resize(users.size());
+    snapshot.ue_throughput.resize(users.size());
+    for (size_t i = 0; i < users.size(); i++) {
+        snapshot.ue_ids[i] = users[i].ue_id;
+        snapshot.ue_positions[2 * i] = users[i].x_position;
+        snapshot.ue_positions[2 * i + 1] = users[i].y_position;
+        snapshot.ue_serving_cell[i] = users[i].serving_cell;
+        snapshot.ue_throughput[i] = users[i].current_throughput;
+    }
+
+    // Swap the filled buffer into the middle and mark it fresh
+    int previous = middle_state.exchange(back_index | 4, std::memory_order_acq_rel);
+    back_index = previous & 3;
+}
+
+bool RealtimeRunner::poll_snapshot(RealtimeSnapshot& snapshot) {
+    if (!(middle_state.load(std::memory_order_acquire) & 4)) return false;
+    int previous = middle_state.exchange(front_index, std::memory_order_acq_rel);
+    front_index = previous & 3;
+    snapshot = buffers[front_index];
+    return true;
+}
+
+RealtimeSnapshot RealtimeRunner::get_latest_snapshot() {
+    RealtimeSnapshot snapshot;
+    if (!poll_snapshot(snapshot)) {
+        snapshot = buffers[front_index];
+    }
+    return snapshot;
+}
+
+std::map<std::string, double> RealtimeRunner::get_statistics() const {
+    std::map<std::string, double> stats;
+    uint64_t step_count = steps;
+    stats["steps"] = step_count;
+    stats["step_period_ms"] = step_period_ms;
+    stats["deadline_misses"] = deadline_misses;
+    stats["deadline_miss_rate"] = step_count > 0 ? static_cast<double>(deadline_misses) / step_count : 0.0;
+    stats["dropped_slots"] = dropped_slots;
+    stats["mean_step_ms"] = step_count > 0 ? total_step_ns / 1e6 / step_count : 0.0;
+    stats["max_step_ms"] = max_step_ns / 1e6;
+    stats["degraded_steps"] = degraded_steps;
+    stats["degradation_level"] = current_level;
+    stats["running"] = running ? 1.0 : 0.0;
+    return stats;
+}
@@ -0,0 +1,95 @@
+#ifndef REALTIME_RUNNER_H
+#define REALTIME_RUNNER_H
+
+#include "lte_network.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+// Per-step view published to dashboard readers
+struct RealtimeSnapshot {
+    uint64_t step;
+    double sim_time_s;
+    double step_duration_ms;
+    int degradation_level;
+    uint64_t deadline_misses;
+    double network_throughput;
+    int active_users;
+    int handover_count;
+    std::vector<int> ue_ids;
+    std::vector<double> ue_positions;       // x0, y0, x1, y1, ...
+    std::vector<int> ue_serving_cell;
+    std::vector<double> ue_throughput;
+};
+
+// Steps an LTENetwork on a dedicated thread at a fixed wall-clock period.
+// Each step has an absolute deadline; when steps run long the runner raises
+// the network's degradation level (skip KPI aggregation, then coarsen idle
+// UE updates) and lowers it again once there is headroom. Steps that finish
+// after their deadline are counted as misses, and when the runner falls
+// more than a period behind it drops the missed slots instead of bursting.
+// Snapshots reach the reader through a lock-free triple buffer; one reader
+// thread at a time may poll. Both the runner's snapshot and the network's
+// own are published every publish_interval_ms rather than every step.
+// While the runner is started, other threads may only read the network
+// through its snapshot getters.
+class RealtimeRunner {
+private:
+    LTENetwork& network;
+    double step_period_ms;
+    double degrade_threshold;       // Fraction of the period that raises the level
+    double recover_threshold;       // Fraction of the period that lowers it
+    int recover_steps;              // Consecutive fast steps before lowering
+    int max_degradation_level;
+    double publish_interval_ms;
+
+    std::thread worker;
+    std::atomic<bool> running;
+
+    // Triple buffer: the writer owns back_index, the reader front_index, and
+    // middle_state holds the third index plus a fresh bit
+    RealtimeSnapshot buffers[3];
+    std::atomic<int> middle_state;
+    int back_index;
+    int front_index;
+
+    // Statistics, written by the worker and read by anyone
+    std::atomic<uint64_t> steps;
+    std::atomic<uint64_t> deadline_misses;
+    std::atomic<uint64_t> dropped_slots;
+    std::atomic<uint64_t> total_step_ns;
+    std::atomic<uint64_t> max_step_ns;
+    std::atomic<uint64_t> degraded_steps;
+    std::atomic<int> current_level;
+
+    void run_loop();
+    void publish_snapshot(uint64_t step, double step_duration_ms);
+
+public:
+    RealtimeRunner(LTENetwork& network, double step_period_ms = 10.0);
+    ~RealtimeRunner();
+
+    RealtimeRunner(const RealtimeRunner&) = delete;
+    RealtimeRunner& operator=(const RealtimeRunner&) = delete;
+
+    // Configuration, before start()
+    void set_step_period(double period_ms);
+    void set_adaptation_parameters(double degrade_threshold, double recover_threshold,
+                                   int recover_steps, int max_level);
+    void set_publish_interval(double interval_ms);
+
+    // Control
+    void start();
+    void stop();
+    bool is_running() const;
+
+    // Reader side
+    bool poll_snapshot(RealtimeSnapshot& snapshot);
+    RealtimeSnapshot get_latest_snapshot();
+    std::map<std::string, double> get_statistics() const;
+};
+
+#endif // REALTIME_RUNNER_H
@@ -0,0 +1,215 @@
+#include "rlc_buffer.h"
+#include <algorithm>
+
+RLCBufferPool::RLCBufferPool() {
+    capacity_per_ue = 0;
+    max_ues = 0;
+    discard_timer_ms = 0.0;
+}
+
+void RLCBufferPool::configure(int max_ues, int capacity_per_ue, double discard_timer_ms) {
+    this->max_ues = std::max(max_ues, 0);
+    this->capacity_per_ue = std::max(capacity_per_ue, 0);
+    this->discard_timer_ms = std::max(discard_timer_ms, 0.0);
+
+    size_t slots = static_cast<size_t>(this->max_ues);
+    segments.assign(slots * this->capacity_per_ue, RLCSegment());
+    head.assign(slots, 0);
+    count.assign(slots, 0);
+    queued_bytes.assign(slots, 0);
+    delay_ewma_ms.assign(slots, 0.0);
+    served_bytes.assign(slots, 0);
+    last_served_bytes.assign(slots, 0);
+    last_discards.assign(slots, 0);
+    overflow_drops.assign(slots, 0);
+    pdcp_discards.assign(slots, 0);
+
+    ue_slots.clear();
+    ue_slots.reserve(slots);
+    slot_owner.assign(slots, -1);
+    free_slots.clear();
+    for (int slot = this->max_ues - 1; slot >= 0; slot--) {
+        free_slots.push_back(slot);
+    }
+}
+
+bool RLCBufferPool::enabled() const {
+    return max_ues > 0 && capacity_per_ue > 0;
+}
+
+void RLCBufferPool::clear() {
+    configure(max_ues, capacity_per_ue, discard_timer_ms);
+}
+
+void RLCBufferPool::reset_slot(int slot) {
+    head[slot] = 0;
+    count[slot] = 0;
+    queued_bytes[slot] = 0;
+    delay_ewma_ms[slot] = 0.0;
+    served_bytes[slot] = 0;
+    last_served_bytes[slot] = 0;
+    last_discards[slot] = 0;
+    overflow_drops[slot] = 0;
+    pdcp_discards[slot] = 0;
+}
+
+int RLCBufferPool::attach(int ue_id) {
+    auto it = ue_slots.find(ue_id);
+    if (it != ue_slots.end()) return it->second;
+    if (free_slots.empty()) return -1;
+
+    int slot = free_slots.back();
+    free_slots.pop_back();
+    reset_slot(slot);
+    slot_owner[slot] = ue_id;
+    ue_slots[ue_id] = slot;
+    return slot;
+}
+
+void RLCBufferPool::detach(int ue_id) {
+    auto it = ue_slots.find(ue_id);
+    if (it == ue_slots.end()) return;
+    slot_owner[it->second] = -1;
+    free_slots.push_back(it->second);
+    ue_slots.erase(it);
+}
+
+int RLCBufferPool::find_slot(int ue_id) const {
+    auto it = ue_slots.find(ue_id);
+    return it == ue_slots.end() ? -1 : it->second;
+}
+
+void RLCBufferPool::pop_head(int slot) {
+    head[slot] = (head[slot] + 1) % capacity_per_ue;
+    count[slot]--;
+}
+
+bool RLCBufferPool::enqueue(int ue_id, uint32_t sdu_id, uint32_t bytes, double now_ms) {
+    int slot = attach(ue_id);
+    if (slot < 0) return false;
+    if (count[slot] >= static_cast<uint32_t>(capacity_per_ue)) {
+        overflow_drops[slot]++;
+        return false;
+    }
+
+    uint32_t tail = (head[slot] + count[slot]) % capacity_per_ue;
+    RLCSegment& segment = segments[static_cast<size_t>(slot) * capacity_per_ue + tail];
+    segment.arrival_ms = now_ms;
+    segment.sdu_id = sdu_id;
+    segment.bytes_total = bytes;
+    segment.bytes_remaining = bytes;
+    count[slot]++;
+    queued_bytes[slot] += bytes;
+    return true;
+}
+
+uint64_t RLCBufferPool::drain(int slot, uint64_t budget_bytes, double now_ms) {
+    RLCSegment* ring = &segments[static_cast<size_t>(slot) * capacity_per_ue];
+    uint64_t served = 0;
+
+    // Segmentation: the last SDU served this TTI may be sent in part
+    while (budget_bytes > 0 && count[slot] > 0) {
+        RLCSegment& segment = ring[head[slot]];
+        uint32_t take = static_cast<uint32_t>(std::min<uint64_t>(segment.bytes_remaining, budget_bytes));
+        segment.bytes_remaining -= take;
+        budget_bytes -= take;
+        served += take;
+        if (segment.bytes_remaining > 0) break;
+        pop_head(slot);
+    }
+
+    // Sampled every TTI, including ones that complete nothing
+    double sojourn = count[slot] > 0 ? now_ms - ring[head[slot]].arrival_ms : 0.0;
+    delay_ewma_ms[slot] += 0.125 * (sojourn - delay_ewma_ms[slot]);
+
+    queued_bytes[slot] -= served;
+    served_bytes[slot] += served;
+    last_served_bytes[slot] = served;
+    return served;
+}
+
+int RLCBufferPool::discard_expired(int slot, double now_ms) {
+    last_discards[slot] = 0;
+    if (discard_timer_ms <= 0.0 || count[slot] == 0) return 0;
+    RLCSegment* ring = &segments[static_cast<size_t>(slot) * capacity_per_ue];
+
+    // A partly sent head SDU has left PDCP and is not discarded; set it aside
+    // while the expired SDUs behind it are dropped, then put it back
+    bool partial = ring[head[slot]].bytes_remaining < ring[head[slot]].bytes_total;
+    RLCSegment held = ring[head[slot]];
+    if (partial) pop_head(slot);
+
+    int discarded = 0;
+    while (count[slot] > 0 && now_ms - ring[head[slot]].arrival_ms > discard_timer_ms) {
+        queued_bytes[slot] -= ring[head[slot]].bytes_remaining;
+        pop_head(slot);
+        discarded++;
+    }
+
+    if (partial) {
+        head[slot] = (head[slot] + capacity_per_ue - 1) % capacity_per_ue;
+        ring[head[slot]] = held;
+        count[slot]++;
+    }
+    pdcp_discards[slot] += discarded;
+    last_discards[slot] = discarded;
+    return discarded;
+}
+
+uint64_t RLCBufferPool::get_queued_bytes(int ue_id) const {
+    int slot = find_slot(ue_id);
+    return slot < 0 ? 0 : queued_bytes[slot];
+}
+
+int RLCBufferPool::get_queue_length(int ue_id) const {
+    int slot = find_slot(ue_id);
+    return slot < 0 ? 0 : static_cast<int>(count[slot]);
+}
+
+double RLCBufferPool::get_queuing_delay(int ue_id) const {
+    int slot = find_slot(ue_id);
+    return slot < 0 ? 0.0 : delay_ewma_ms[slot];
+}
+
+double RLCBufferPool::get_head_of_line_delay(int ue_id, double now_ms) const {
+    int slot = find_slot(ue_id);
+    if (slot < 0 || count[slot] == 0) return 0.0;
+    return now_ms - segments[static_cast<size_t>(slot) * capacity_per_ue + head[slot]].arrival_ms;
+}
+
+uint64_t RLCBufferPool::get_last_served_bytes(int ue_id) const {
+    int slot = find_slot(ue_id);
+    return slot < 0 ? 0 : last_served_bytes[slot];
+}
+
+int RLCBufferPool::get_last_discards(int ue_id) const {
+    int slot = find_slot(ue_id);
+    return slot < 0 ? 0 : static_cast<int>(last_discards[slot]);
+}
+
+std::map<std::string, double> RLCBufferPool::get_statistics() const {
+    std::map<std::string, double> stats;
+    double total_queued = 0.0, total_served = 0.0, total_drops = 0.0, total_discards = 0.0;
+    double delay_sum = 0.0, max_delay = 0.0;
+    int attached = 0;
+    for (int slot = 0; slot < max_ues; slot++) {
+        if (slot_owner[slot] < 0) continue;
+        attached++;
+        total_queued += queued_bytes[slot];
+        total_served += served_bytes[slot];
+        total_drops += overflow_drops[slot];
+        total_discards += pdcp_discards[slot];
+        delay_sum += delay_ewma_ms[slot];
+        max_delay = std::max(max_delay, delay_ewma_ms[slot]);
+    }
+
+    stats["attached_ues"] = attached;
+    stats["capacity_per_ue"] = capacity_per_ue;
+    stats["queued_bytes"] = total_queued;
+    stats["served_bytes"] = total_served;
+    stats["overflow_drops"] = total_drops;
+    stats["pdcp_discards"] = total_discards;
+    stats["mean_queuing_delay_ms"] = attached > 0 ? delay_sum / attached : 0.0;
+    stats["max_queuing_delay_ms"] = max_delay;
+    return stats;
+}
@@ -0,0 +1,77 @@
+#ifndef RLC_BUFFER_H
+#define RLC_BUFFER_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+// One PDCP SDU waiting in (or partly sent from) an RLC buffer
+struct RLCSegment {
+    double arrival_ms;
+    uint32_t sdu_id;
+    uint32_t bytes_total;
+    uint32_t bytes_remaining;
+};
+
+// Downlink RLC/PDCP buffers for many UEs. Every UE owns a fixed-capacity
+// ring of segment descriptors inside one contiguous pool, and the per-UE
+// queue state is kept in parallel arrays, so enqueue, drain and discard
+// never allocate. Full rings drop at the tail; the PDCP discard timer drops
+// SDUs that waited too long before their first byte was sent. The queuing
+// delay follows the head SDU's sojourn time, so a stalled queue shows it.
+class RLCBufferPool {
+private:
+    int capacity_per_ue;
+    int max_ues;
+    double discard_timer_ms;            // 0 disables PDCP discard
+
+    std::vector<RLCSegment> segments;   // [slot * capacity_per_ue + i]
+    std::vector<uint32_t> head;
+    std::vector<uint32_t> count;
+    std::vector<uint64_t> queued_bytes;
+    std::vector<double> delay_ewma_ms;  // Smoothed head-of-line sojourn, sampled every TTI
+    std::vector<uint64_t> served_bytes;
+    std::vector<uint64_t> last_served_bytes;
+    std::vector<uint32_t> last_discards;
+    std::vector<uint64_t> overflow_drops;
+    std::vector<uint64_t> pdcp_discards;
+
+    std::unordered_map<int, int> ue_slots;
+    std::vector<int> slot_owner;        // ue_id or -1
+    std::vector<int> free_slots;
+
+    void reset_slot(int slot);
+    void pop_head(int slot);
+
+public:
+    RLCBufferPool();
+
+    void configure(int max_ues, int capacity_per_ue, double discard_timer_ms);
+    bool enabled() const;
+    void clear();
+
+    // Slots
+    int attach(int ue_id);
+    void detach(int ue_id);
+    int find_slot(int ue_id) const;
+
+    // Data path
+    bool enqueue(int ue_id, uint32_t sdu_id, uint32_t bytes, double now_ms);
+    uint64_t drain(int slot, uint64_t budget_bytes, double now_ms);
+    int discard_expired(int slot, double now_ms);
+
+    // Per-UE state
+    uint64_t get_queued_bytes(int ue_id) const;
+    int get_queue_length(int ue_id) const;
+    double get_queuing_delay(int ue_id) const;
+    double get_head_of_line_delay(int ue_id, double now_ms) const;
+    // What the last drain/discard pass did to the UE's queue
+    uint64_t get_last_served_bytes(int ue_id) const;
+    int get_last_discards(int ue_id) const;
+
+    std::map<std::string, double> get_statistics() const;
+};
+
+#endif // RLC_BUFFER_H
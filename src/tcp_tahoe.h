@@ -49,6 +49,11 @@ private:
     double packet_loss_rate;
     double network_utilization;
     int queue_delay;
+    
+    int algorithm_switches;
+    
+    double calculate_throughput() const;
+    void handoff_state(CongestionAlgorithm next);
 
 public:
     TCPTahoe(CongestionAlgorithm algo = CongestionAlgorithm::TAHOE);
@@ -69,6 +74,7 @@ public:
     void set_network_conditions(double loss_rate, double utilization, int delay);
     void simulate_network_congestion();
     void adaptive_congestion_response();
+    void update_rtt(int base_rtt, int queuing_delay);
     
     // Getters
     int get_current_cwnd() const;
@@ -82,8 +88,12 @@ public:
     double get_current_throughput() const;
     double get_packet_loss_rate() const;
     double get_network_utilization() const;
+    int get_current_rtt() const;
+    int get_algorithm_switch_count() const;
     
     // Setters
+    // Switches controller keeping cwnd, ssthresh, RTT estimates and
+    // histories; no-op if algo is already active
     void set_algorithm(CongestionAlgorithm algo);
     void reset();
 };
@@ -27,6 +27,8 @@ TCPTahoe::TCPTahoe(CongestionAlgorithm algo) {
     packet_loss_rate = 0.0;
     network_utilization = 0.0;
     queue_delay = 0;
+    
+    algorithm_switches = 0;
 }
 
 void TCPTahoe::send_packet() {
@@ -274,6 +276,18 @@ void TCPTahoe::adaptive_congestion_response() {
     timeout = rtt * 2;
 }
 
+void TCPTahoe::update_rtt(int base_rtt, int queuing_delay) {
+    // Queuing in the radio buffers adds to the path RTT; the propagation
+    // floor seen by BBR only moves down
+    queue_delay = std::max(queuing_delay, 0);
+    rtt = std::max(base_rtt, 1) + queue_delay;
+    rtt_history.push_back(rtt);
+    if (bbr_min_rtt <= 0.0 || base_rtt < bbr_min_rtt) {
+        bbr_min_rtt = std::max(base_rtt, 1);
+    }
+    timeout = rtt * 2;
+}
+
 double TCPTahoe::calculate_throughput() const {
     if (rtt == 0) return 0.0;
     return (cwnd * 1500.0 * 8.0) / (rtt * 1000.0);  // Mbps (assuming 1500 byte packets)
@@ -300,11 +314,49 @@ std::vector<double> TCPTahoe::get_throughput_history() const { return throughput
 double TCPTahoe::get_current_throughput() const { return calculate_throughput(); }
 double TCPTahoe::get_packet_loss_rate() const { return packet_loss_rate; }
 double TCPTahoe::get_network_utilization() const { return network_utilization; }
+int TCPTahoe::get_current_rtt() const { return rtt; }
+int TCPTahoe::get_algorithm_switch_count() const { return algorithm_switches; }
 
 // Setters
 void TCPTahoe::set_algorithm(CongestionAlgorithm algo) { 
+    if (algo == algorithm) return;
+    handoff_state(algo);
     algorithm = algo;
-    reset();  // Reset state when changing algorithm
+    algorithm_switches++;
+}
+
+void TCPTahoe::handoff_state(CongestionAlgorithm next) {
+    // Only Reno inflates the window in fast recovery; others resume at ssthresh
+    if (current_state == TCPState::FAST_RECOVERY && next != CongestionAlgorithm::RENO) {
+        cwnd = std::max(ssthresh, 1);
+        current_state = TCPState::CONGESTION_AVOIDANCE;
+        in_slow_start = false;
+    }
+    
+    // BBR never sets ssthresh; the window it found becomes the threshold so
+    // a loss-based controller does not slow start past it
+    if (algorithm == CongestionAlgorithm::BBR && next != CongestionAlgorithm::BBR) {
+        ssthresh = std::min(ssthresh, std::max(cwnd, 2));
+    }
+    
+    switch (next) {
+        case CongestionAlgorithm::CUBIC:
+            // New CUBIC epoch from the current window
+            last_cwnd_reduction_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            break;
+        case CongestionAlgorithm::BBR:
+            // Seed the path model from the flow's delivery rate and RTT floor
+            if (calculate_throughput() > 0.0) {
+                bbr_max_bandwidth = calculate_throughput();
+            }
+            for (int sample : rtt_history) {
+                if (sample > 0 && sample < bbr_min_rtt) bbr_min_rtt = sample;
+            }
+            break;
+        default:
+            break;
+    }
 }
 
 void TCPTahoe::reset() {
@@ -0,0 +1,343 @@
+#include "transport_flow_table.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// values[i] = old values[source[i]], or fresh where source[i] < 0
+template<typename T>
+void reorder(std::vector<T>& values, const std::vector<int64_t>& source, T fresh) {
+    std::vector<T> reordered(source.size(), fresh);
+    for (size_t i = 0; i < source.size(); i++) {
+        if (source[i] >= 0) reordered[i] = values[source[i]];
+    }
+    values.swap(reordered);
+}
+
+} // namespace
+
+TransportFlowTable::TransportFlowTable() {
+    config = default_config();
+    seed(0, 0);
+    clear();
+}
+
+TransportFlowConfig TransportFlowTable::default_config() {
+    TransportFlowConfig config;
+    config.base_rtt_ms = 40.0;
+    config.mss_bytes = 1460;
+    config.initial_cwnd = 10.0;
+    config.buffer_bdp_factor = 1.0;
+    config.min_buffer_bytes = 64 * 1024;
+    config.rto_ms = 200.0;
+    config.reset_on_handover = false;
+    return config;
+}
+
+void TransportFlowTable::configure(const TransportFlowConfig& config) {
+    this->config = config;
+    this->config.base_rtt_ms = std::max(config.base_rtt_ms, 1.0);
+    this->config.mss_bytes = std::max(config.mss_bytes, 1);
+    this->config.initial_cwnd = std::max(config.initial_cwnd, 1.0);
+}
+
+TransportFlowConfig TransportFlowTable::get_config() const {
+    return config;
+}
+
+void TransportFlowTable::seed(uint64_t seed, uint64_t stream) {
+    std::seed_seq loss_seed{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                            static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32), 2u};
+    loss_rng.seed(loss_seed);
+}
+
+void TransportFlowTable::clear() {
+    clock_ms = 0.0;
+    flow_index.clear();
+    ue_ids.clear();
+    serving_cell.clear();
+    paused.clear();
+    bottleneck_mbps.clear();
+    sinr_db.clear();
+    cwnd.clear();
+    ssthresh.clear();
+    queue_bytes.clear();
+    rtt_ms.clear();
+    srtt_ms.clear();
+    goodput_mbps.clear();
+    last_reduction_ms.clear();
+    pause_started_ms.clear();
+    bytes_delivered.clear();
+    send_credit.clear();
+    next_sdu.clear();
+    loss_events.clear();
+    timeouts.clear();
+    handovers.clear();
+    total_loss_events = 0;
+    total_timeouts = 0;
+    total_handovers = 0;
+    interruption_times.clear();
+    interruption_sum_ms = 0.0;
+    max_interruption_ms = 0.0;
+    update_totals();
+}
+
+void TransportFlowTable::sync_flows(const LTEStateArrays& state) {
+    // Usual case: the same UEs in the same order
+    bool same = ue_ids.size() == state.ue_ids.size();
+    for (size_t i = 0; same && i < ue_ids.size(); i++) {
+        same = ue_ids[i] == state.ue_ids[i];
+    }
+    if (same) return;
+
+    // Rebuild in the network's order, carrying over flows of UEs still present
+    std::vector<int64_t> source(state.ue_ids.size(), -1);
+    for (size_t i = 0; i < state.ue_ids.size(); i++) {
+        auto it = flow_index.find(state.ue_ids[i]);
+        if (it != flow_index.end()) source[i] = static_cast<int64_t>(it->second);
+    }
+    reorder(serving_cell, source, -1);
+    reorder(paused, source, uint8_t(0));
+    reorder(bottleneck_mbps, source, 0.0);
+    reorder(sinr_db, source, 0.0);
+    reorder(cwnd, source, config.initial_cwnd);
+    reorder(ssthresh, source, 1e9);
+    reorder(queue_bytes, source, 0.0);
+    reorder(rtt_ms, source, config.base_rtt_ms);
+    reorder(srtt_ms, source, config.base_rtt_ms);
+    reorder(goodput_mbps, source, 0.0);
+    reorder(last_reduction_ms, source, -1e9);
+    reorder(pause_started_ms, source, 0.0);
+    reorder(bytes_delivered, source, 0.0);
+    reorder(send_credit, source, 0.0);
+    reorder(next_sdu, source, 0u);
+    reorder(loss_events, source, 0u);
+    reorder(timeouts, source, 0u);
+    reorder(handovers, source, 0u);
+
+    ue_ids = state.ue_ids;
+    flow_index.clear();
+    for (size_t i = 0; i < ue_ids.size(); i++) {
+        flow_index[ue_ids[i]] = i;
+        if (source[i] < 0) serving_cell[i] = state.ue_serving_cell[i];
+    }
+}
+
+void TransportFlowTable::handle_resume(size_t flow, int cell) {
+    // An interruption longer than the RTO looks like a timeout to the sender
+    if (paused[flow]) {
+        double interruption = clock_ms - pause_started_ms[flow];
+        interruption_times.push_back(interruption);
+        interruption_sum_ms += interruption;
+        max_interruption_ms = std::max(max_interruption_ms, interruption);
+        paused[flow] = 0;
+        if (interruption > config.rto_ms) {
+            ssthresh[flow] = std::max(cwnd[flow] / 2.0, 2.0);
+            cwnd[flow] = 1.0;
+            queue_bytes[flow] = 0.0;
+            timeouts[flow]++;
+            total_timeouts++;
+        }
+    }
+
+    if (cell != serving_cell[flow]) {
+        serving_cell[flow] = cell;
+        handovers[flow]++;
+        total_handovers++;
+        if (config.reset_on_handover) {
+            cwnd[flow] = config.initial_cwnd;
+            ssthresh[flow] = 1e9;
+            queue_bytes[flow] = 0.0;
+        }
+    }
+}
+
+void TransportFlowTable::step(const LTEStateArrays& state, double dt_ms, LTENetwork* radio) {
+    sync_flows(state);
+    clock_ms += dt_ms;
+    if (radio && !radio->downlink_buffers_enabled()) radio = nullptr;
+
+    const double mss = config.mss_bytes;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const int detached = static_cast<int>(LTEState::HANDOVER_EXECUTION);
+
+    for (size_t i = 0; i < ue_ids.size(); i++) {
+        bottleneck_mbps[i] = state.ue_throughput[i];
+        sinr_db[i] = state.ue_sinr[i];
+
+        // Detached UEs neither send nor receive until they attach
+        if (state.ue_state[i] == detached) {
+            if (!paused[i]) {
+                paused[i] = 1;
+                pause_started_ms[i] = clock_ms - dt_ms;
+            }
+            goodput_mbps[i] = 0.0;
+            continue;
+        }
+        if (state.ue_state[i] == static_cast<int>(LTEState::IDLE)) {
+            goodput_mbps[i] = 0.0;
+            continue;
+        }
+        if (paused[i] || state.ue_serving_cell[i] != serving_cell[i]) {
+            handle_resume(i, state.ue_serving_cell[i]);
+        }
+
+        double rtt, offered, delivered;
+        bool loss = false;
+        if (radio) {
+            // The UE's RLC buffer is the bottleneck queue: segments wait there
+            // until the scheduler drains them, and a full ring or the PDCP
+            // discard timer drops them
+            int ue = ue_ids[i];
+            rtt = config.base_rtt_ms + radio->get_head_of_line_delay(ue);
+            offered = cwnd[i] * mss / rtt * dt_ms;
+            for (send_credit[i] += offered; send_credit[i] >= mss; send_credit[i] -= mss) {
+                loss = !radio->enqueue_downlink(ue, next_sdu[i]++, config.mss_bytes) || loss;
+            }
+            loss = radio->get_discarded_sdus(ue) > 0 || loss;
+            delivered = static_cast<double>(radio->get_delivered_bytes(ue));
+            queue_bytes[i] = static_cast<double>(radio->get_buffered_bytes(ue));
+        } else {
+            double capacity = bottleneck_mbps[i] * 125.0;  // bytes per ms
+            if (capacity <= 0.0) {
+                goodput_mbps[i] = 0.0;
+                continue;
+            }
+
+            // Fluid model: the window drains through the radio bottleneck, the
+            // excess waits in the RLC queue and adds to the RTT
+            rtt = config.base_rtt_ms + queue_bytes[i] / capacity;
+            offered = cwnd[i] * mss / rtt * dt_ms;
+            double available = queue_bytes[i] + offered;
+            delivered = std::min(available, capacity * dt_ms);
+            double buffer = std::max(config.min_buffer_bytes, config.buffer_bdp_factor * capacity * config.base_rtt_ms);
+            queue_bytes[i] = available - delivered;
+            if (queue_bytes[i] > buffer) {
+                queue_bytes[i] = buffer;
+                loss = true;
+            }
+        }
+
+        if (!loss) {
+            // Residual loss after HARQ, logistic in SINR
+            double p = 0.1 / (1.0 + std::exp(sinr_db[i] + 3.0));
+            double segments = offered / mss;
+            loss = uniform(loss_rng) < 1.0 - std::pow(1.0 - p, segments);
+        }
+
+        // At most one window reduction per RTT
+        if (loss && clock_ms - last_reduction_ms[i] > rtt) {
+            ssthresh[i] = std::max(cwnd[i] / 2.0, 2.0);
+            cwnd[i] = ssthresh[i];
+            last_reduction_ms[i] = clock_ms;
+            loss_events[i]++;
+            total_loss_events++;
+        } else if (cwnd[i] < ssthresh[i]) {
+            cwnd[i] += cwnd[i] * dt_ms / rtt;
+        } else {
+            cwnd[i] += dt_ms / rtt;
+        }
+
+        rtt_ms[i] = rtt;
+        srtt_ms[i] = 0.875 * srtt_ms[i] + 0.125 * rtt;
+        goodput_mbps[i] = delivered / dt_ms / 125.0;
+        bytes_delivered[i] += delivered;
+    }
+    update_totals();
+}
+
+void TransportFlowTable::update_totals() {
+    TransportFlowTotals sums = TransportFlowTotals();
+    double rtt = 0.0, window = 0.0, sinr = 0.0, utilisation = 0.0;
+    size_t loaded = 0;
+    sums.flows = ue_ids.size();
+    for (size_t i = 0; i < sums.flows; i++) {
+        sums.paused_flows += paused[i];
+        sums.goodput_mbps += goodput_mbps[i];
+        sums.bottleneck_mbps += bottleneck_mbps[i];
+        sums.queued_bytes += queue_bytes[i];
+        sums.bytes_delivered += bytes_delivered[i];
+        rtt += srtt_ms[i];
+        window += cwnd[i];
+        sinr += sinr_db[i];
+        if (bottleneck_mbps[i] > 0.0 && !paused[i]) {
+            utilisation += goodput_mbps[i] / bottleneck_mbps[i];
+            loaded++;
+        }
+    }
+    if (sums.flows > 0) {
+        sums.mean_rtt_ms = rtt / sums.flows;
+        sums.mean_cwnd = window / sums.flows;
+        sums.mean_sinr_db = sinr / sums.flows;
+    }
+    sums.mean_utilization = loaded ? utilisation / loaded : 0.0;
+    totals = sums;
+}
+
+void TransportFlowTable::limit_cwnd(const double* limits) {
+    double removed = 0.0;
+    for (size_t i = 0; i < cwnd.size(); i++) {
+        if (limits[i] < cwnd[i]) {
+            double limited = std::max(limits[i], 1.0);
+            removed += cwnd[i] - limited;
+            cwnd[i] = limited;
+        }
+    }
+    if (totals.flows > 0) totals.mean_cwnd -= removed / totals.flows;
+}
+
+size_t TransportFlowTable::size() const {
+    return ue_ids.size();
+}
+
+const std::vector<int32_t>& TransportFlowTable::get_ue_ids() const {
+    return ue_ids;
+}
+
+const std::vector<double>& TransportFlowTable::get_cwnd() const {
+    return cwnd;
+}
+
+const std::vector<double>& TransportFlowTable::get_rtt() const {
+    return srtt_ms;
+}
+
+const std::vector<double>& TransportFlowTable::get_goodput() const {
+    return goodput_mbps;
+}
+
+const std::vector<double>& TransportFlowTable::get_queue_bytes() const {
+    return queue_bytes;
+}
+
+const std::vector<uint8_t>& TransportFlowTable::get_paused() const {
+    return paused;
+}
+
+std::vector<double> TransportFlowTable::get_interruption_times() const {
+    return interruption_times;
+}
+
+const TransportFlowTotals& TransportFlowTable::get_totals() const {
+    return totals;
+}
+
+std::map<std::string, double> TransportFlowTable::get_statistics() const {
+    std::map<std::string, double> stats;
+    size_t interruptions = interruption_times.size();
+    stats["num_flows"] = totals.flows;
+    stats["paused_flows"] = totals.paused_flows;
+    stats["total_goodput_mbps"] = totals.goodput_mbps;
+    stats["mean_goodput_mbps"] = totals.flows ? totals.goodput_mbps / totals.flows : 0.0;
+    stats["mean_rtt_ms"] = totals.mean_rtt_ms;
+    stats["mean_cwnd"] = totals.mean_cwnd;
+    stats["mean_utilization"] = totals.mean_utilization;
+    stats["bytes_delivered"] = totals.bytes_delivered;
+    stats["loss_events"] = total_loss_events;
+    stats["timeouts"] = total_timeouts;
+    stats["handovers"] = total_handovers;
+    stats["mean_interruption_ms"] = interruptions ? interruption_sum_ms / interruptions : 0.0;
+    stats["max_interruption_ms"] = max_interruption_ms;
+    stats["clock_ms"] = clock_ms;
+    return stats;
+}
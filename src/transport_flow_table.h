@@ -0,0 +1,109 @@
+#ifndef TRANSPORT_FLOW_TABLE_H
+#define TRANSPORT_FLOW_TABLE_H
+
+#include "lte_network.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <random>
+#include <unordered_map>
+#include <cstdint>
+
+struct TransportFlowConfig {
+    double base_rtt_ms;             // Core network and server, excluding the radio queue
+    int mss_bytes;
+    double initial_cwnd;            // segments
+    double buffer_bdp_factor;       // Bottleneck buffer in bandwidth-delay products
+    double min_buffer_bytes;
+    double rto_ms;                  // Interruptions longer than this time out the flow
+    bool reset_on_handover;         // true: every handover restarts slow start
+};
+
+// Sums and means over every flow after the last step
+struct TransportFlowTotals {
+    size_t flows;
+    size_t paused_flows;
+    double goodput_mbps;
+    double bottleneck_mbps;
+    double queued_bytes;
+    double bytes_delivered;
+    double mean_rtt_ms;
+    double mean_cwnd;
+    double mean_sinr_db;
+    double mean_utilization;        // Over flows with a rate and not paused
+};
+
+// One Reno-style fluid TCP flow per UE, stored as parallel arrays so a
+// step updates every flow in one pass. Each flow's bottleneck is its UE's
+// scheduled downlink rate; residual loss after HARQ follows its SINR.
+// While the UE is detached for a handover the flow is paused. Without a
+// radio the bottleneck queue is fluid; with one, the UE's RLC buffer is it.
+class TransportFlowTable {
+private:
+    TransportFlowConfig config;
+    double clock_ms;
+    std::mt19937_64 loss_rng;
+
+    std::unordered_map<int, size_t> flow_index;    // ue_id -> flow
+    std::vector<int32_t> ue_ids;
+    std::vector<int32_t> serving_cell;
+    std::vector<uint8_t> paused;
+    std::vector<double> bottleneck_mbps;
+    std::vector<double> sinr_db;
+    std::vector<double> cwnd;                       // segments
+    std::vector<double> ssthresh;
+    std::vector<double> queue_bytes;
+    std::vector<double> rtt_ms;
+    std::vector<double> srtt_ms;
+    std::vector<double> goodput_mbps;
+    std::vector<double> last_reduction_ms;
+    std::vector<double> pause_started_ms;
+    std::vector<double> bytes_delivered;
+    std::vector<double> send_credit;                // bytes not yet sent as a segment
+    std::vector<uint32_t> next_sdu;
+    std::vector<uint32_t> loss_events;
+    std::vector<uint32_t> timeouts;
+    std::vector<uint32_t> handovers;
+
+    // Totals over the table's lifetime, kept across removals
+    uint64_t total_loss_events;
+    uint64_t total_timeouts;
+    uint64_t total_handovers;
+    std::vector<double> interruption_times;
+    double interruption_sum_ms;
+    double max_interruption_ms;
+    TransportFlowTotals totals;
+
+    void update_totals();
+    void sync_flows(const LTEStateArrays& state);
+    void handle_resume(size_t flow, int cell);
+
+public:
+    TransportFlowTable();
+
+    static TransportFlowConfig default_config();
+    void configure(const TransportFlowConfig& config);
+    TransportFlowConfig get_config() const;
+    void seed(uint64_t seed, uint64_t stream);
+    void clear();
+
+    // Adds/removes flows to match the UEs in state, then advances every
+    // flow by dt_ms. With a radio whose downlink buffers are enabled, flows
+    // send segments into them and take delivery and delay from its drain
+    void step(const LTEStateArrays& state, double dt_ms, LTENetwork* radio = nullptr);
+    // Caps each flow's window at limits[flow] (one per flow; NaN: no cap)
+    void limit_cwnd(const double* limits);
+
+    size_t size() const;
+    const std::vector<int32_t>& get_ue_ids() const;
+    const std::vector<double>& get_cwnd() const;
+    const std::vector<double>& get_rtt() const;
+    const std::vector<double>& get_goodput() const;
+    const std::vector<double>& get_queue_bytes() const;
+    const std::vector<uint8_t>& get_paused() const;
+    std::vector<double> get_interruption_times() const;
+    const TransportFlowTotals& get_totals() const;
+    std::map<std::string, double> get_statistics() const;
+};
+
+#endif // TRANSPORT_FLOW_TABLE_H
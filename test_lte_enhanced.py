@@ -0,0 +1,1409 @@
+#!/usr/bin/env python3
+"""
+Smoke tests for the LTE and cross-layer extensions in network_protocols_enhanced.
+"""
+
+import sys
+
+def test_partitioned_kpis():
+    """Partitioned and single-process runs must report the same KPIs."""
+    print("🔍 Testing partitioned simulation KPIs...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 300)
+        
+        config = npe.PartitionConfig()
+        config.regions_x = 2
+        config.regions_y = 2
+        config.area_width = 3000.0
+        config.area_height = 3000.0
+        config.halo_width = 200.0
+        config.ring_capacity = 4096
+        
+        steps = 30
+        partitioned = npe.PartitionedLTESimulation(config)
+        partitioned.set_network(network)
+        if not partitioned.run(steps):
+            print("❌ Partitioned run failed")
+            return False
+        
+        # The partitioned run copied the network, so it can be stepped here
+        single = []
+        for _ in range(steps):
+            network.step_simulation()
+            single.append(network.get_network_throughput())
+        
+        history = partitioned.get_throughput_history()
+        worst = max(abs(a - b) for a, b in zip(history, single))
+        if worst > 1e-6 * max(max(single), 1.0):
+            print(f"❌ Throughput differs by up to {worst:.6f} Mbps")
+            return False
+        
+        stats = partitioned.get_statistics()
+        print(f"✅ Partitioned KPIs match ({stats['migrations']:.0f} migrations, "
+              f"final {history[-1]:.2f} Mbps)")
+        return True
+    except Exception as e:
+        print(f"❌ Partitioned simulation test failed: {e}")
+        return False
+
+def test_pdcch_grant_fairness():
+    """Every connected UE in coverage must get a downlink grant within a few TTIs."""
+    print("🔍 Testing PDCCH grant fairness...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        # 30 UEs per cell against 16 PDCCH grants per cell and TTI
+        network = npe.LTENetwork()
+        network.initialize_network(3, 90)
+        link = npe.LinkAbstraction()
+        
+        last_grant = {}
+        worst_gap = 0
+        for step in range(100):
+            network.step_simulation()
+            for ue in network.get_users():
+                if ue.state != npe.LTEState.CONNECTED:
+                    continue
+                if ue.current_throughput > 0.0:
+                    last_grant[ue.ue_id] = step
+                elif link.select_cqi(network.calculate_sinr(ue.ue_id, ue.serving_cell) - 3.0) > 0:
+                    worst_gap = max(worst_gap, step - last_grant.get(ue.ue_id, -1))
+        
+        if worst_gap > 20:
+            print(f"❌ A UE in coverage went {worst_gap} TTIs without a grant")
+            return False
+        
+        print(f"✅ Every UE in coverage scheduled within {worst_gap} TTIs")
+        return True
+    except Exception as e:
+        print(f"❌ PDCCH grant fairness test failed: {e}")
+        return False
+
+def test_handover_signaling_timeline():
+    """A signaled handover detaches, reattaches on the target and closes its history entry."""
+    print("🔍 Testing handover signaling timeline...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 50)
+        for _ in range(3):
+            network.step_simulation()
+        
+        config = npe.HandoverSignalingConfig()
+        config.enabled = True
+        network.configure_handover_signaling(config)
+        
+        # Move one UE next to a distant cell
+        ue = network.get_users()[0]
+        target = (ue.serving_cell + 4) % 9
+        cell = network.get_cell_info(target)
+        network.update_user_position(ue.ue_id, cell.longitude + 10.0, cell.latitude + 10.0)
+        
+        detached = False
+        attach_step = None
+        for step in range(200):
+            network.step_simulation()
+            state = network.get_user_info(ue.ue_id).state
+            if state == npe.LTEState.HANDOVER_EXECUTION:
+                detached = True
+            elif detached and state == npe.LTEState.CONNECTED:
+                attach_step = step
+                break
+        
+        if not detached or attach_step is None:
+            print(f"❌ Handover never completed (detached={detached})")
+            return False
+        
+        for _ in range(2):
+            network.step_simulation()
+        user = network.get_user_info(ue.ue_id)
+        if user.serving_cell != target or user.current_throughput <= 0.0:
+            print(f"❌ After attach: cell {user.serving_cell}, {user.current_throughput:.2f} Mbps")
+            return False
+        
+        # The entry closes once the source releases the UE context
+        for _ in range(100):
+            if network.get_handover_signaling_statistics()["pending"] == 0:
+                break
+            network.step_simulation()
+        
+        interruptions = network.get_handover_interruption_times()
+        if not interruptions or min(interruptions) <= 0.0:
+            print(f"❌ Interruption times: {interruptions}")
+            return False
+        
+        events = [event for event in network.get_handover_history() if event.ue_id == ue.ue_id]
+        if not events or not events[-1].success or events[-1].completion_time <= events[-1].start_time:
+            print("❌ Handover history entry not closed")
+            return False
+        
+        print(f"✅ Reattached after step {attach_step}, interruption {interruptions[0]:.1f} ms, "
+              f"{user.current_throughput:.2f} Mbps on cell {target}")
+        return True
+    except Exception as e:
+        print(f"❌ Handover signaling test failed: {e}")
+        return False
+
+def test_handover_history_snapshot():
+    """Handovers that close out of order are closed in the published history too."""
+    print("🔍 Testing handover history snapshot...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 200)
+        for _ in range(3):
+            network.step_simulation()
+        
+        config = npe.HandoverSignalingConfig()
+        config.enabled = True
+        network.configure_handover_signaling(config)
+        
+        # One UE per step moves next to another cell, so procedures overlap
+        cells = network.get_cells()
+        users = network.get_users()
+        for step in range(300):
+            if step < 40:
+                ue = users[step * 5 % len(users)]
+                cell = cells[(ue.serving_cell + 1 + step % 8) % 9]
+                network.update_user_position(ue.ue_id, cell.longitude + 20.0, cell.latitude + 20.0)
+            network.step_simulation()
+            if step >= 40 and network.get_handover_signaling_statistics()["pending"] == 0:
+                break
+        network.step_simulation()
+        
+        history = network.get_handover_history()
+        still_open = sum(1 for event in history if event.completion_time == 0)
+        if still_open:
+            print(f"❌ {still_open} of {len(history)} published entries are still open")
+            return False
+        
+        print(f"✅ All {len(history)} published handover entries closed")
+        return True
+    except Exception as e:
+        print(f"❌ Handover history snapshot test failed: {e}")
+        return False
+
+def test_rlc_buffer_delay():
+    """RLC buffers drain at the scheduled rate, report the head's wait and discard stale SDUs."""
+    print("🔍 Testing RLC buffer draining and delay...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(7, 100)
+        for _ in range(3):
+            network.step_simulation()
+        ue = max(network.get_users(), key=lambda user: user.current_throughput)
+        
+        # About 40 ms of traffic at the UE's rate, enqueued at once
+        network.configure_downlink_buffers(10, 4096, 0.0, 1.0)
+        sdus = min(4096, int(ue.current_throughput * 125.0 * 40.0 / 1500) + 1)
+        for sdu in range(sdus):
+            network.enqueue_downlink(ue.ue_id, sdu, 1500)
+        delivered = 0
+        for _ in range(20):
+            network.step_simulation()
+            delivered += network.get_delivered_bytes(ue.ue_id)
+        backlog = network.get_buffered_bytes(ue.ue_id)
+        if delivered <= 0 or delivered + backlog != sdus * 1500:
+            print(f"❌ Delivered {delivered} + buffered {backlog} of {sdus * 1500} bytes")
+            return False
+        if backlog > 0 and network.get_queuing_delay(ue.ue_id) < 5.0:
+            print(f"❌ Backlogged queue reports {network.get_queuing_delay(ue.ue_id):.2f} ms")
+            return False
+        
+        # Far more than the UE can send before a 10 ms discard timer expires
+        network.configure_downlink_buffers(10, 64, 10.0, 1.0)
+        for sdu in range(64):
+            network.enqueue_downlink(ue.ue_id, sdu, 60000)
+        if network.enqueue_downlink(ue.ue_id, 64, 60000):
+            print("❌ Full ring accepted another SDU")
+            return False
+        delivered = discarded = 0
+        for _ in range(20):
+            network.step_simulation()
+            delivered += network.get_delivered_bytes(ue.ue_id)
+            discarded += network.get_discarded_sdus(ue.ue_id)
+        backlog = network.get_buffered_bytes(ue.ue_id)
+        if discarded == 0 or delivered + backlog + discarded * 60000 != 64 * 60000:
+            print(f"❌ Delivered {delivered}, buffered {backlog}, discarded {discarded} SDUs")
+            return False
+        
+        print(f"✅ {sdus} SDUs drained at the scheduled rate, {discarded} stale SDUs discarded")
+        return True
+    except Exception as e:
+        print(f"❌ RLC buffer test failed: {e}")
+        return False
+
+def test_cosimulation_flows():
+    """One flow per UE follows its scheduled rate and pauses across handovers."""
+    print("🔍 Testing per-UE co-simulation...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 200)
+        config = npe.HandoverSignalingConfig()
+        config.enabled = True
+        network.configure_handover_signaling(config)
+        
+        optimizer = npe.CrossLayerOptimizer()
+        optimizer.set_simulation_seed(7)
+        optimizer.enable_adaptive_optimization(False)
+        optimizer.register_layer(npe.LayerType.PHYSICAL, network)
+        if not optimizer.enable_cosimulation(npe.TransportFlowConfig()):
+            print("❌ Co-simulation needs the registered network")
+            return False
+        for _ in range(50):
+            optimizer.step_cosimulation()
+        
+        # Ten UEs move next to a distant cell
+        cells = network.get_cells()
+        users = network.get_users()
+        for k in range(10):
+            ue = users[k * 7]
+            cell = cells[(ue.serving_cell + 4) % 9]
+            network.update_user_position(ue.ue_id, cell.longitude + 10.0, cell.latitude + 10.0)
+        for _ in range(150):
+            optimizer.step_cosimulation()
+        
+        table = optimizer.get_flow_table()
+        totals = table.get_totals()
+        stats = table.get_statistics()
+        goodput = sum(table.get_goodput())
+        if table.size() != len(users) or totals.flows != len(users) or goodput <= 0.0:
+            print(f"❌ {table.size()} flows for {len(users)} UEs, {goodput:.2f} Mbps")
+            return False
+        if abs(totals.goodput_mbps - goodput) > 1e-6 * goodput or \
+           abs(stats["mean_rtt_ms"] - sum(table.get_rtt()) / table.size()) > 1e-6:
+            print("❌ Running totals disagree with the flows")
+            return False
+        
+        interruptions = table.get_interruption_times()
+        if stats["handovers"] < 1 or not interruptions or \
+           stats["max_interruption_ms"] != max(interruptions) or \
+           abs(stats["mean_interruption_ms"] - sum(interruptions) / len(interruptions)) > 1e-9:
+            print(f"❌ {stats['handovers']:.0f} handovers, interruptions {interruptions}")
+            return False
+        
+        print(f"✅ {table.size()} flows, {goodput:.1f} Mbps, {len(interruptions)} paused across handovers")
+        return True
+    except Exception as e:
+        print(f"❌ Co-simulation test failed: {e}")
+        return False
+
+def test_policy_engine():
+    """Rules compile, evaluate per row, and a bad policy leaves the old one active."""
+    print("🔍 Testing policy parsing and evaluation...")
+    
+    try:
+        import numpy as np
+        import network_protocols_enhanced as npe
+        
+        engine = npe.PolicyEngine()
+        policy = ("default max_cwnd = 100\n"
+                  "rule weak: sinr_db < 0 -> max_cwnd = 8\n"
+                  "rule queued: queue_bytes > 50000 and sinr_db >= 0 -> max_cwnd = 30\n")
+        if not engine.load_string(policy):
+            print(f"❌ Policy rejected: {engine.get_last_error()}")
+            return False
+        if engine.get_rule_names() != ["weak", "queued"] or engine.get_action_names() != ["max_cwnd"]:
+            print(f"❌ Parsed {engine.get_rule_names()} / {engine.get_action_names()}")
+            return False
+        
+        result = engine.evaluate({
+            "sinr_db": np.array([-5.0, 10.0, 10.0]),
+            "queue_bytes": np.array([0.0, 80000.0, 10.0]),
+        })
+        if list(result["max_cwnd"]) != [8.0, 30.0, 100.0] or list(result["rule"]) != [0, 1, -1]:
+            print(f"❌ Evaluated {list(result['max_cwnd'])}, rules {list(result['rule'])}")
+            return False
+        
+        if engine.load_string("rule broken: sinr_db <"):
+            print("❌ Malformed policy accepted")
+            return False
+        if not engine.get_last_error().startswith("line 1") or engine.get_rule_count() != 2:
+            print(f"❌ Bad policy handling: '{engine.get_last_error()}', {engine.get_rule_count()} rules")
+            return False
+        
+        print("✅ Policy parsed and evaluated per row")
+        return True
+    except Exception as e:
+        print(f"❌ Policy engine test failed: {e}")
+        return False
+
+def test_reported_cell_load():
+    """A reported load weights interference until it is withdrawn."""
+    print("🔍 Testing reported cell load...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 300)
+        for _ in range(5):
+            network.step_simulation()
+        before = 0.0
+        for _ in range(10):
+            network.step_simulation()
+            before += network.get_network_throughput()
+        ue = network.get_users()[0]
+        sinr_full = network.calculate_sinr(ue.ue_id, ue.serving_cell)
+        
+        for cell in range(9):
+            network.update_cell_load(cell, 20)
+        after = 0.0
+        for _ in range(10):
+            network.step_simulation()
+            after += network.get_network_throughput()
+            for cell in range(9):
+                if abs(network.get_cell_activity(cell) - 0.2) > 1e-12:
+                    print(f"❌ Cell {cell} activity {network.get_cell_activity(cell):.3f} after a 20% report")
+                    return False
+        ue = network.get_users()[0]
+        sinr_light = network.calculate_sinr(ue.ue_id, ue.serving_cell)
+        if after <= before or sinr_light <= sinr_full:
+            print(f"❌ Light load: {before:.1f} -> {after:.1f} Mbps, SINR {sinr_full:.2f} -> {sinr_light:.2f} dB")
+            return False
+        
+        for cell in range(9):
+            network.update_cell_load(cell, -1)
+        network.step_simulation()
+        if network.get_cell_activity(4) <= 0.2:
+            print("❌ Withdrawn report still sets the activity")
+            return False
+        
+        print(f"✅ 20% reported load held, SINR {sinr_full:.2f} -> {sinr_light:.2f} dB")
+        return True
+    except Exception as e:
+        print(f"❌ Reported cell load test failed: {e}")
+        return False
+
+def test_state_views():
+    """Views share the network's arrays and follow each step; snapshots stay frozen."""
+    print("🔍 Testing zero-copy state views...")
+    
+    try:
+        import numpy as np
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 300)
+        for _ in range(3):
+            network.step_simulation()
+        
+        view = network.get_state_view()
+        snapshot = network.get_state_snapshot()
+        users = network.get_users()
+        if view["positions"].shape != (300, 2) or list(view["ue_ids"]) != [user.ue_id for user in users]:
+            print(f"❌ View shape {view['positions'].shape} or UE order does not match the network")
+            return False
+        try:
+            view["throughput"][0] = 1.0
+            print("❌ View is writeable")
+            return False
+        except ValueError:
+            pass
+        
+        frozen = snapshot["throughput"].copy()
+        for _ in range(5):
+            network.step_simulation()
+        users = network.get_users()
+        if list(view["throughput"]) != [user.current_throughput for user in users]:
+            print("❌ View did not follow the steps")
+            return False
+        if not np.array_equal(snapshot["throughput"], frozen):
+            print("❌ Snapshot changed with the network")
+            return False
+        if not np.isfinite(view["sinr"]).all():
+            print("❌ Non-finite SINR in the view")
+            return False
+        
+        # A UE moved between steps is measured at its new position
+        before = view["sinr"][3]
+        network.update_user_position(users[3].ue_id, 1500.0, 1500.0)
+        network.refresh_state_arrays()
+        if list(view["positions"][3]) != [1500.0, 1500.0] or view["sinr"][3] == before:
+            print(f"❌ Moved UE shows {list(view['positions'][3])}, SINR {view['sinr'][3]:.2f} dB")
+            return False
+        
+        print(f"✅ Views live over {len(users)} UEs, snapshot frozen")
+        return True
+    except Exception as e:
+        print(f"❌ State view test failed: {e}")
+        return False
+
+def test_link_abstraction_tables():
+    """CQI thresholds sit at 10% BLER and EESM reduces flat channels to their SINR."""
+    print("🔍 Testing EESM and BLER tables...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        link = npe.LinkAbstraction()
+        table = link.get_cqi_table()
+        if len(table) != 15:
+            print(f"❌ Expected 15 CQI entries, got {len(table)}")
+            return False
+        
+        for previous, entry in zip(table, table[1:]):
+            if entry.sinr_threshold_db <= previous.sinr_threshold_db or \
+               entry.spectral_efficiency <= previous.spectral_efficiency:
+                print(f"❌ CQI table not monotonic at CQI {entry.cqi}")
+                return False
+        
+        for entry in table:
+            bler = link.lookup_bler(entry.sinr_threshold_db, entry.cqi)
+            if abs(bler - 0.1) > 0.02:
+                print(f"❌ CQI {entry.cqi} BLER at threshold is {bler:.3f}")
+                return False
+            if not (link.lookup_bler(entry.sinr_threshold_db + 3.0, entry.cqi) < bler <
+                    link.lookup_bler(entry.sinr_threshold_db - 3.0, entry.cqi)):
+                print(f"❌ CQI {entry.cqi} BLER does not fall with SINR")
+                return False
+            if link.select_cqi(entry.sinr_threshold_db + 0.01) != entry.cqi:
+                print(f"❌ select_cqi disagrees with the CQI {entry.cqi} threshold")
+                return False
+        
+        flat = link.effective_sinr_eesm([12.0] * 10, 9)
+        if abs(flat - 12.0) > 1e-9:
+            print(f"❌ EESM of a flat channel is {flat:.3f} dB")
+            return False
+        
+        # A faded allocation counts for less than its mean linear SINR
+        faded = link.effective_sinr_eesm([0.0, 20.0], 9)
+        if not (0.0 < faded < 17.0):
+            print(f"❌ EESM of [0, 20] dB is {faded:.2f} dB")
+            return False
+        
+        print(f"✅ CQI/BLER tables consistent, EESM of [0, 20] dB = {faded:.2f} dB")
+        return True
+    except Exception as e:
+        print(f"❌ Link abstraction test failed: {e}")
+        return False
+
+def test_message_bus_drain():
+    """The bus accepts up to its capacity and drains exactly what it accepted."""
+    print("🔍 Testing cross-layer message bus...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        optimizer = npe.CrossLayerOptimizer()
+        optimizer.enable_adaptive_optimization(False)
+        optimizer.set_message_bus_capacity(128)
+        
+        message = npe.CrossLayerMessage()
+        message.source = npe.LayerType.PHYSICAL
+        message.destination = npe.LayerType.TRANSPORT
+        message.event = npe.CrossLayerEvent.CONGESTION_DETECTED
+        message.message = "bus"
+        
+        accepted = 0
+        for i in range(200):
+            message.timestamp = i
+            if optimizer.post_message(message):
+                accepted += 1
+        
+        first = optimizer.drain_message_bus(50)
+        rest = optimizer.drain_message_bus()
+        stats = optimizer.get_message_bus_statistics()
+        
+        if accepted != 128 or first != 50 or first + rest != accepted:
+            print(f"❌ Accepted {accepted}, drained {first} + {rest}")
+            return False
+        if stats["published"] != 128 or stats["rejected"] != 72 or stats["pending"] != 0:
+            print(f"❌ Unexpected bus statistics: {stats}")
+            return False
+        
+        print(f"✅ Bus drained {first + rest} of {accepted} accepted messages")
+        return True
+    except Exception as e:
+        print(f"❌ Message bus test failed: {e}")
+        return False
+
+def test_importer_carrier_mapping():
+    """Imported cells serve only on their own carrier."""
+    print("🔍 Testing cell import carrier mapping...")
+    
+    try:
+        import random
+        import network_protocols_enhanced as npe
+        
+        # 3x3 sites of three sectors, sector k on carrier k
+        frequencies = [("800", "10"), ("1800", "20"), ("2600", "20")]
+        rows = ["id,lat,lon,azimuth,frequency,bandwidth"]
+        for i in range(3):
+            for j in range(3):
+                for k, (frequency, bandwidth) in enumerate(frequencies):
+                    rows.append(f"c{len(rows)},{50.0 + i * 0.009:.6f},{8.0 + j * 0.014:.6f},"
+                                f"{k * 120},{frequency},{bandwidth}")
+        result = npe.CellSiteImporter().parse_csv("\n".join(rows) + "\n")
+        if not result.ok or len(result.cells) != 27 or len(result.carriers) != 3:
+            print(f"❌ Import failed: {result.error}")
+            return False
+        
+        network = npe.LTENetwork()
+        network.initialize_network(1, 300)
+        network.import_cells(result)
+        if network.get_cell_carriers() != list(result.cell_carrier):
+            print("❌ Network did not take the per-cell carriers")
+            return False
+        
+        rng = random.Random(1)
+        for user in network.get_users():
+            network.update_user_position(user.ue_id, rng.uniform(-1000.0, 1000.0), rng.uniform(-1000.0, 1000.0))
+        for _ in range(30):
+            network.step_simulation()
+        
+        scheduled = 0
+        for user in network.get_users():
+            own = result.cell_carrier[user.serving_cell]
+            for carrier, rate in enumerate(network.get_user_carrier_throughput(user.ue_id)):
+                if rate <= 0.0:
+                    continue
+                if carrier != own:
+                    print(f"❌ UE {user.ue_id} scheduled on carrier {carrier}, its cell uses {own}")
+                    return False
+                scheduled += 1
+        if scheduled == 0:
+            print("❌ No UE was scheduled")
+            return False
+        
+        print(f"✅ {scheduled} carrier allocations, all on the serving cell's carrier")
+        return True
+    except Exception as e:
+        print(f"❌ Importer carrier mapping test failed: {e}")
+        return False
+
+def test_sector_antenna_pattern():
+    """The gain table tracks the closed form and each sector serves its own bearing."""
+    print("🔍 Testing sector antenna patterns...")
+    
+    try:
+        import math
+        import network_protocols_enhanced as npe
+        
+        pattern = npe.AntennaPattern()
+        worst_angle = max(abs(npe.AntennaPattern.fast_atan2_deg(math.sin(a), math.cos(a)) - math.degrees(a))
+                          for a in (i * 0.01 - math.pi for i in range(628)))
+        worst_gain = max(abs(pattern.lookup_gain(az + 0.37, el + 0.21) - pattern.pattern_gain(az + 0.37, el + 0.21))
+                         for az in range(-180, 180, 7) for el in range(-60, 60, 3))
+        if worst_angle > 0.02 or worst_gain > 0.5:
+            print(f"❌ atan2 error {worst_angle:.4f} deg, table error {worst_gain:.3f} dB")
+            return False
+        
+        boresight = pattern.gain_towards(0.0, 500.0, 30.0, 0.0, 6.0)
+        side = pattern.gain_towards(500.0, 0.0, 30.0, 0.0, 6.0)
+        back = pattern.gain_towards(0.0, -500.0, 30.0, 0.0, 6.0)
+        if not (boresight > side > back):
+            print(f"❌ Gains boresight {boresight:.2f}, side {side:.2f}, back {back:.2f} dBi")
+            return False
+        
+        network = npe.LTENetwork()
+        network.initialize_network(1, 0)
+        sectors = network.add_sector_site(3000.0, 3000.0, 3, 6.0, 30.0)
+        for index, cell_id in enumerate(sectors):
+            azimuth = math.radians(network.get_cell_info(cell_id).azimuth)
+            user = npe.UserEquipment()
+            user.ue_id = index
+            user.x_position = 3000.0 + 500.0 * math.sin(azimuth)
+            user.y_position = 3000.0 + 500.0 * math.cos(azimuth)
+            network.add_user(user)
+            best = max(sectors, key=lambda cell: network.calculate_rsrp(index, cell))
+            if best != cell_id:
+                print(f"❌ UE on sector {cell_id}'s boresight hears sector {best} best")
+                return False
+        
+        print(f"✅ Table within {worst_gain:.2f} dB, front-to-back {boresight - back:.1f} dB")
+        return True
+    except Exception as e:
+        print(f"❌ Antenna pattern test failed: {e}")
+        return False
+
+def test_rach_contention():
+    """Collisions grow with the device count and access barring relieves an overload."""
+    print("🔍 Testing RACH contention engine...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 10)
+        
+        def run(devices, barring_factor):
+            config = npe.RACHConfig()
+            config.acb_barring_factor = barring_factor
+            simulator = npe.RACHSimulator(config)
+            simulator.attach_devices(network, devices, 3000.0, 3000.0)
+            simulator.run()
+            return simulator
+        
+        light = run(1000, 1.0)
+        heavy = run(100000, 1.0)
+        barred = run(100000, 0.5)
+        light_stats = light.get_statistics()
+        heavy_stats = heavy.get_statistics()
+        barred_stats = barred.get_statistics()
+        
+        if light_stats["success_probability"] != 1.0 or light_stats["collision_probability"] > 0.01:
+            print(f"❌ Light load: {light_stats['success_probability']:.3f} success, "
+                  f"{light_stats['collision_probability']:.3f} collisions")
+            return False
+        if heavy_stats["collision_probability"] <= 0.1 or heavy_stats["success_probability"] >= 1.0:
+            print(f"❌ Overload: {heavy_stats['success_probability']:.3f} success, "
+                  f"{heavy_stats['collision_probability']:.3f} collisions")
+            return False
+        if barred_stats["success_probability"] <= heavy_stats["success_probability"]:
+            print(f"❌ Barring did not help: {barred_stats['success_probability']:.3f} vs "
+                  f"{heavy_stats['success_probability']:.3f}")
+            return False
+        
+        # Per-device results add up to the aggregate statistics
+        counts = heavy.get_device_state_counts()
+        connected = sum(heavy.get_access_delay_histogram(10, 2000))
+        if sum(counts.values()) != 100000 or connected != counts["connected"] or \
+           connected != heavy_stats["connected_devices"]:
+            print(f"❌ States {counts}, {connected} delays")
+            return False
+        for attempts, successes, collisions in zip(heavy.get_opportunity_attempts(),
+                                                   heavy.get_opportunity_successes(),
+                                                   heavy.get_opportunity_collisions()):
+            if successes + collisions > attempts:
+                print(f"❌ Opportunity with {attempts} attempts, {successes} successes, {collisions} collisions")
+                return False
+        
+        print(f"✅ Collisions {light_stats['collision_probability']:.3f} -> {heavy_stats['collision_probability']:.3f}, "
+              f"barring lifts success {heavy_stats['success_probability']:.2f} -> {barred_stats['success_probability']:.2f}")
+        return True
+    except Exception as e:
+        print(f"❌ RACH contention test failed: {e}")
+        return False
+
+def test_coverage_map():
+    """Rasters match the per-point channel model and unchanged tiles come from the cache."""
+    print("🔍 Testing coverage map generator...")
+    
+    try:
+        import numpy as np
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 1)
+        config = npe.CoverageMapConfig()
+        config.width = 256
+        config.height = 256
+        config.tile_size = 64
+        
+        generator = npe.CoverageMapGenerator()
+        first = generator.generate(network, config)
+        if first["rsrp"].shape != (256, 256) or first["tiles_computed"] != 16:
+            print(f"❌ Raster {first['rsrp'].shape}, {first['tiles_computed']} tiles computed")
+            return False
+        
+        # Sample pixel centres against a UE placed there
+        ue_id = network.get_users()[0].ue_id
+        cell_ids = [cell.cell_id for cell in network.get_cells()]
+        pixel_width = (config.x_max - config.x_min) / config.width
+        pixel_height = (config.y_max - config.y_min) / config.height
+        for row, col in [(0, 0), (17, 200), (128, 128), (201, 33), (255, 255)]:
+            network.update_user_position(ue_id, config.x_min + (col + 0.5) * pixel_width,
+                                         config.y_min + (row + 0.5) * pixel_height)
+            rsrp = {cell: network.calculate_rsrp(ue_id, cell) for cell in cell_ids}
+            best = max(rsrp, key=rsrp.get)
+            if first["best_server"][row, col] != best or abs(first["rsrp"][row, col] - rsrp[best]) > 1e-3:
+                print(f"❌ Pixel ({row}, {col}): cell {first['best_server'][row, col]} at "
+                      f"{first['rsrp'][row, col]:.2f} dBm, expected {best} at {rsrp[best]:.2f} dBm")
+                return False
+        
+        second = generator.generate(network, config)
+        if second["tiles_computed"] != 0 or second["tiles_cached"] != 16 or \
+           not np.array_equal(second["sinr"], first["sinr"]):
+            print(f"❌ Repeat map computed {second['tiles_computed']} tiles")
+            return False
+        
+        # A new site between the cells changes the network signature
+        sectors = network.add_sector_site(500.0, 500.0, 3, 6.0, 30.0)
+        third = generator.generate(network, config)
+        if third["tiles_computed"] != 16 or not np.isin(sectors, third["best_server"]).any():
+            print(f"❌ After adding a site: {third['tiles_computed']} tiles computed")
+            return False
+        
+        print(f"✅ Raster matches the channel model, {second['tiles_cached']} tiles served from cache")
+        return True
+    except Exception as e:
+        print(f"❌ Coverage map test failed: {e}")
+        return False
+
+def test_realtime_runner():
+    """The runner keeps wall-clock pace, publishes snapshots and degrades under overload."""
+    print("🔍 Testing real-time paced runner...")
+    
+    try:
+        import time
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 200)
+        runner = npe.RealtimeRunner(network, 10.0)
+        runner.start()
+        started = time.monotonic()
+        
+        last_step = 0
+        for _ in range(25):
+            time.sleep(0.02)
+            snapshot = runner.get_latest_snapshot()
+            if snapshot.step == 0:
+                continue        # Nothing published yet
+            if snapshot.step < last_step or len(snapshot.ue_ids) != 200 or \
+               abs(snapshot.sim_time_s - snapshot.step * 0.01) > 1e-9:
+                print(f"❌ Snapshot step {snapshot.step} after {last_step}, {len(snapshot.ue_ids)} UEs")
+                return False
+            last_step = snapshot.step
+            # Readers may use the network's own snapshot getters meanwhile
+            if len(network.get_users()) != 200:
+                print("❌ Network snapshot lost users while running")
+                return False
+        runner.stop()
+        if last_step == 0:
+            print("❌ No snapshot was published")
+            return False
+        elapsed_steps = (time.monotonic() - started) / 0.01
+        
+        stats = runner.get_statistics()
+        if runner.is_running() or not (0.5 * elapsed_steps <= stats["steps"] <= elapsed_steps + 2):
+            print(f"❌ {stats['steps']:.0f} steps in {elapsed_steps:.0f} periods")
+            return False
+        time.sleep(0.05)
+        if runner.get_statistics()["steps"] != stats["steps"]:
+            print("❌ Runner kept stepping after stop")
+            return False
+        
+        # A period no step can meet forces misses and degradation
+        busy = npe.LTENetwork()
+        busy.initialize_network(9, 5000)
+        overloaded = npe.RealtimeRunner(busy, 0.1)
+        overloaded.start()
+        time.sleep(0.3)
+        overloaded.stop()
+        busy_stats = overloaded.get_statistics()
+        if busy_stats["deadline_misses"] == 0 or busy_stats["degraded_steps"] == 0:
+            print(f"❌ Overload: {busy_stats['deadline_misses']:.0f} misses, "
+                  f"{busy_stats['degraded_steps']:.0f} degraded steps")
+            return False
+        
+        print(f"✅ {stats['steps']:.0f} paced steps, overload degraded "
+              f"{busy_stats['degraded_steps']:.0f} of {busy_stats['steps']:.0f} steps")
+        return True
+    except Exception as e:
+        print(f"❌ Real-time runner test failed: {e}")
+        return False
+
+def test_network_snapshots():
+    """Each publish is a new epoch and readers see whole snapshots while a runner steps."""
+    print("🔍 Testing epoch-based network snapshots...")
+    
+    try:
+        import time
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 100)
+        network.step_simulation()
+        held = network.get_snapshot()
+        for _ in range(3):
+            network.step_simulation()
+        latest = network.get_snapshot()
+        if latest.epoch != held.epoch + 3 or latest.step != held.step + 3 or len(latest.users) != 100:
+            print(f"❌ Epoch {held.epoch} -> {latest.epoch}, step {held.step} -> {latest.step}")
+            return False
+        
+        network.set_snapshot_interval(4)
+        for _ in range(8):
+            network.step_simulation()
+        spaced = network.get_snapshot()
+        if spaced.epoch != latest.epoch + 2 or spaced.step % 4 != 0:
+            print(f"❌ Interval 4 published {spaced.epoch - latest.epoch} epochs, last at step {spaced.step}")
+            return False
+        
+        # With stepping silent, mutators still publish
+        network.set_snapshot_interval(0)
+        network.step_simulation()
+        user = network.get_users()[0]
+        user.ue_id = 1000
+        network.add_user(user)
+        if len(network.get_users()) != 101 or network.get_snapshot().step != spaced.step + 1:
+            print("❌ add_user was not published")
+            return False
+        
+        # Readers never see a torn snapshot while the runner steps
+        network.set_snapshot_interval(1)
+        runner = npe.RealtimeRunner(network, 2.0)
+        runner.start()
+        last = network.get_snapshot()
+        reads = 0
+        for _ in range(100):
+            snapshot = network.get_snapshot()
+            cell_ids = {cell.cell_id for cell in snapshot.cells}
+            if snapshot.epoch < last.epoch or snapshot.step < last.step or len(snapshot.users) != 101 or \
+               any(user.serving_cell not in cell_ids for user in snapshot.users):
+                runner.stop()
+                print(f"❌ Inconsistent snapshot at epoch {snapshot.epoch}")
+                return False
+            last = snapshot
+            reads += 1
+            time.sleep(0.002)
+        runner.stop()
+        if last.step <= spaced.step + 1:
+            print("❌ Snapshots did not advance while the runner stepped")
+            return False
+        
+        print(f"✅ {reads} consistent reads up to epoch {last.epoch}")
+        return True
+    except Exception as e:
+        print(f"❌ Network snapshot test failed: {e}")
+        return False
+
+def test_uplink_power_control():
+    """Uplink grants respect the power cap and TPC limits, and interference only comes from other cells."""
+    print("🔍 Testing uplink power control and interference...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 300)
+        network.enable_uplink(True)
+        for _ in range(100):
+            network.step_simulation()
+        
+        config = network.get_uplink_power_control()
+        stats = network.get_uplink_statistics()
+        users = network.get_users()
+        total = sum(network.get_uplink_throughput(user.ue_id) for user in users)
+        if not (0 < stats["scheduled_users"] <= config.max_users_per_tti * 9) or \
+           abs(total - stats["uplink_throughput"]) > 1e-6 * max(total, 1.0) or stats["mean_iot_db"] <= 0.0:
+            print(f"❌ {stats['scheduled_users']:.0f} scheduled, {total:.2f} vs "
+                  f"{stats['uplink_throughput']:.2f} Mbps, IoT {stats['mean_iot_db']:.2f} dB")
+            return False
+        offsets = [network.get_tpc_offset(user.ue_id) for user in users]
+        if any(abs(offset) > config.tpc_max_db for offset in offsets) or not any(offsets):
+            print(f"❌ TPC offsets out of range or never used: {min(offsets)}..{max(offsets)} dB")
+            return False
+        
+        # A low power cap binds for part of the grants
+        config.p_max_dbm = 0.0
+        config.target_sinr_db = 30.0
+        network.set_uplink_power_control(config)
+        for _ in range(20):
+            network.step_simulation()
+        capped = network.get_uplink_statistics()
+        if any(network.get_uplink_tx_power(user.ue_id) > 0.0 for user in users) or \
+           capped["power_limited_fraction"] <= 0.0:
+            print(f"❌ Power cap ignored, {capped['power_limited_fraction']:.2f} power limited")
+            return False
+        
+        # Open loop never accumulates TPC corrections
+        open_loop = npe.LTENetwork()
+        open_loop.initialize_network(9, 300)
+        open_loop.enable_uplink(True)
+        open_config = open_loop.get_uplink_power_control()
+        open_config.closed_loop = False
+        open_loop.set_uplink_power_control(open_config)
+        for _ in range(20):
+            open_loop.step_simulation()
+        if any(open_loop.get_tpc_offset(user.ue_id) != 0.0 for user in open_loop.get_users()):
+            print("❌ Open loop applied TPC corrections")
+            return False
+        
+        # A lone cell has no neighbours to interfere
+        single = npe.LTENetwork()
+        single.initialize_network(1, 50)
+        single.enable_uplink(True)
+        for _ in range(5):
+            single.step_simulation()
+        if max(single.get_uplink_interference(single.get_cells()[0].cell_id)) != 0.0:
+            print("❌ Single cell sees uplink interference")
+            return False
+        
+        print(f"✅ {stats['scheduled_users']:.0f} grants, IoT {stats['mean_iot_db']:.1f} dB, "
+              f"{capped['power_limited_fraction']:.0%} power limited at 0 dBm")
+        return True
+    except Exception as e:
+        print(f"❌ Uplink power control test failed: {e}")
+        return False
+
+def test_nr_numerology():
+    """NR mode sizes bandwidth parts from the PRB tables and serves each UE on its active part."""
+    print("🔍 Testing NR numerology and bandwidth parts...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        # TS 38.101-1/-2 maximum transmission bandwidth
+        for bandwidth, numerology, prbs in [(100, 1, 273), (20, 0, 106), (400, 3, 264)]:
+            if npe.LTENetwork.nr_prbs_for_bandwidth(bandwidth, numerology) != prbs:
+                print(f"❌ {bandwidth} MHz at mu={numerology} gives "
+                      f"{npe.LTENetwork.nr_prbs_for_bandwidth(bandwidth, numerology)} PRBs")
+                return False
+        
+        network = npe.LTENetwork()
+        network.initialize_network(9, 200)
+        network.configure_nr(1, 3500.0, 100.0, 2)
+        parts = network.get_carriers()
+        if not network.is_nr_mode() or network.get_slot_duration_ms() != 0.5 or len(parts) != 2 or \
+           sum(part.num_rbs for part in parts) > 273 or \
+           any(part.numerology != 1 or not (3450.0 < part.frequency_mhz < 3550.0) for part in parts):
+            print(f"❌ NR carrier layout: {[(part.frequency_mhz, part.num_rbs) for part in parts]}")
+            return False
+        
+        ue_id = network.get_users()[0].ue_id
+        network.set_active_bandwidth_part(ue_id, 1)
+        for _ in range(40):
+            network.step_simulation()
+        
+        served = 0
+        for user in network.get_users():
+            rates = network.get_user_carrier_throughput(user.ue_id)
+            if rates[0] > 0.0 and rates[1] > 0.0:
+                print(f"❌ UE {user.ue_id} served on both bandwidth parts")
+                return False
+            served += rates[0] > 0.0
+        moved = network.get_user_carrier_throughput(ue_id)
+        if served == 0 or moved[0] != 0.0:
+            print(f"❌ {served} UEs on part 0, switched UE at {moved}")
+            return False
+        
+        network.configure_nr(3, 28000.0, 400.0, 1)
+        for _ in range(40):
+            network.step_simulation()
+        total = sum(user.current_throughput for user in network.get_users())
+        if network.get_slot_duration_ms() != 0.125 or network.get_carriers()[0].num_rbs != 264 or total <= 0.0:
+            print(f"❌ mu=3 slot {network.get_slot_duration_ms()} ms, {total:.1f} Mbps")
+            return False
+        
+        print(f"✅ {served} UEs on part 0, {total:.0f} Mbps at 120 kHz")
+        return True
+    except Exception as e:
+        print(f"❌ NR numerology test failed: {e}")
+        return False
+
+def test_queued_dispatch():
+    """Self-sending handlers stop at the depth limit, batches coalesce and history stays bounded."""
+    print("🔍 Testing queued cross-layer dispatch...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        optimizer = npe.CrossLayerOptimizer()
+        
+        # A handler that echoes every error-rate change would recurse forever
+        def echo(message):
+            if message.event == npe.CrossLayerEvent.ERROR_RATE_CHANGE:
+                optimizer.send_cross_layer_message(message)
+        optimizer.register_event_handler(echo)
+        
+        message = npe.CrossLayerMessage()
+        message.source = npe.LayerType.DATA_LINK
+        message.destination = npe.LayerType.TRANSPORT
+        message.event = npe.CrossLayerEvent.ERROR_RATE_CHANGE
+        message.parameters = {"error_rate": 0.2}
+        optimizer.send_cross_layer_message(message)
+        stats = optimizer.get_dispatch_statistics()
+        if stats["messages_dropped_depth"] == 0 or stats["pending_messages"] != 0 or \
+           stats["messages_dispatched"] > stats["max_dispatch_depth"] + 1:
+            print(f"❌ Echo handler: {stats}")
+            return False
+        
+        # Batched sends on one route collapse to the latest message
+        optimizer.reset()
+        optimizer.set_batched_dispatch(True)
+        message.source = npe.LayerType.NETWORK
+        message.event = npe.CrossLayerEvent.CONGESTION_DETECTED
+        for i in range(100):
+            message.parameters = {"congestion_level": i / 100.0}
+            optimizer.send_cross_layer_message(message)
+        if optimizer.get_pending_message_count() != 1:
+            print(f"❌ {optimizer.get_pending_message_count()} messages pending after coalescing")
+            return False
+        optimizer.dispatch_pending_messages()
+        history = optimizer.get_message_history()
+        if len(history) != 1 or history[0].parameters["congestion_level"] != 0.99:
+            print(f"❌ Dispatched {len(history)} messages")
+            return False
+        
+        # The history ring keeps only the newest messages
+        optimizer.set_batched_dispatch(False)
+        optimizer.set_message_history_capacity(5)
+        message.event = npe.CrossLayerEvent.LATENCY_CHANGE
+        for i in range(20):
+            message.timestamp = i
+            message.parameters = {"latency": float(i)}
+            optimizer.send_cross_layer_message(message)
+        history = optimizer.get_message_history()
+        if len(history) != 5 or history[-1].timestamp != 19:
+            print(f"❌ History holds {len(history)} messages, newest {history[-1].timestamp}")
+            return False
+        
+        print(f"✅ Echo stopped after {stats['messages_dispatched']:.0f} dispatches, "
+              f"100 sends coalesced to 1, history capped at 5")
+        return True
+    except Exception as e:
+        print(f"❌ Queued dispatch test failed: {e}")
+        return False
+
+def test_event_subscriptions():
+    """Messages reach only the subscribers of their route, and subscriptions can change mid-dispatch."""
+    print("🔍 Testing routed event subscriptions...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        optimizer = npe.CrossLayerOptimizer()
+        optimizer.enable_adaptive_optimization(False)
+        congestion = npe.CrossLayerEvent.CONGESTION_DETECTED
+        transport = npe.LayerType.TRANSPORT
+        
+        received = []
+        subscription = optimizer.subscribe(congestion, transport,
+                                           lambda message: received.append(message.parameters["congestion_level"]))
+        others = []
+        for _ in range(100):
+            optimizer.subscribe(npe.CrossLayerEvent.LATENCY_CHANGE, npe.LayerType.APPLICATION,
+                                lambda message: others.append(message))
+        
+        # A one-shot subscriber removes itself while being dispatched to
+        once = []
+        def one_shot(message):
+            once.append(message)
+            optimizer.unsubscribe(one_shot_id)
+        one_shot_id = optimizer.subscribe(congestion, transport, one_shot)
+        if optimizer.get_subscriber_count(congestion, transport) != 2:
+            print(f"❌ {optimizer.get_subscriber_count(congestion, transport)} subscribers on the route")
+            return False
+        
+        message = npe.CrossLayerMessage()
+        message.source = npe.LayerType.NETWORK
+        message.destination = transport
+        message.event = congestion
+        for level in (0.3, 0.6, 0.9):
+            message.parameters = {"congestion_level": level}
+            optimizer.send_cross_layer_message(message)
+        
+        if received != [0.3, 0.6, 0.9] or len(once) != 1 or others:
+            print(f"❌ Received {received}, one-shot {len(once)}, other route {len(others)}")
+            return False
+        if optimizer.get_subscriber_count(congestion, transport) != 1:
+            print("❌ One-shot subscription was not removed")
+            return False
+        
+        # Same event to another layer is a different route
+        message.destination = npe.LayerType.APPLICATION
+        optimizer.send_cross_layer_message(message)
+        optimizer.unsubscribe(subscription)
+        message.destination = transport
+        optimizer.send_cross_layer_message(message)
+        if len(received) != 3 or optimizer.get_subscriber_count(congestion, transport) != 0:
+            print(f"❌ After unsubscribe: {len(received)} messages received")
+            return False
+        
+        print("✅ Route filtering and mid-dispatch unsubscribe work")
+        return True
+    except Exception as e:
+        print(f"❌ Event subscription test failed: {e}")
+        return False
+
+def test_optimizer_simulation_state():
+    """Each optimizer owns its mobility, traffic and interference state, seeded per stream."""
+    print("🔍 Testing per-optimizer simulation state...")
+    
+    try:
+        import math
+        import network_protocols_enhanced as npe
+        
+        def interference_trace(seed, stream, steps=20):
+            optimizer = npe.CrossLayerOptimizer()
+            optimizer.set_simulation_seed(seed, stream)
+            trace = []
+            for _ in range(steps):
+                optimizer.simulate_interference()
+                trace.append(optimizer.get_layer_state(npe.LayerType.PHYSICAL).metrics["interference"])
+            return trace
+        
+        if interference_trace(7, 0) != interference_trace(7, 0):
+            print("❌ Same seed and stream gave different interference")
+            return False
+        if interference_trace(7, 0) == interference_trace(7, 1):
+            print("❌ Different streams gave the same interference")
+            return False
+        
+        # Stepping one optimizer leaves another at its own start
+        busy = npe.CrossLayerOptimizer()
+        fresh = npe.CrossLayerOptimizer()
+        for _ in range(10):
+            busy.simulate_mobility()
+            busy.simulate_traffic_variation()
+        fresh.simulate_mobility()
+        fresh.simulate_traffic_variation()
+        signal = fresh.get_layer_state(npe.LayerType.PHYSICAL).metrics["signal_strength"]
+        load = fresh.get_layer_state(npe.LayerType.NETWORK).metrics["traffic_load"]
+        if abs(signal - (-70.0 - 499.0 / 10.0)) > 1e-9 or abs(load - (0.5 + 0.4 * math.sin(0.1))) > 1e-9:
+            print(f"❌ Fresh optimizer starts at {signal:.2f} dBm, load {load:.3f}")
+            return False
+        
+        # Reseeding restarts the walk
+        busy.set_simulation_seed(3)
+        busy.simulate_mobility()
+        if busy.get_layer_state(npe.LayerType.PHYSICAL).metrics["signal_strength"] != signal:
+            print("❌ Reseeding did not restart mobility")
+            return False
+        
+        print("✅ Simulation state is per optimizer and reproducible per stream")
+        return True
+    except Exception as e:
+        print(f"❌ Optimizer simulation state test failed: {e}")
+        return False
+
+def test_policy_tuner():
+    """Grid search covers the grid, scores do not depend on threads, and the front is non-dominated."""
+    print("🔍 Testing parallel policy search...")
+    
+    try:
+        import itertools
+        import network_protocols_enhanced as npe
+        
+        grid = {"poor_signal_dbm": [-100.0, -90.0, -80.0], "high_congestion": [0.5, 0.7, 0.9]}
+        results = {}
+        for threads in (1, 4):
+            config = npe.PolicySearchConfig()
+            config.num_threads = threads
+            results[threads] = npe.PolicyTuner(config).grid_search(npe.PolicyCandidate(), grid)
+        scores = results[4]
+        
+        evaluated = sorted((score.candidate.thresholds.poor_signal_dbm, score.candidate.thresholds.high_congestion)
+                           for score in scores)
+        if evaluated != sorted(itertools.product(grid["poor_signal_dbm"], grid["high_congestion"])):
+            print(f"❌ Evaluated {evaluated}")
+            return False
+        if [(s.throughput_mbps, s.latency_ms, s.energy_mj) for s in results[1]] != \
+           [(s.throughput_mbps, s.latency_ms, s.energy_mj) for s in scores]:
+            print("❌ Scores depend on the thread count")
+            return False
+        
+        def dominates(b, a):
+            return (b.throughput_mbps >= a.throughput_mbps and b.latency_ms <= a.latency_ms and
+                    b.energy_mj <= a.energy_mj and
+                    (b.throughput_mbps > a.throughput_mbps or b.latency_ms < a.latency_ms or
+                     b.energy_mj < a.energy_mj))
+        for a in scores:
+            if a.pareto_optimal == any(dominates(b, a) for b in scores):
+                print(f"❌ Pareto flag wrong for {a.candidate.thresholds.poor_signal_dbm} dBm")
+                return False
+        front = npe.PolicyTuner.pareto_front(scores)
+        if len(front) != sum(score.pareto_optimal for score in scores):
+            print(f"❌ Front of {len(front)} from {sum(score.pareto_optimal for score in scores)} flagged")
+            return False
+        
+        tuner = npe.PolicyTuner()
+        if tuner.grid_search(npe.PolicyCandidate(), {"nope": [1.0]}) or "nope" not in tuner.get_last_error():
+            print(f"❌ Unknown parameter: '{tuner.get_last_error()}'")
+            return False
+        
+        optimizer = npe.CrossLayerOptimizer()
+        tuner.apply(front[0].candidate, optimizer)
+        if optimizer.get_thresholds().poor_signal_dbm != front[0].candidate.thresholds.poor_signal_dbm:
+            print("❌ apply did not set the thresholds")
+            return False
+        
+        print(f"✅ {len(scores)} candidates, {len(front)} on the Pareto front")
+        return True
+    except Exception as e:
+        print(f"❌ Policy tuner test failed: {e}")
+        return False
+
+def test_congestion_hot_swap():
+    """Switching algorithms keeps the window and histories; the same algorithm is a no-op."""
+    print("🔍 Testing congestion algorithm hot swap...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        tcp = npe.TCPTahoe(npe.CongestionAlgorithm.RENO)
+        for _ in range(6):
+            tcp.send_packet()
+        cwnd = tcp.get_current_cwnd()
+        ssthresh = tcp.get_current_ssthresh()
+        history = tcp.get_cwnd_history()
+        
+        tcp.set_algorithm(npe.CongestionAlgorithm.RENO)
+        if tcp.get_algorithm_switch_count() != 0:
+            print("❌ Same-algorithm switch was counted")
+            return False
+        
+        tcp.set_algorithm(npe.CongestionAlgorithm.BBR)
+        if tcp.get_current_cwnd() != cwnd or tcp.get_current_ssthresh() != ssthresh or \
+           tcp.get_cwnd_history() != history or tcp.get_algorithm_switch_count() != 1:
+            print(f"❌ After RENO -> BBR: cwnd {cwnd} -> {tcp.get_current_cwnd()}, "
+                  f"{len(tcp.get_cwnd_history())} history entries")
+            return False
+        
+        # Leaving BBR makes the window it found the slow start threshold
+        for _ in range(3):
+            tcp.send_packet()
+        tcp.set_algorithm(npe.CongestionAlgorithm.TAHOE)
+        if tcp.get_current_ssthresh() > max(tcp.get_current_cwnd(), 2) or tcp.get_current_cwnd() <= 1:
+            print(f"❌ After BBR -> TAHOE: cwnd {tcp.get_current_cwnd()}, ssthresh {tcp.get_current_ssthresh()}")
+            return False
+        
+        # A Reno fast-recovery window deflates for other controllers
+        tcp.set_algorithm(npe.CongestionAlgorithm.RENO)
+        for _ in range(3):
+            tcp.duplicate_ack()
+        if tcp.get_current_state() != "Fast Recovery":
+            print(f"❌ Reno in {tcp.get_current_state()} after three duplicate ACKs")
+            return False
+        tcp.set_algorithm(npe.CongestionAlgorithm.CUBIC)
+        if tcp.get_current_cwnd() != tcp.get_current_ssthresh() or \
+           tcp.get_current_state() != "Congestion Avoidance" or tcp.get_algorithm_switch_count() != 4:
+            print(f"❌ After RENO -> CUBIC: cwnd {tcp.get_current_cwnd()}, ssthresh {tcp.get_current_ssthresh()}, "
+                  f"{tcp.get_current_state()}")
+            return False
+        
+        print(f"✅ {tcp.get_algorithm_switch_count()} switches, window kept at {tcp.get_current_cwnd()}")
+        return True
+    except Exception as e:
+        print(f"❌ Congestion hot swap test failed: {e}")
+        return False
+
+def test_dispatch_instrumentation():
+    """Per-event histograms count every dispatch and measure simulated latency and queue depth."""
+    print("🔍 Testing cross-layer dispatch instrumentation...")
+    
+    try:
+        import network_protocols_enhanced as npe
+        
+        optimizer = npe.CrossLayerOptimizer()
+        optimizer.enable_adaptive_optimization(False)
+        optimizer.set_instrumentation_enabled(True)
+        
+        message = npe.CrossLayerMessage()
+        message.source = npe.LayerType.PHYSICAL
+        message.destination = npe.LayerType.TRANSPORT
+        message.event = npe.CrossLayerEvent.CONGESTION_DETECTED
+        message.parameters = {"congestion_level": 0.9}
+        for _ in range(100):
+            optimizer.send_cross_layer_message(message)
+        
+        # Queued messages wait two simulated milliseconds for their dispatch
+        optimizer.set_batched_dispatch(True)
+        message.event = npe.CrossLayerEvent.SIGNAL_STRENGTH_CHANGE
+        message.parameters = {"signal_strength": -100.0}
+        for _ in range(10):
+            optimizer.send_cross_layer_message(message)
+            optimizer.advance_simulation_clock(1.0)
+            optimizer.advance_simulation_clock(1.0)
+            optimizer.dispatch_pending_messages()
+        
+        # Five routes queued together reach a depth of five
+        message.event = npe.CrossLayerEvent.LATENCY_CHANGE
+        for source in (npe.LayerType.PHYSICAL, npe.LayerType.DATA_LINK, npe.LayerType.NETWORK,
+                       npe.LayerType.TRANSPORT, npe.LayerType.APPLICATION):
+            message.source = source
+            optimizer.send_cross_layer_message(message)
+        optimizer.dispatch_pending_messages()
+        
+        stats = optimizer.get_instrumentation_statistics()
+        if stats["congestion_detected.wall_latency_us.count"] != 100 or \
+           stats["congestion_detected.actions.count"] != 100 or stats["all.wall_latency_us.count"] != 115:
+            print(f"❌ Counted {stats['congestion_detected.wall_latency_us.count']:.0f} congestion, "
+                  f"{stats['all.wall_latency_us.count']:.0f} total dispatches")
+            return False
+        if stats["signal_strength_change.sim_latency_ms.mean"] != 2.0 or stats["simulation_clock_ms"] != 20.0:
+            print(f"❌ Simulated latency {stats['signal_strength_change.sim_latency_ms.mean']} ms")
+            return False
+        if stats["latency_change.queue_depth.max"] != 5:
+            print(f"❌ Peak queue depth {stats['latency_change.queue_depth.max']}")
+            return False
+        
+        # Disabled instrumentation records nothing; reset clears the histograms
+        optimizer.reset_instrumentation()
+        optimizer.set_instrumentation_enabled(False)
+        optimizer.set_batched_dispatch(False)
+        optimizer.send_cross_layer_message(message)
+        stats = optimizer.get_instrumentation_statistics()
+        if stats["all.wall_latency_us.count"] != 0 or "latency_change.actions.count" in stats or stats["enabled"] != 0.0:
+            print(f"❌ After reset and disable: {stats['all.wall_latency_us.count']:.0f} dispatches recorded")
+            return False
+        
+        print("✅ Dispatch counts, simulated latency and queue depth recorded per event")
+        return True
+    except Exception as e:
+        print(f"❌ Dispatch instrumentation test failed: {e}")
+        return False
+
+def main():
+    """Run all tests."""
+    print("🚀 Starting LTE extension tests\n")
+    
+    tests = [
+        ("Partitioned KPIs", test_partitioned_kpis),
+        ("PDCCH grant fairness", test_pdcch_grant_fairness),
+        ("Handover Signaling", test_handover_signaling_timeline),
+        ("Handover History Snapshot", test_handover_history_snapshot),
+        ("RLC Buffer Delay", test_rlc_buffer_delay),
+        ("Co-simulation Flows", test_cosimulation_flows),
+        ("Policy Engine", test_policy_engine),
+        ("Reported Cell Load", test_reported_cell_load),
+        ("State Views", test_state_views),
+        ("EESM/BLER Tables", test_link_abstraction_tables),
+        ("Message Bus", test_message_bus_drain),
+        ("Importer Carrier Mapping", test_importer_carrier_mapping),
+        ("Sector Antenna Pattern", test_sector_antenna_pattern),
+        ("RACH Contention", test_rach_contention),
+        ("Coverage Map", test_coverage_map),
+        ("Real-time Runner", test_realtime_runner),
+        ("Network Snapshots", test_network_snapshots),
+        ("Uplink Power Control", test_uplink_power_control),
+        ("NR Numerology", test_nr_numerology),
+        ("Queued Dispatch", test_queued_dispatch),
+        ("Event Subscriptions", test_event_subscriptions),
+        ("Optimizer Simulation State", test_optimizer_simulation_state),
+        ("Policy Tuner", test_policy_tuner),
+        ("Congestion Hot Swap", test_congestion_hot_swap),
+        ("Dispatch Instrumentation", test_dispatch_instrumentation)
+    ]
+    
+    passed = 0
+    total = len(tests)
+    
+    for test_name, test_func in tests:
+        print(f"📋 Running {test_name} test...")
+        if test_func():
+            passed += 1
+            print(f"✅ {test_name} test PASSED\n")
+        else:
+            print(f"❌ {test_name} test FAILED\n")
+    
+    print("=" * 50)
+    print(f"📊 Test Results: {passed}/{total} tests passed")
+    
+    if passed != total:
+        print("⚠️  Some tests failed. Please check the errors above.")
+        return 1
+    
+    print("🎉 All tests passed!")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())